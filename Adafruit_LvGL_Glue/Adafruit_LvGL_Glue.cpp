@@ -1,7 +1,17 @@
 #include <chrono>
+#include <new>
+#include <string.h>
 #include "Adafruit_LvGL_Glue.h"
 #include "lvgl.h"
 
+// Clock of the startup timeline
+#if defined(__MBED__)
+#include "hal/us_ticker_api.h"
+#define LVGL_MICROS() us_ticker_read()
+#else
+#define LVGL_MICROS() micros()
+#endif
+
 // ARCHITECTURE-SPECIFIC TIMER STUFF ---------------------------------------
 
 // Tick interval for LittlevGL internal timekeeping; 1 to 10 ms recommended
@@ -54,8 +64,13 @@ static bool touchscreen_read(struct _lv_indev_drv_t *indev_drv,
 
 // OTHER LITTLEVGL VITALS --------------------------------------------------
 
-#if LV_COLOR_DEPTH != 16
-#pragma error("LV_COLOR_DEPTH must be 16")
+#if (LV_COLOR_DEPTH != 8) && (LV_COLOR_DEPTH != 16) && (LV_COLOR_DEPTH != 32)
+#error "LV_COLOR_DEPTH must be 8, 16 or 32"
+#endif
+
+#if LV_COLOR_DEPTH == 8
+// RGB565 of each RGB332 lv_color_t, for writePixels8()
+static uint16_t lv_palette332[256];
 #endif
 // This isn't necessarily true, don't mention it for now. See notes later.
 //#if LV_COLOR_16_SWAP != 0
@@ -69,15 +84,58 @@ static bool touchscreen_read(struct _lv_indev_drv_t *indev_drv,
 #define LV_BUFFER_ROWS 8 // Most others have a bit more space
 #endif
 
+// Send LittlevGL pixels to the display's address window, in whatever
+// LV_COLOR_DEPTH they are
+static void lv_write_pixels(Adafruit_SPITFT *display, lv_color_t *color_p,
+                            uint32_t len, bool block) {
+#if LV_COLOR_DEPTH == 32
+  display->writePixels32((uint32_t *)color_p, len, block);
+#elif LV_COLOR_DEPTH == 8
+  display->writePixels8((uint8_t *)color_p, lv_palette332, len, block);
+#else
+  display->writePixels((uint16_t *)color_p, len, block, LV_COLOR_16_SWAP);
+#endif
+}
+
+// Set the display's pixel format for LV_COLOR_DEPTH, once it is initialized
+static void lv_pixel_format(Adafruit_SPITFT *display) {
+#if LV_COLOR_DEPTH == 32
+  // Keep the 18 bits the display can show, unless set up otherwise
+  if (display->getPixelFormat() == TFT_PIXEL_RGB565) {
+    display->setPixelFormat(TFT_PIXEL_RGB666);
+  }
+#else
+  (void)display;
+#endif
+}
+
 // This is the flush function required for LittlevGL screen updates.
 // It receives a bounding rect and an array of pixel data (conveniently
-// already in 565 format, so the Earth was lucky there).
+// already in 565 format with the default LV_COLOR_DEPTH 16, so the Earth
+// was lucky there; 8 and 32 bits are packed for the display on the way).
 static void lv_flush_callback(lv_disp_drv_t *disp, const lv_area_t *area,
                               lv_color_t *color_p) {
   // Get pointer to glue object from indev user data
   Adafruit_LvGL_Glue *glue = (Adafruit_LvGL_Glue *)disp->user_data;
   Adafruit_SPITFT *display = glue->display;
 
+  if (glue->display_held) {
+    // Display still initializing, keep the pixels for releaseDisplay()
+    if (glue->held_frame) {
+      uint16_t const width = area->x2 - area->x1 + 1;
+      for (int16_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&glue->held_frame[y * disp->hor_res + area->x1], color_p,
+               width * sizeof(lv_color_t));
+        color_p += width;
+      }
+    }
+    if (lv_disp_flush_is_last(disp) && !glue->timeline.rendered) {
+      glue->timeline.rendered = LVGL_MICROS();
+    }
+    lv_disp_flush_ready(disp);
+    return;
+  }
+
   if (!glue->first_frame) {
     display->dmaWait();  // Wait for prior DMA transfer to complete
     display->endWrite(); // End transaction from any prior call
@@ -87,14 +145,45 @@ static void lv_flush_callback(lv_disp_drv_t *disp, const lv_area_t *area,
 
   uint16_t width = (area->x2 - area->x1 + 1);
   uint16_t height = (area->y2 - area->y1 + 1);
+
+  if (glue->frame_pacing) {
+    // At most one frame per panel refresh, each band sent behind the
+    // panel's scan line
+    if (glue->frame_start) {
+      display->beginFrame(true);
+      glue->frame_start = false;
+    }
+    display->chaseScanLine(area->y1, area->y2, (uint32_t)width * height);
+  }
+
   display->startWrite();
   display->setAddrWindow(area->x1, area->y1, width, height);
-  display->writePixels((uint16_t *)color_p, width * height, false,
-                       LV_COLOR_16_SWAP);
+  lv_write_pixels(display, color_p, (uint32_t)width * height, false);
+
+  if (lv_disp_flush_is_last(disp)) {
+    if (glue->frame_pacing) {
+      display->endFrame();
+    }
+    glue->frame_start = true;
+    if (!glue->timeline.visible) {
+      glue->timeline.visible = LVGL_MICROS();
+      if (!glue->timeline.rendered) {
+        glue->timeline.rendered = glue->timeline.visible;
+      }
+    }
+  }
 
   lv_disp_flush_ready(disp);
 }
 
+// Refresh the invalidated areas the display's scan line has just passed
+// first, see Adafruit_SPITFT::scanOrder()
+static uint32_t lv_refr_order_callback(lv_disp_drv_t *disp,
+                                       const lv_area_t *area) {
+  Adafruit_LvGL_Glue *glue = (Adafruit_LvGL_Glue *)disp->user_data;
+  return glue->display->scanOrder(area->y1, area->y2);
+}
+
 #if (LV_USE_LOG)
 // Optional LittlevGL debug print function, writes to Serial if debug is
 // enabled when calling glue begin() function.
@@ -117,7 +206,8 @@ static void lv_debug(lv_log_level_t level, const char *file, uint32_t line,
  *
  */
 Adafruit_LvGL_Glue::Adafruit_LvGL_Glue(void)
-    : first_frame(true), lv_pixel_buf(NULL) {
+    : first_frame(true), frame_pacing(false), frame_start(true),
+      display_held(false), held_frame(NULL), timeline(), lv_pixel_buf(NULL) {
 #if defined(ARDUINO_ARCH_SAMD)
   zerotimer = NULL;
 #endif
@@ -131,6 +221,7 @@ Adafruit_LvGL_Glue::Adafruit_LvGL_Glue(void)
  */
 Adafruit_LvGL_Glue::~Adafruit_LvGL_Glue(void) {
   delete[] lv_pixel_buf;
+  delete[] held_frame;
 #if defined(ARDUINO_ARCH_SAMD)
   delete zerotimer;
 #endif
@@ -141,7 +232,8 @@ Adafruit_LvGL_Glue::~Adafruit_LvGL_Glue(void) {
  * @brief Configure the glue layer and the underlying LvGL code to use the given
  * TFT display driver and touchscreen controller instances
  *
- * @param tft Pointer to an **already initialized** display object instance
+ * @param tft Pointer to an **already initialized** display object instance,
+ * or one still initializing after holdDisplay()
  * @param debug Debug flag to enable debug messages. Only used if LV_USE_LOG is
  * configured in LittleLVGL's lv_conf.h
  * @return LvGLStatus The status of the initialization:
@@ -156,6 +248,7 @@ LvGLStatus Adafruit_LvGL_Glue::begin(Adafruit_SPITFT *tft, bool debug) {
 LvGLStatus Adafruit_LvGL_Glue::begin(Adafruit_SPITFT *tft, void *touch,
                                      bool debug) {
 
+  timeline.begin = LVGL_MICROS();
   lv_init();
 #if (LV_USE_LOG)
   if (debug) {
@@ -174,6 +267,17 @@ LvGLStatus Adafruit_LvGL_Glue::begin(Adafruit_SPITFT *tft, void *touch,
     display = tft;
     touchscreen = (void *)touch;
 
+    if (!display_held) {
+      lv_pixel_format(tft); // Else in releaseDisplay()
+    }
+#if LV_COLOR_DEPTH == 8
+    for (uint16_t i = 0; i < 256; i++) {
+      uint8_t r = i >> 5, g = (i >> 2) & 7, b = i & 3; // lv_color8_t
+      lv_palette332[i] = ((r << 2 | r >> 1) << 11) | ((g << 3 | g) << 5) |
+                         (b << 3 | b << 1 | b >> 1);
+    }
+#endif
+
     // Initialize LvGL display buffers. The "second half" buffer is only
     // used if USE_SPI_DMA is enabled in Adafruit_GFX.
     lv_disp_buf_init(&lv_disp_buf, lv_pixel_buf,
@@ -197,7 +301,16 @@ LvGLStatus Adafruit_LvGL_Glue::begin(Adafruit_SPITFT *tft, void *touch,
     lv_disp_drv.hor_res = tft->width();
     lv_disp_drv.ver_res = tft->height();
 #endif
+    if (display_held) {
+      // Whole screen copy, LvGL renders the first frame into it. Without
+      // the RAM releaseDisplay() redraws the screen instead.
+      held_frame = new (std::nothrow)
+          lv_color_t[(uint32_t)lv_disp_drv.hor_res * lv_disp_drv.ver_res]();
+    }
     lv_disp_drv.flush_cb = lv_flush_callback;
+    if (frame_pacing) {
+      lv_disp_drv.refr_order_cb = lv_refr_order_callback;
+    }
     lv_disp_drv.buffer = &lv_disp_buf;
     lv_disp_drv.user_data = (lv_disp_drv_user_data_t)this;
     lv_disp_drv_register(&lv_disp_drv);
@@ -274,9 +387,13 @@ LvGLStatus Adafruit_LvGL_Glue::begin(Adafruit_SPITFT *tft, void *touch,
 #endif // end timer setup --------------------------------------------------
   }
 
-  if (status != LVGL_OK) {
+  if (status == LVGL_OK) {
+    timeline.running = LVGL_MICROS();
+  } else {
     delete[] lv_pixel_buf;
     lv_pixel_buf = NULL;
+    delete[] held_frame;
+    held_frame = NULL;
 #if defined(ARDUINO_ARCH_SAMD)
     delete zerotimer;
     zerotimer = NULL;
@@ -285,3 +402,73 @@ LvGLStatus Adafruit_LvGL_Glue::begin(Adafruit_SPITFT *tft, void *touch,
 
   return status;
 }
+
+/**
+ * @brief Align LvGL's screen updates to the display's tearing effect (TE)
+ * signal: at most one frame per panel refresh, with the dirty areas and
+ * bands sent behind the panel's scan line. Needs TE pulses fed to
+ * Adafruit_SPITFT::tearingPulse() (with the display's TE output enabled),
+ * without them updates go out as usual. Frame timing is in
+ * Adafruit_SPITFT::getFrameStats().
+ *
+ * @param enable true to pace frames, false for LvGL's own timing
+ */
+void Adafruit_LvGL_Glue::setFramePacing(bool enable) {
+  frame_pacing = enable;
+  lv_disp_drv.refr_order_cb = enable ? lv_refr_order_callback : NULL;
+  // LvGL works on its own copy of the driver once registered
+  lv_disp_t *disp = NULL;
+  while ((disp = lv_disp_get_next(disp))) {
+    if (disp->driver.user_data == (lv_disp_drv_user_data_t)this) {
+      disp->driver.refr_order_cb = lv_disp_drv.refr_order_cb;
+    }
+  }
+}
+
+/**
+ * @brief Start LvGL before the display is initialized, e.g. while an
+ * Adafruit_ST77xx::initStart() initialization is stepped. Call before
+ * begin(). Until releaseDisplay(), nothing is sent to the display: screens
+ * can be built and the first frame rendered (lv_refr_now()) into a RAM copy
+ * of the screen, which takes width * height lv_color_t. The times of each
+ * step are in getTimeline().
+ */
+void Adafruit_LvGL_Glue::holdDisplay(void) {
+  display_held = true;
+  timeline = {};
+  timeline.hold = LVGL_MICROS();
+}
+
+/**
+ * @brief End holdDisplay() once the display is initialized: the frame kept
+ * in RAM goes to the display in one transfer, and LvGL flushes to the
+ * display from now on. If the frame couldn't be kept (not rendered yet, or
+ * no memory for the copy) the screen is redrawn by the next
+ * lv_task_handler() instead.
+ *
+ * @return true if the kept frame was sent, false if the screen is redrawn
+ */
+bool Adafruit_LvGL_Glue::releaseDisplay(void) {
+  if (!display_held) {
+    return false;
+  }
+  timeline.release = LVGL_MICROS();
+  display_held = false;
+  lv_pixel_format(display);
+
+  bool const kept = held_frame && timeline.rendered;
+  if (kept) {
+    display->startWrite();
+    display->setAddrWindow(0, 0, lv_disp_drv.hor_res, lv_disp_drv.ver_res);
+    lv_write_pixels(display, held_frame,
+                    (uint32_t)lv_disp_drv.hor_res * lv_disp_drv.ver_res, true);
+    display->endWrite();
+    timeline.visible = LVGL_MICROS();
+  } else {
+    timeline.rendered = 0; // Not sent, the redraw is the first frame
+    lv_obj_invalidate(lv_scr_act());
+  }
+  delete[] held_frame;
+  held_frame = NULL;
+  return kept;
+}
@@ -16,6 +16,20 @@ typedef enum {
   LVGL_ERR_TIMER,
 } LvGLStatus;
 
+/**
+ * @brief Startup timeline of the glue, in microseconds of the display
+ * library's clock (us_ticker_read() on mbed, micros() elsewhere). 0 for the
+ * steps that didn't happen.
+ */
+typedef struct {
+  uint32_t hold;     ///< holdDisplay(): display not initialized yet
+  uint32_t begin;    ///< begin() called
+  uint32_t running;  ///< begin() done: LvGL, buffers, drivers and tick set up
+  uint32_t rendered; ///< First frame rendered, into RAM if held
+  uint32_t release;  ///< releaseDisplay(): display initialized
+  uint32_t visible;  ///< First frame sent to the display
+} LvGLTimeline;
+
 /**
  * @brief Class to act as a "glue" layer between the LvGL graphics library and
  * most of Adafruit's TFT displays
@@ -26,6 +40,15 @@ public:
   Adafruit_LvGL_Glue(void);
   ~Adafruit_LvGL_Glue(void);
   LvGLStatus begin(Adafruit_SPITFT *tft, bool debug = false);
+  void setFramePacing(bool enable);
+  void holdDisplay(void);
+  bool releaseDisplay(void);
+  /**
+   * @brief Startup timeline, see holdDisplay()
+   *
+   * @return Reference to the timeline
+   */
+  const LvGLTimeline &getTimeline(void) const { return timeline; }
   // These items need to be public for some internal callbacks,
   // but should be avoided by user code please!
   Adafruit_SPITFT *display; ///< Pointer to the SPITFT display instance
@@ -33,6 +56,11 @@ public:
   bool is_adc_touch; ///< determines if the touchscreen controlelr is ADC based
   bool first_frame;  ///< Tracks if a call to `lv_flush_callback` needs to wait
                      ///< for DMA transfer to complete
+  bool frame_pacing; ///< Flushes follow the display's TE pulses
+  bool frame_start;  ///< Next call to `lv_flush_callback` starts a frame
+  bool display_held; ///< Display not ready, frames go to `held_frame`
+  lv_color_t *held_frame; ///< RAM copy of the screen while held
+  LvGLTimeline timeline;  ///< Startup timeline
 
 private:
   LvGLStatus begin(Adafruit_SPITFT *tft, void *touch, bool debug);
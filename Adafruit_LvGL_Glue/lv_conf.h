@@ -251,7 +251,21 @@ typedef void * lv_fs_drv_user_data_t;
  * With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
  * However the opened images might consume additional RAM.
  * Set it to 0 to disable caching */
-#define LV_IMG_CACHE_DEF_SIZE       1
+#define LV_IMG_CACHE_DEF_SIZE       8
+
+/* Memory budget of the image cache in bytes.
+ * The least recently used images are closed to keep the estimated memory of the opened images below it.
+ * Set it to 0 to limit the cache only by LV_IMG_CACHE_DEF_SIZE */
+#define LV_IMG_CACHE_DEF_BUDGET     (8U * 1024U)
+
+/* Read-ahead cache of the built-in decoder for images opened from files (in bytes).
+ * Files are read in LV_IMG_FS_BLOCK_SIZE aligned chunks of this size instead of
+ * seeking and reading for every line. Enlarged to hold at least one line of the image.
+ * Set it to 0 to read the files line by line */
+#define LV_IMG_FS_CACHE_SIZE        2048
+
+/* Alignment of the reads of the file cache. Use the block size of the file system (> 0)*/
+#define LV_IMG_FS_BLOCK_SIZE        512
 
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
@@ -440,6 +454,27 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  */
 #define LV_USE_FONT_COMPRESSED 1
 
+/* Size of the glyph bitmap cache in bytes (0: disable).
+ * The decompressed glyphs of `lv_font_fmt_txt` fonts are stored with 8 bit per pixel
+ * and the least recently used glyphs are dropped when the cache is full.
+ * Saves the decompression and bit unpacking of the glyphs drawn frequently.*/
+#define LV_FONT_GLYPH_CACHE_SIZE    (4U * 1024U)
+
+/* Number of entries in the codepoint -> glyph id cache of `lv_font_fmt_txt` fonts.
+ * Has to be a power of 2 (0: disable, only the last letter is cached).*/
+#define LV_FONT_FMT_TXT_GID_CACHE_SIZE  16
+
+/* 1: Build a two-level lookup table lazily for the Basic Multilingual Plane (U+0000..U+FFFF)
+ * to find the glyph id of a codepoint without searching the cmaps.
+ * Requires (4 * 256) bytes per used font + (2 * 256) bytes per used 256 codepoint page.*/
+#define LV_FONT_FMT_TXT_CMAP_PAGES      0
+
+/* 1: Build a hash table lazily from the kerning pairs of `lv_font_fmt_txt` fonts
+ * to find a pair's kerning value without binary search.
+ * Requires about (5 * 4 / 3 * pair count) bytes per font with kerning pairs.
+ * Fonts with class based kerning are not affected.*/
+#define LV_FONT_FMT_TXT_KERN_HASH       1
+
 /* Enable subpixel rendering */
 #define LV_USE_FONT_SUBPX 1
 #if LV_USE_FONT_SUBPX
@@ -656,6 +691,10 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Cache the start and width of the lines of labels with texts longer than this (in bytes).
+ * Speeds up drawing and cursor positioning in long texts. 0: disable*/
+#  define LV_LABEL_LINE_CACHE             256
 #endif
 
 /*LED (dependencies: -)*/
@@ -714,7 +753,8 @@ typedef void * lv_obj_user_data_t;
 /*Focus animation time [ms] (0: no animation)*/
 #  define LV_ROLLER_DEF_ANIM_TIME     200
 
-/*Number of extra "pages" when the roller is infinite*/
+/*Number of "pages" an infinite roller can be scrolled over before it wraps around.
+ * The options are stored and laid out only once.*/
 #  define LV_ROLLER_INF_PAGES         7
 #endif
 
@@ -196,7 +196,12 @@ static const uint8_t PROGMEM
     ST77XX_NORON,     ST_CMD_DELAY, //  3: Normal display on, no args, w/delay
       10,                           //     10 ms delay
     ST77XX_DISPON,    ST_CMD_DELAY, //  4: Main screen turn on, no args w/delay
-      100 };                        //     100 ms delay
+      100 },                        //     100 ms delay
+
+  Rcmd4black[] = {                  // 7735R init, part 4 (black tab, mini)
+    1,                              //  1 command in list:
+    ST77XX_MADCTL,  1,              //  1: Mem access ctl, 1 arg:
+      0xC0 };                       //     color filter
 
 // clang-format on
 
@@ -206,8 +211,20 @@ static const uint8_t PROGMEM
 */
 /**************************************************************************/
 void Adafruit_ST7735::initB(void) {
-  commonInit(Bcmd);
-  setRotation(0);
+  initBStart();
+  initWait();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start the same initialization as initB() without blocking, see
+            Adafruit_ST77xx::initStep()
+*/
+/**************************************************************************/
+void Adafruit_ST7735::initBStart(void) {
+  initBegin();
+  initAdd(Bcmd);
+  _scrollLines = 162;
 }
 
 /**************************************************************************/
@@ -217,42 +234,57 @@ void Adafruit_ST7735::initB(void) {
 */
 /**************************************************************************/
 void Adafruit_ST7735::initR(uint8_t options) {
-  commonInit(Rcmd1);
+  initRStart(options);
+  initWait();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start the same initialization as initR() without blocking, see
+            Adafruit_ST77xx::initStep()
+    @param  options  Tab color from adafruit purchase
+*/
+/**************************************************************************/
+void Adafruit_ST7735::initRStart(uint8_t options) {
+  initBegin();
+  initAdd(Rcmd1);
   if (options == INITR_GREENTAB) {
-    displayInit(Rcmd2green);
+    initAdd(Rcmd2green);
     _colstart = 2;
     _rowstart = 1;
   } else if ((options == INITR_144GREENTAB) || (options == INITR_HALLOWING)) {
     _height = ST7735_TFTHEIGHT_128;
     _width = ST7735_TFTWIDTH_128;
-    displayInit(Rcmd2green144);
+    initAdd(Rcmd2green144);
     _colstart = 2;
     _rowstart = 3; // For default rotation 0
   } else if (options == INITR_MINI160x80) {
     _height = ST7735_TFTWIDTH_80;
     _width = ST7735_TFTHEIGHT_160;
-    displayInit(Rcmd2green160x80);
+    initAdd(Rcmd2green160x80);
     _colstart = 24;
     _rowstart = 0;
   } else {
     // colstart, rowstart left at default '0' values
-    displayInit(Rcmd2red);
+    initAdd(Rcmd2red);
   }
-  displayInit(Rcmd3);
+  initAdd(Rcmd3);
+  // 132x162 frame memory, 128x160 on the black tab and mini modules
+  _scrollLines =
+      ((options == INITR_BLACKTAB) || (options == INITR_MINI160x80)) ? 160
+                                                                     : 162;
 
   // Black tab, change MADCTL color filter
   if ((options == INITR_BLACKTAB) || (options == INITR_MINI160x80)) {
-    uint8_t data = 0xC0;
-    sendCommand(ST77XX_MADCTL, &data, 1);
+    initAdd(Rcmd4black);
   }
 
   if (options == INITR_HALLOWING) {
     // Hallowing is simply a 1.44" green tab upside-down:
     tabcolor = INITR_144GREENTAB;
-    setRotation(2);
+    _initRotation = 2;
   } else {
     tabcolor = options;
-    setRotation(0);
   }
 }
 
@@ -359,4 +391,5 @@ void Adafruit_ST7735::setRotation(uint8_t m) {
   }
 
   sendCommand(ST77XX_MADCTL, &madctl, 1);
+  setScrollMADCTL(madctl);
 }
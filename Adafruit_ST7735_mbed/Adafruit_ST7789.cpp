@@ -89,7 +89,23 @@ static const uint8_t PROGMEM
 */
 /**************************************************************************/
 void Adafruit_ST7789::init(uint16_t width, uint16_t height, uint8_t mode) {
-  // Save SPI data mode. commonInit() calls begin() (in Adafruit_ST77xx.cpp),
+  initStart(width, height, mode);
+  initWait();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start the same initialization as init() without blocking: it
+            returns after setting up SPI, the reset and sleep out delays
+            are stepped with initStep() (or awaited with initWait()).
+    @param  width  Display width
+    @param  height Display height
+    @param  mode   SPI data mode, see init()
+*/
+/**************************************************************************/
+void Adafruit_ST7789::initStart(uint16_t width, uint16_t height,
+                                uint8_t mode) {
+  // Save SPI data mode. initBegin() calls begin() (in Adafruit_ST77xx.cpp),
   // which in turn calls initSPI() (in Adafruit_SPITFT.cpp), passing it the
   // value of spiMode. It's done this way because begin() really should not
   // be modified at this point to accept an SPI mode -- it's a virtual
@@ -101,7 +117,7 @@ void Adafruit_ST7789::init(uint16_t width, uint16_t height, uint8_t mode) {
   // (Might get added similarly to other display types as needed on a
   // case-by-case basis.)
 
-  commonInit(NULL);
+  initBegin();
 
   if (width < 240) {
     // 1.14" display
@@ -122,9 +138,11 @@ void Adafruit_ST7789::init(uint16_t width, uint16_t height, uint8_t mode) {
 
   windowWidth = width;
   windowHeight = height;
+  _width = width; // What setRotation(0) sets once done, for width() and
+  _height = height; // height() during the initialization
+  _scrollLines = 320;
 
-  displayInit(generic_st7789);
-  setRotation(0);
+  initAdd(generic_st7789); // Then setRotation(0)
 }
 
 /**************************************************************************/
@@ -141,6 +159,11 @@ void Adafruit_ST7789::setRotation(uint8_t m) {
   switch (rotation) {
   case 0:
     madctl = ST77XX_MADCTL_MX | ST77XX_MADCTL_MY | ST77XX_MADCTL_RGB;
+    // For TE pacing refresh bottom to top (ML) like MY flips the rows, so
+    // the panel scan runs down the rows as in rotation 2 (same image)
+    if (_tearing) {
+      madctl |= ST77XX_MADCTL_ML;
+    }
     _xstart = _colstart;
     _ystart = _rowstart;
     _width = windowWidth;
@@ -170,4 +193,9 @@ void Adafruit_ST7789::setRotation(uint8_t m) {
   }
 
   sendCommand(ST77XX_MADCTL, &madctl, 1);
+  setScrollMADCTL(madctl);
+
+  // The controller scans all 320 lines, in landscape they are columns and
+  // with only one of MY or ML they run up the rows
+  setScanMapping(320, ((rotation & 1) || _scrollFlip) ? -1 : _ystart);
 }
@@ -15,6 +15,8 @@ public:
 
   void setRotation(uint8_t m);
   void init(uint16_t width, uint16_t height, uint8_t spiMode = SPI_MODE0);
+  void initStart(uint16_t width, uint16_t height,
+                 uint8_t spiMode = SPI_MODE0);
 
 protected:
   uint8_t _colstart2 = 0, ///< Offset from the right
@@ -41,6 +41,20 @@
 
 #define SPI_DEFAULT_FREQ 32000000 ///< Default SPI data clock frequency
 
+// Clock of the initStep() delays
+#if defined(__MBED__)
+#include "hal/us_ticker_api.h"
+#define ST77XX_MICROS() us_ticker_read() ///< Microseconds, wrapping
+#else
+#define ST77XX_MICROS() micros() ///< Microseconds, wrapping
+#endif
+
+// initStep() phases
+#define ST77XX_INIT_IDLE 0       ///< Nothing to do
+#define ST77XX_INIT_RESET_LOW 1  ///< Reset pin high, pull it low next
+#define ST77XX_INIT_RESET_HIGH 2 ///< Reset pin low, release it next
+#define ST77XX_INIT_COMMANDS 3   ///< Sending the command lists
+
 /**************************************************************************/
 /*!
     @brief  Instantiate Adafruit ST77XX driver with software SPI
@@ -120,6 +134,148 @@ void Adafruit_ST77xx::displayInit(const uint8_t *addr) {
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Start a non-blocking initialization: set up SPI, then step the
+            hardware reset (if there is a reset pin) and the command lists
+            given to initAdd() with initStep(). Called by the subclass'
+            initStart() functions, which then add their command lists.
+*/
+/**************************************************************************/
+void Adafruit_ST77xx::initBegin(void) {
+  _initStart = ST77XX_MICROS();
+  _initTime = 0;
+  // As begin(), but the reset is stepped below
+  invertOnCommand = ST77XX_INVON;
+  invertOffCommand = ST77XX_INVOFF;
+  initSPI(SPI_DEFAULT_FREQ, spiMode, false);
+
+  _initListCount = _initList = _initCommands = 0;
+  _initRotation = 0;
+  pixelFormat = TFT_PIXEL_RGB565; // What the command lists set (COLMOD)
+  wireCarry = false;              // A held back RGB444 pixel is lost
+  _initDue = ST77XX_MICROS();
+  if (_rst >= 0) {
+    pinMode(_rst, OUTPUT);
+    digitalWrite(_rst, HIGH);
+    _initDue += 100000; // 100 ms, as initSPI() would
+    _initState = ST77XX_INIT_RESET_LOW;
+  } else {
+    _initState = ST77XX_INIT_COMMANDS;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add a command list to the initialization started by
+            initBegin(), sent in the order added.
+    @param  cmdList  Flash memory array with commands and data to send,
+                     same format as displayInit(). Up to 4 lists.
+*/
+/**************************************************************************/
+void Adafruit_ST77xx::initAdd(const uint8_t *cmdList) {
+  if (cmdList && (_initListCount < 4)) {
+    _initLists[_initListCount++] = cmdList;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Advance a non-blocking initialization (e.g.
+            Adafruit_ST7789::initStart()). Does what is due: the reset
+            pin, or the commands up to the next one with a delay. Call it
+            again after initDelay() milliseconds, from a loop or an event
+            queue, while the rest of the system starts up. Don't draw until
+            it returns true.
+    @return true once the display is initialized (rotation set, display
+            on), false if there is more to do.
+*/
+/**************************************************************************/
+bool Adafruit_ST77xx::initStep(void) {
+  if (_initState == ST77XX_INIT_IDLE)
+    return true;
+  if ((int32_t)(ST77XX_MICROS() - _initDue) < 0)
+    return false; // Still waiting
+
+  switch (_initState) {
+  case ST77XX_INIT_RESET_LOW:
+    digitalWrite(_rst, LOW);
+    _initDue = ST77XX_MICROS() + 100000;
+    _initState = ST77XX_INIT_RESET_HIGH;
+    return false;
+  case ST77XX_INIT_RESET_HIGH:
+    digitalWrite(_rst, HIGH);
+    _initDue = ST77XX_MICROS() + 100000;
+    _initState = ST77XX_INIT_COMMANDS;
+    return false;
+  }
+
+  for (;;) {
+    if (!_initCommands) { // Next list
+      if (_initList == _initListCount)
+        break;
+      _initAddr = _initLists[_initList++];
+      _initCommands = pgm_read_byte(_initAddr++);
+      continue;
+    }
+    _initCommands--;
+    uint8_t const cmd = pgm_read_byte(_initAddr++);
+    uint8_t numArgs = pgm_read_byte(_initAddr++);
+    bool const wait = numArgs & ST_CMD_DELAY; // Delay follows args
+    numArgs &= ~ST_CMD_DELAY;
+    sendCommand(cmd, _initAddr, numArgs);
+    _initAddr += numArgs;
+    if (wait) {
+      uint16_t ms = pgm_read_byte(_initAddr++);
+      if (ms == 255)
+        ms = 500; // If 255, delay for 500 ms
+      _initDue = ST77XX_MICROS() + ms * 1000;
+      return false;
+    }
+  }
+
+  setRotation(_initRotation);
+  _initState = ST77XX_INIT_IDLE;
+  _initTime = ST77XX_MICROS() - _initStart;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Time until initStep() has something to do.
+    @return Milliseconds, rounded up. 0 if a step is due now or there is no
+            initialization in progress.
+*/
+/**************************************************************************/
+uint32_t Adafruit_ST77xx::initDelay(void) const {
+  if (_initState == ST77XX_INIT_IDLE)
+    return 0;
+  int32_t const left = _initDue - ST77XX_MICROS();
+  return (left > 0) ? (left + 999) / 1000 : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Whether a non-blocking initialization is still in progress.
+    @return true if not (done, or never started), false if it is.
+*/
+/**************************************************************************/
+bool Adafruit_ST77xx::initDone(void) const {
+  return _initState == ST77XX_INIT_IDLE;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Finish a non-blocking initialization, sleeping out its delays.
+            This is what the blocking init functions do after initStart().
+*/
+/**************************************************************************/
+void Adafruit_ST77xx::initWait(void) {
+  while (!initStep()) {
+    ThisThread::sleep_for(std::chrono::milliseconds(initDelay()));
+  }
+}
+
 /**************************************************************************/
 /*!
     @brief  Initialize ST77xx chip. Connects to the ST77XX over SPI and
@@ -165,16 +321,10 @@ void Adafruit_ST77xx::setAddrWindow(uint16_t x, uint16_t y, uint16_t w,
                                     uint16_t h) {
   x += _xstart;
   y += _ystart;
-  uint32_t xa = ((uint32_t)x << 16) | (x + w - 1);
-  uint32_t ya = ((uint32_t)y << 16) | (y + h - 1);
 
-  writeCommand(ST77XX_CASET); // Column addr set
-  SPI_WRITE32(xa);
-
-  writeCommand(ST77XX_RASET); // Row addr set
-  SPI_WRITE32(ya);
-
-  writeCommand(ST77XX_RAMWR); // write to RAM
+  // CASET, RASET and RAMWR, skipping what the display already has
+  writeAddrWindow(ST77XX_CASET, ST77XX_RASET, ST77XX_RAMWR, x, y, x + w - 1,
+                  y + h - 1);
 }
 
 /**************************************************************************/
@@ -212,6 +362,7 @@ void Adafruit_ST77xx::setRotation(uint8_t m) {
   }
 
   sendCommand(ST77XX_MADCTL, &madctl, 1);
+  setScrollMADCTL(madctl);
 }
 
 /**************************************************************************/
@@ -238,12 +389,18 @@ void Adafruit_ST77xx::enableDisplay(bool enable) {
 
 /**************************************************************************/
 /*!
- @brief  Change whether TE pin output is on or off
+ @brief  Change whether TE pin output is on or off. The rotation is set
+         again, a subclass may pick another refresh direction for frame
+         pacing (hardware scrolling is turned off then).
  @param  enable True if you want the TE pin ON, false OFF
  */
 /**************************************************************************/
 void Adafruit_ST77xx::enableTearing(bool enable) {
   sendCommand(enable ? ST77XX_TEON : ST77XX_TEOFF);
+  if (enable != _tearing) {
+    _tearing = enable;
+    setRotation(rotation);
+  }
 }
 
 /**************************************************************************/
@@ -256,6 +413,172 @@ void Adafruit_ST77xx::enableSleep(bool enable) {
   sendCommand(enable ? ST77XX_SLPIN : ST77XX_SLPOUT);
 }
 
+/**************************************************************************/
+/*!
+ @brief  Change whether idle mode (8 colors, less power) is on or off
+ @param  enable True if you want idle mode ON, false OFF
+ */
+/**************************************************************************/
+void Adafruit_ST77xx::enableIdle(bool enable) {
+  sendCommand(enable ? ST77XX_IDMON : ST77XX_IDMOFF);
+}
+
+/**************************************************************************/
+/*!
+ @brief  Set the pixel format of the memory writes (COLMOD), see
+         Adafruit_SPITFT::setPixelFormat(). Call after init(), which sets
+         the display to RGB565.
+ @param  format TFT_PIXEL_RGB565, TFT_PIXEL_RGB444 or TFT_PIXEL_RGB666
+ @return true if the format is set, false if not supported here
+ */
+/**************************************************************************/
+bool Adafruit_ST77xx::setPixelFormat(uint8_t format) {
+  static const uint8_t colmod[] = {0x55, 0x53, 0x66}; // 16, 12, 18 bits
+  if (!Adafruit_SPITFT::setPixelFormat(format))
+    return false;
+  sendCommand(ST77XX_COLMOD, &colmod[format], 1);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Line of the frame memory, as counted by the scroll and partial
+            area commands, that shows a row (portrait rotations)
+    @param  y  Row
+    @return Line
+*/
+/**************************************************************************/
+uint16_t Adafruit_ST77xx::scrollLine(uint16_t y) const {
+  // The commands count from the bottom when MADCTL ML is set, so MY flips
+  // the rows against them only without ML
+  return _scrollFlip ? _scrollLines - 1 - (_ystart + y) : _ystart + y;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Note how a new MADCTL maps the rows to the scroll lines, called
+            by setRotation(). Stops scrolling, the scroll area has to be set
+            again.
+    @param  madctl  MADCTL sent to the display
+*/
+/**************************************************************************/
+void Adafruit_ST77xx::setScrollMADCTL(uint8_t madctl) {
+  if (_scrollHeight) {
+    uint8_t data[6] = {0, 0, (uint8_t)(_scrollLines >> 8),
+                       (uint8_t)_scrollLines, 0, 0};
+    sendCommand(ST77XX_VSCRDEF, data, 6);
+    sendCommand(ST77XX_VSCSAD, data, 2);
+  }
+  _scrollFlip = !(madctl & ST77XX_MADCTL_MY) != !(madctl & ST77XX_MADCTL_ML);
+  _scrollHeight = 0;
+  scroll_y = scroll_h = scroll_pos = 0; // setScrollArea() too
+}
+
+/**************************************************************************/
+/*!
+ @brief  Set the rows that stay in place while the rest scroll (VSCRDEF).
+         Portrait rotations only, the controller scrolls along its lines.
+ @param  top     Rows fixed at the top
+ @param  bottom  Rows fixed at the bottom
+ */
+/**************************************************************************/
+void Adafruit_ST77xx::setScrollMargins(uint16_t top, uint16_t bottom) {
+  if (!_scrollLines || (rotation & 1) || ((top + bottom) >= _height)) {
+    return;
+  }
+  _scrollTop = top;
+  _scrollHeight = _height - top - bottom;
+
+  // Lines off the glass and outside the area go to the fixed areas
+  uint16_t first = scrollLine(_scrollFlip ? _height - 1 - bottom : top);
+  uint16_t after = _scrollLines - first - _scrollHeight;
+  uint8_t data[6] = {(uint8_t)(first >> 8),         (uint8_t)first,
+                     (uint8_t)(_scrollHeight >> 8), (uint8_t)_scrollHeight,
+                     (uint8_t)(after >> 8),         (uint8_t)after};
+  sendCommand(ST77XX_VSCRDEF, data, 6);
+}
+
+/**************************************************************************/
+/*!
+ @brief  Scroll the area set with setScrollMargins() (VSCSAD). The rows of
+         the area are drawn to as usual, the screen shows them moved up.
+ @param  offset  Rows to move up: the row at the top of the area shows
+                 what was drawn offset rows below it, wrapping around
+ */
+/**************************************************************************/
+void Adafruit_ST77xx::scrollTo(uint16_t offset) {
+  if (!_scrollHeight) {
+    return;
+  }
+  offset %= _scrollHeight;
+  if (_scrollFlip && offset) {
+    offset = _scrollHeight - offset; // The lines run up the screen
+  }
+  uint16_t line =
+      scrollLine(_scrollFlip ? _scrollTop + _scrollHeight - 1 : _scrollTop) +
+      offset;
+  uint8_t data[2] = {(uint8_t)(line >> 8), (uint8_t)line};
+  sendCommand(ST77XX_VSCSAD, data, 2);
+}
+
+/**************************************************************************/
+/*!
+    @brief      Hardware scrolling for Adafruit_GFX::scroll()
+    @param      y       First row of the band
+    @param      h       Rows in the band, 0 to stop scrolling
+    @param      offset  Rows the band is moved up, 0 to h - 1
+    @returns    true if the display scrolled, false in landscape rotations
+                or without scrolling support
+*/
+/**************************************************************************/
+bool Adafruit_ST77xx::setVerticalScroll(int16_t y, int16_t h, int16_t offset) {
+  if (!_scrollLines || (rotation & 1) || (y < 0) || (h < 0) ||
+      ((y + h) > _height)) {
+    return false;
+  }
+  if (!h) { // Whole screen, not moved
+    y = offset = 0;
+    h = _height;
+  }
+  if ((y != _scrollTop) || (h != _scrollHeight)) {
+    setScrollMargins(y, _height - y - h);
+  }
+  scrollTo(offset);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+ @brief  Set the rows shown in partial mode (PTLAR), the rest of the panel
+         is not refreshed. Portrait rotations only.
+ @param  top     First row shown
+ @param  bottom  Last row shown
+ */
+/**************************************************************************/
+void Adafruit_ST77xx::setPartialArea(uint16_t top, uint16_t bottom) {
+  if (!_scrollLines || (rotation & 1) || (top > bottom) ||
+      (bottom >= _height)) {
+    return;
+  }
+  uint16_t start = scrollLine(_scrollFlip ? bottom : top);
+  uint16_t end = scrollLine(_scrollFlip ? top : bottom);
+  uint8_t data[4] = {(uint8_t)(start >> 8), (uint8_t)start,
+                     (uint8_t)(end >> 8), (uint8_t)end};
+  sendCommand(ST77XX_PTLAR, data, 4);
+}
+
+/**************************************************************************/
+/*!
+ @brief  Change whether partial mode (see setPartialArea()) is on or off.
+         Turning it off (NORON) also ends scrolling, until the next
+         scrollTo().
+ @param  enable True if you want partial mode ON, false OFF
+ */
+/**************************************************************************/
+void Adafruit_ST77xx::enablePartial(bool enable) {
+  sendCommand(enable ? ST77XX_PTLON : ST77XX_NORON);
+}
+
 ////////// stuff not actively being used, but kept for posterity
 /*
 
@@ -61,9 +61,13 @@
 #define ST77XX_RAMRD 0x2E
 
 #define ST77XX_PTLAR 0x30
+#define ST77XX_VSCRDEF 0x33
 #define ST77XX_TEOFF 0x34
 #define ST77XX_TEON 0x35
 #define ST77XX_MADCTL 0x36
+#define ST77XX_VSCSAD 0x37
+#define ST77XX_IDMOFF 0x38
+#define ST77XX_IDMON 0x39
 #define ST77XX_COLMOD 0x3A
 
 #define ST77XX_MADCTL_MY 0x80
@@ -105,15 +109,58 @@ public:
   void enableDisplay(bool enable);
   void enableTearing(bool enable);
   void enableSleep(bool enable);
+  void enableIdle(bool enable);
+  bool setPixelFormat(uint8_t format);
+
+  // Hardware scrolling and partial mode, in rows of portrait rotations
+  void setScrollMargins(uint16_t top, uint16_t bottom);
+  void scrollTo(uint16_t offset);
+  bool setVerticalScroll(int16_t y, int16_t h, int16_t offset);
+  void setPartialArea(uint16_t top, uint16_t bottom);
+  void enablePartial(bool enable);
+
+  // Initialization without blocking: a subclass' initStart() function
+  // starts it, initStep() sends the commands whose delay has passed
+  bool initStep(void);
+  uint32_t initDelay(void) const;
+  bool initDone(void) const;
+  void initWait(void);
+  /*!
+      @brief   Time the last initialization took, from its initStart() to
+               the last command (display on).
+      @return  Microseconds, 0 while still in progress.
+  */
+  uint32_t initTime(void) const { return _initTime; }
 
 protected:
   uint8_t _colstart = 0,   ///< Some displays need this changed to offset
       _rowstart = 0,       ///< Some displays need this changed to offset
       spiMode = SPI_MODE0; ///< Certain display needs MODE3 instead
+  uint16_t _scrollLines = 0;  ///< Lines of the frame memory, 0: no scrolling
+  bool _scrollFlip = false;   ///< Rows run against the scroll lines (MY, ML)
+  uint16_t _scrollTop = 0;    ///< First row of the scroll area
+  uint16_t _scrollHeight = 0; ///< Rows of the scroll area, 0 if not set
+  bool _tearing = false;      ///< TE output is on, see enableTearing()
+
+  const uint8_t *_initLists[4] = {}; ///< Command lists of initStep()
+  uint8_t _initListCount = 0;        ///< Lists in _initLists
+  uint8_t _initList = 0;             ///< Next list to start
+  uint8_t _initCommands = 0;         ///< Commands left in the current list
+  const uint8_t *_initAddr = NULL;   ///< Next command of the current list
+  uint8_t _initState = 0;            ///< Reset or command phase, 0: idle
+  uint8_t _initRotation = 0;         ///< setRotation() once done
+  uint32_t _initDue = 0;             ///< Microseconds the next step is due
+  uint32_t _initStart = 0;           ///< Microseconds initBegin() ran
+  uint32_t _initTime = 0;            ///< Microseconds the last init took
+
+  uint16_t scrollLine(uint16_t y) const;
+  void setScrollMADCTL(uint8_t madctl);
 
   void begin(uint32_t freq = 0);
   void commonInit(const uint8_t *cmdList);
   void displayInit(const uint8_t *addr);
+  void initBegin(void);
+  void initAdd(const uint8_t *cmdList);
   void setColRowStart(int8_t col, int8_t row);
 };
 
@@ -117,6 +117,7 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
   wrap = true;
   _cp437 = false;
   gfxFont = NULL;
+  scroll_y = scroll_h = scroll_pos = 0;
 }
 
 /**************************************************************************/
@@ -1327,6 +1328,7 @@ void Adafruit_GFX::setRotation(uint8_t x) {
     _height = WIDTH;
     break;
   }
+  scroll_y = scroll_h = scroll_pos = 0; // The scroll area was in rows
 }
 
 /**************************************************************************/
@@ -1542,6 +1544,98 @@ void Adafruit_GFX::invertDisplay(bool i) {
   (void)i; // disable -Wunused-parameter warning
 }
 
+/**************************************************************************/
+/*!
+    @brief      Show a band of rows rotated: screen row y + i shows the row
+                drawn at y + (i + offset) % h. Must be subclassed if
+                supported by hardware.
+    @param      y       First row of the band
+    @param      h       Rows in the band, 0 to stop scrolling
+    @param      offset  Rows the band is moved up, 0 to h - 1
+    @returns    true if the display scrolled, false if not supported
+*/
+/**************************************************************************/
+bool Adafruit_GFX::setVerticalScroll(int16_t y, int16_t h, int16_t offset) {
+  (void)y; // disable -Wunused-parameter warning
+  (void)h;
+  (void)offset;
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the rows moved by scroll(), for terminal or log views. The
+            rows above and below stay in place. Shows the area unscrolled.
+    @param  y  First row of the area
+    @param  h  Rows in the area, 0 to stop scrolling
+*/
+/**************************************************************************/
+void Adafruit_GFX::setScrollArea(int16_t y, int16_t h) {
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if ((y + h) > _height) {
+    h = _height - y;
+  }
+  scroll_y = y;
+  scroll_h = (h > 0) ? h : 0;
+  scroll_pos = 0;
+  setVerticalScroll(scroll_y, scroll_h, 0);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Move the scroll area (see setScrollArea()) up, like a
+              terminal taking a new line. With hardware scrolling only a
+              scroll command and the cleared rows are sent, nothing is
+              redrawn. Without it the new rows wrap around to the top of
+              the area instead.
+    @param    dy     Rows to move up, e.g. the height of a line of text.
+                     Keep the height of the area a multiple of it. The
+                     area can't move down, nothing happens for dy <= 0.
+    @param    color  16-bit 5-6-5 Color to clear the new rows with
+    @returns  Row to draw the new content at, e.g. with setCursor(). 0 if
+              nothing was moved.
+*/
+/**************************************************************************/
+int16_t Adafruit_GFX::scroll(int16_t dy, uint16_t color) {
+  if (!scroll_h || (dy <= 0)) {
+    return 0;
+  }
+  if (dy > scroll_h) {
+    dy = scroll_h;
+  }
+  // The rows moved off the top come back at the bottom, to be cleared
+  int16_t row = scroll_pos;
+  scroll_pos = (scroll_pos + dy) % scroll_h;
+  setVerticalScroll(scroll_y, scroll_h, scroll_pos);
+  int16_t n = scroll_h - row;
+  startWrite();
+  if (dy > n) {
+    writeFillRect(0, scroll_y + row, _width, n, color);
+    writeFillRect(0, scroll_y, _width, dy - n, color);
+  } else {
+    writeFillRect(0, scroll_y + row, _width, dy, color);
+  }
+  endWrite();
+  return scroll_y + row;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Row to draw at for a row as shown in the scroll area.
+    @param    row  Row of the screen
+    @returns  Row to draw at, row itself outside the scroll area
+*/
+/**************************************************************************/
+int16_t Adafruit_GFX::scrollRow(int16_t row) const {
+  if ((row < scroll_y) || (row >= (scroll_y + scroll_h))) {
+    return row;
+  }
+  return scroll_y + (row - scroll_y + scroll_pos) % scroll_h;
+}
+
 /***************************************************************************/
 
 /**************************************************************************/
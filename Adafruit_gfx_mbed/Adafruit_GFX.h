@@ -49,6 +49,7 @@ public:
   // optimized code.  Otherwise 'generic' versions are used.
   virtual void setRotation(uint8_t r);
   virtual void invertDisplay(bool i);
+  virtual bool setVerticalScroll(int16_t y, int16_t h, int16_t offset);
 
   // BASIC DRAW API
   // These MAY be overridden by the subclass to provide device-specific
@@ -120,6 +121,9 @@ public:
   void setTextSize(uint8_t s);
   void setTextSize(uint8_t sx, uint8_t sy);
   void setFont(const GFXfont *f = NULL);
+  void setScrollArea(int16_t y, int16_t h);
+  int16_t scroll(int16_t dy, uint16_t color);
+  int16_t scrollRow(int16_t row) const;
 
   /**********************************************************************/
   /*!
@@ -246,6 +250,9 @@ protected:
   bool wrap;            ///< If set, 'wrap' text at right edge of display
   bool _cp437;          ///< If set, use correct CP437 charset (default is off)
   GFXfont *gfxFont;     ///< Pointer to special font
+  int16_t scroll_y;     ///< First row of the scroll area
+  int16_t scroll_h;     ///< Rows of the scroll area, 0 if none
+  int16_t scroll_pos;   ///< Rows the scroll area has moved up, 0 to h-1
 };
 
 /// A simple drawn button UI element
@@ -35,6 +35,10 @@
 
 #include "Adafruit_SPITFT.h"
 
+#if defined(__MBED__)
+#include "hal/us_ticker_api.h" // us_ticker_read() for frame pacing
+#endif
+
 #if defined(__AVR__)
 #if defined(__AVR_XMEGA__) // only tested with __AVR_ATmega4809__
 #define AVR_WRITESPI(x)                                                        \
@@ -91,11 +95,114 @@ static const struct {
 
 #endif // end USE_SPI_DMA
 
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+// Non-blocking writePixels() is done, put the caller's colors back in
+// CPU byte order. Called from the SPIM interrupt.
+static void pixels_sent(void *context) {
+  SPIXfer *xfer = (SPIXfer *)context;
+  uint16_t *colors = (uint16_t *)xfer->tx_buf;
+  for (size_t i = 0; i < xfer->count / 2; i++) {
+    colors[i] = __builtin_bswap16(colors[i]);
+  }
+}
+
+// A packed pixel buffer is sent, context is its busy flag. Called from the
+// SPIM interrupt.
+static void wire_sent(void *context) { *(volatile bool *)context = false; }
+
+// Pack RGB565 pixels (byte swapped first if swap) into the wire formats,
+// big-endian. Each returns the number of bytes written to out.
+static size_t pack565(uint8_t *out, const uint16_t *in, size_t n, bool swap) {
+  for (size_t i = 0; i < n; i++) {
+    uint16_t const c = swap ? __builtin_bswap16(in[i]) : in[i];
+    *out++ = c >> 8;
+    *out++ = c;
+  }
+  return 2 * n;
+}
+
+// Two pixels in three bytes, 4 bits per color
+static inline uint8_t *put444(uint8_t *out, uint16_t c0, uint16_t c1) {
+  *out++ = ((c0 >> 8) & 0xF0) | ((c0 >> 7) & 0x0F); // R0 G0
+  *out++ = ((c0 << 3) & 0xF0) | (c1 >> 12);         // B0 R1
+  *out++ = ((c1 >> 3) & 0xF0) | ((c1 >> 1) & 0x0F); // G1 B1
+  return out;
+}
+
+// The pixel held back by the previous call goes first (if *carried), an
+// odd one at the end is held back for the next.
+static size_t pack444(uint8_t *out, const uint16_t *in, size_t n, bool swap,
+                      uint16_t *carry, bool *carried) {
+  uint8_t *const start = out;
+  size_t i = 0;
+  if (*carried && n) {
+    out = put444(out, *carry, swap ? __builtin_bswap16(in[0]) : in[0]);
+    *carried = false;
+    i = 1;
+  }
+  for (; i + 1 < n; i += 2) {
+    out = swap ? put444(out, __builtin_bswap16(in[i]),
+                        __builtin_bswap16(in[i + 1]))
+               : put444(out, in[i], in[i + 1]);
+  }
+  if (i < n) {
+    *carry = swap ? __builtin_bswap16(in[i]) : in[i];
+    *carried = true;
+  }
+  return out - start;
+}
+
+// 6 bits per color in the top bits of a byte, 5 bit red and blue widened
+static size_t pack666(uint8_t *out, const uint16_t *in, size_t n, bool swap) {
+  for (size_t i = 0; i < n; i++) {
+    uint16_t const c = swap ? __builtin_bswap16(in[i]) : in[i];
+    uint8_t const r = c >> 11, b = c & 0x1F;
+    *out++ = (r << 3) | (r >> 2);
+    *out++ = (c >> 3) & 0xFC;
+    *out++ = (b << 3) | (b >> 2);
+  }
+  return 3 * n;
+}
+
+// ARGB8888 straight to 18 bits, nothing lost on the way through RGB565
+static size_t pack888(uint8_t *out, const uint32_t *in, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    uint32_t const c = in[i];
+    *out++ = (c >> 16) & 0xFC;
+    *out++ = (c >> 8) & 0xFC;
+    *out++ = c & 0xFC;
+  }
+  return 3 * n;
+}
+#endif
+
 // Possible values for Adafruit_SPITFT.connection:
 #define TFT_HARD_SPI 0 ///< Display interface = hardware SPI
 #define TFT_SOFT_SPI 1 ///< Display interface = software SPI
 #define TFT_PARALLEL 2 ///< Display interface = 8- or 16-bit parallel
 
+// Bits of Adafruit_SPITFT._winValid:
+#define TFT_WIN_COLUMNS 0x01 ///< _winX0/_winX1 match the display
+#define TFT_WIN_ROWS 0x02    ///< _winY0/_winY1 match the display
+#define TFT_WIN_WRITE 0x04   ///< Memory write still going, _winPixels valid
+
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+// Pixels given to Adafruit_SPITFT::writeWire():
+#define TFT_WIRE_565 0   ///< uint16_t RGB565, CPU byte order
+#define TFT_WIRE_565BE 1 ///< uint16_t RGB565, big-endian
+#define TFT_WIRE_8 2     ///< uint8_t indices into an RGB565 palette
+#define TFT_WIRE_32 3    ///< uint32_t ARGB8888
+#endif
+
+// Frame pacing: microsecond clock, and how many lines the estimated scan
+// line may be off
+#if defined(__MBED__)
+#define TFT_MICROS() us_ticker_read() ///< Microseconds, wrapping
+#else
+#define TFT_MICROS() micros() ///< Microseconds, wrapping
+#endif
+#define TFT_SCAN_MARGIN 4 ///< Uncertainty of scanLine() in lines
+
 // CONSTRUCTORS ------------------------------------------------------------
 
 /*!
@@ -519,17 +626,22 @@ Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, tftBusWidth busWidth,
                      defined in SPI.h. Do NOT attempt to pass '0' for
                      SPI_MODE0 and so forth...the values are NOT the same!
                      Use ONLY the defines! (Pity it's not an enum.)
+    @param  reset    If true (default), pulse the reset pin (if any) and
+                     wait for the display, 300 ms. Pass false if the caller
+                     resets the display itself without blocking, e.g.
+                     Adafruit_ST77xx::initStep().
     @note   Another anachronistically-named function; this is called even
             when the display connection is parallel (not SPI). Also, this
             could probably be made private...quite a few class functions
             were generously put in the public section.
 */
-void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
+void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode, bool reset) {
 
   if (!freq)
     freq = DEFAULT_SPI_FREQ; // If no freq specified, use default
 
   _freq = freq;
+  invalidateAddrWindow();
 
   // Init basic control pins common to all connection types
   if (_cs >= 0) {
@@ -585,6 +697,12 @@ void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
     ) {
       hwspi._spi->begin();
     }
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+    // SPIM3 can switch DC by itself for command streams
+    hwspi._dcx = hwspi._spi->setDCXPin(_dc);
+#else
+    hwspi._dcx = false;
+#endif
   } else if (connection == TFT_SOFT_SPI) {
 
     pinMode(swspi._mosi, OUTPUT);
@@ -640,7 +758,7 @@ void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
     }
   }
 
-  if (_rst >= 0) {
+  if ((_rst >= 0) && reset) {
     // Toggle _rst low to reset
     pinMode(_rst, OUTPUT);
     digitalWrite(_rst, HIGH);
@@ -925,6 +1043,15 @@ void Adafruit_SPITFT::startWrite(void) {
             for all display types; not an SPI-specific function.
 */
 void Adafruit_SPITFT::endWrite(void) {
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+  if (wireCarry) {
+    // The last 12-bit pixel goes out padded, the next pixels can't
+    // continue this memory write half a byte in
+    writeWireCarry();
+    _winValid &= ~TFT_WIN_WRITE;
+  }
+  dmaWait(); // Keep CS low until non-blocking writePixels() is done
+#endif
   if (_cs >= 0)
     SPI_CS_HIGH();
   SPI_END_TRANSACTION();
@@ -948,10 +1075,40 @@ void Adafruit_SPITFT::endWrite(void) {
 void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
   if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
     setAddrWindow(x, y, 1, 1);
-    SPI_WRITE16(color);
+    writePixelColor(color);
   }
 }
 
+/*!
+    @brief  Send one pixel in the wire format (see setPixelFormat()),
+            packed right here rather than by writeColor(). In RGB444 a
+            pixel without a pair is held back until the next pixel, a
+            command or endWrite(). Not self-contained; should follow
+            startWrite() and setAddrWindow() calls.
+    @param  color  16-bit pixel color in '565' RGB format.
+*/
+void Adafruit_SPITFT::writePixelColor(uint16_t color) {
+  _winPixels++;
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+  if (pixelFormat != TFT_PIXEL_RGB565) {
+    uint8_t bytes[3];
+    if (pixelFormat == TFT_PIXEL_RGB666) {
+      pack666(bytes, &color, 1, false);
+    } else if (wireCarry) {
+      put444(bytes, wireCarryColor, color);
+      wireCarry = false;
+    } else {
+      wireCarry = true;
+      wireCarryColor = color;
+      return;
+    }
+    hwspi._spi->transfer(bytes, nullptr, 3); // Waits for the queue first
+    return;
+  }
+#endif
+  SPI_WRITE16(color);
+}
+
 /*!
     @brief  Issue a series of pixels from memory to the display. Not self-
             contained; should follow startWrite() and setAddrWindow() calls.
@@ -986,6 +1143,8 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
   if (!len)
     return; // Avoid 0-byte transfers
 
+  _winPixels += len; // Where the display's write position will be
+
   // avoid paramater-not-used complaints
   (void)block;
   (void)bigEndian;
@@ -997,6 +1156,17 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
   }
 #elif defined(__MBED__) &&                                       \
     defined(NRF52840_XXAA) // Adafruit nRF52 use SPIM3 DMA at 32Mhz
+  if ((pixelFormat != TFT_PIXEL_RGB565) && (connection == TFT_HARD_SPI)) {
+    // Byte swap and pack in one go, colors is left as it is
+    writeWire(colors, bigEndian ? TFT_WIRE_565BE : TFT_WIRE_565, NULL, len,
+              block);
+    return;
+  }
+
+  if (!block && (connection == TFT_HARD_SPI)) {
+    dmaWait(); // colors may be the buffer still going out
+  }
+
   // TFT and SPI DMA endian is different we need to swap bytes
   if (!bigEndian) {
     for (uint32_t i = 0; i < len; i++) {
@@ -1004,6 +1174,19 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
     }
   }
 
+  if (!block && (connection == TFT_HARD_SPI)) {
+    // Return while the SPIM sends the pixels, its interrupt swaps them back
+    pixelXfer.tx_buf = colors;
+    pixelXfer.count = 2 * len;
+    pixelXfer.repeat = 1;
+    pixelXfer.cmd_count = 0;
+    pixelXfer.callback = bigEndian ? NULL : pixels_sent;
+    pixelXfer.context = &pixelXfer;
+    if (hwspi._spi->queue(&pixelXfer)) {
+      return;
+    }
+  }
+
   // use the separate tx, rx buf variant to prevent overwrite the buffer
   hwspi._spi->transfer(colors, nullptr, 2 * len);
 
@@ -1114,6 +1297,190 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
   }
 }
 
+/*!
+    @brief  Issue a series of pixels from 32-bit ARGB8888 colors (alpha is
+            ignored), e.g. an LVGL buffer with LV_COLOR_DEPTH 32. Not
+            self-contained; should follow startWrite() and setAddrWindow()
+            calls. With the RGB666 pixel format all 18 bits go to the
+            display, otherwise the colors are reduced on the way.
+    @param  colors  Pointer to array of 32-bit pixel values.
+    @param  len     Number of elements in 'colors' array.
+    @param  block   If true (default case if unspecified), function blocks
+                    until the transfer is complete. On the nRF52840 the
+                    colors are packed into buffers of its own, so 'colors'
+                    may be changed as soon as this returns either way.
+*/
+void Adafruit_SPITFT::writePixels32(const uint32_t *colors, uint32_t len,
+                                    bool block) {
+  if (!len)
+    return;
+
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+  if (connection == TFT_HARD_SPI) {
+    _winPixels += len;
+    writeWire(colors, TFT_WIRE_32, NULL, len, block);
+    return;
+  }
+#endif
+
+  // Everything else takes RGB565, a chunk at a time
+  uint16_t tmp[32];
+  while (len) {
+    uint32_t const n = (len < 32) ? len : 32;
+    for (uint32_t i = 0; i < n; i++) {
+      uint32_t const c = colors[i];
+      tmp[i] = ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x1F);
+    }
+    writePixels(tmp, n);
+    colors += n;
+    len -= n;
+  }
+  (void)block;
+}
+
+/*!
+    @brief  Issue a series of pixels from 8-bit indices into a table of
+            RGB565 colors. Not self-contained; should follow startWrite()
+            and setAddrWindow() calls. Useful with LV_COLOR_DEPTH 8 (a
+            table of the 256 RGB332 colors) or with paletted images that
+            take half the memory of RGB565 ones.
+    @param  indices  Pointer to array of 8-bit palette indices.
+    @param  palette  Pointer to the palette, up to 256 '565' RGB colors.
+    @param  len      Number of elements in 'indices' array.
+    @param  block    If true (default case if unspecified), function blocks
+                     until the transfer is complete. See writePixels32().
+*/
+void Adafruit_SPITFT::writePixels8(const uint8_t *indices,
+                                   const uint16_t *palette, uint32_t len,
+                                   bool block) {
+  if (!len)
+    return;
+
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+  if (connection == TFT_HARD_SPI) {
+    _winPixels += len;
+    writeWire(indices, TFT_WIRE_8, palette, len, block);
+    return;
+  }
+#endif
+
+  uint16_t tmp[32];
+  while (len) {
+    uint32_t const n = (len < 32) ? len : 32;
+    for (uint32_t i = 0; i < n; i++) {
+      tmp[i] = palette[indices[i]];
+    }
+    writePixels(tmp, n);
+    indices += n;
+    len -= n;
+  }
+  (void)block;
+}
+
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+/*!
+    @brief  Pack pixels into the pixel format on the wire and queue them
+            on the SPIM, TFT_WIRE_PIXELS at a time, alternating between two
+            buffers so the next one is packed while the last goes out. In
+            RGB444 an odd pixel at the end is held back until the next
+            pixel, a command or endWrite(). Doesn't count _winPixels.
+    @param  colors   Pixels, see source.
+    @param  source   TFT_WIRE_565, TFT_WIRE_565BE, TFT_WIRE_8 or
+                     TFT_WIRE_32.
+    @param  palette  RGB565 colors of TFT_WIRE_8 indices, else unused.
+    @param  len      Number of pixels.
+    @param  block    If true, return once all of them are sent.
+*/
+void Adafruit_SPITFT::writeWire(const void *colors, uint8_t source,
+                                const uint16_t *palette, uint32_t len,
+                                bool block) {
+  uint16_t tmp[TFT_WIRE_PIXELS];
+  while (len) {
+    uint32_t const n = (len < TFT_WIRE_PIXELS) ? len : TFT_WIRE_PIXELS;
+    const uint16_t *px = tmp;
+    bool swap = false;
+    switch (source) {
+    case TFT_WIRE_565:
+    case TFT_WIRE_565BE:
+      px = (const uint16_t *)colors;
+      swap = (source == TFT_WIRE_565BE);
+      colors = px + n;
+      break;
+    case TFT_WIRE_8: {
+      const uint8_t *in = (const uint8_t *)colors;
+      for (uint32_t i = 0; i < n; i++) {
+        tmp[i] = palette[in[i]];
+      }
+      colors = in + n;
+      break;
+    }
+    default: // TFT_WIRE_32, packed directly in RGB666
+      if (pixelFormat != TFT_PIXEL_RGB666) {
+        const uint32_t *in = (const uint32_t *)colors;
+        for (uint32_t i = 0; i < n; i++) {
+          uint32_t const c = in[i];
+          tmp[i] =
+              ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x1F);
+        }
+      }
+      break;
+    }
+
+    while (wireBusy[wireIdx])
+      ; // Wait for this buffer's last transfer
+    uint8_t *const out = wireBuf[wireIdx];
+    size_t count;
+    if (pixelFormat == TFT_PIXEL_RGB444) {
+      count = pack444(out, px, n, swap, &wireCarryColor, &wireCarry);
+    } else if (source == TFT_WIRE_32 && pixelFormat == TFT_PIXEL_RGB666) {
+      count = pack888(out, (const uint32_t *)colors, n);
+    } else if (pixelFormat == TFT_PIXEL_RGB666) {
+      count = pack666(out, px, n, swap);
+    } else {
+      count = pack565(out, px, n, swap);
+    }
+    if (source == TFT_WIRE_32) {
+      colors = (const uint32_t *)colors + n;
+    }
+    len -= n;
+
+    if (count) { // A single 12-bit pixel is only held back
+      SPIXfer &xfer = wireXfer[wireIdx];
+      xfer.tx_buf = out;
+      xfer.count = count;
+      xfer.repeat = 1;
+      xfer.cmd_count = 0;
+      xfer.callback = wire_sent;
+      xfer.context = (void *)&wireBusy[wireIdx];
+      wireBusy[wireIdx] = true;
+      if (!hwspi._spi->queue(&xfer)) {
+        wireBusy[wireIdx] = false;
+        hwspi._spi->transfer(out, nullptr, count);
+      }
+      wireIdx ^= 1;
+    }
+  }
+
+  if (block) {
+    dmaWait();
+  }
+}
+
+/*!
+    @brief  Send the 12-bit pixel writeWire() held back, padded to two
+            bytes. The display drops the 4 bits left over when the memory
+            write ends.
+*/
+void Adafruit_SPITFT::writeWireCarry(void) {
+  wireCarry = false;
+  uint16_t const pad = 0;
+  bool carried = true;
+  uint8_t bytes[3];
+  pack444(bytes, &pad, 1, false, &wireCarryColor, &carried);
+  hwspi._spi->transfer(bytes, nullptr, 2); // Waits for the queue first
+}
+#endif
+
 /*!
     @brief  Wait for the last DMA transfer in a prior non-blocking
             writePixels() call to complete. This does nothing if DMA
@@ -1132,6 +1499,10 @@ void Adafruit_SPITFT::dmaWait(void) {
     pinPeripheral(tft8._wr, PIO_OUTPUT); // Switch WR back to GPIO
   }
 #endif // end __SAMD51__ || ARDUINO_SAMD_ZERO
+#elif defined(__MBED__) && defined(NRF52840_XXAA)
+  if (connection == TFT_HARD_SPI) {
+    hwspi._spi->waitQueue();
+  }
 #endif
 }
 
@@ -1146,6 +1517,7 @@ void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
   if (!len)
     return; // Avoid 0-byte transfers
 
+  _winPixels += len; // Where the display's write position will be
   uint8_t hi = color >> 8, lo = color;
 
 #if defined(ESP32) // ESP32 has a special SPI pixel-writing function...
@@ -1163,38 +1535,78 @@ void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
       temp[t] = c32;
     }
     // Issue pixels in blocks from temp buffer
+    uint32_t const winPixels = _winPixels;     // writePixels() counts too
     while (len) {                              // While pixels remain
       xferLen = (bufLen < len) ? bufLen : len; // How many this pass?
       writePixels((uint16_t *)temp, xferLen);
       len -= xferLen;
     }
+    _winPixels = winPixels;
     return;
   }
 #elif defined(__MBED__) &&                                       \
     defined(NRF52840_XXAA) // Adafruit nRF52840 use SPIM3 DMA at 32Mhz
-  // at most 2 scan lines
-  uint32_t const pixbufcount = min(len, ((uint32_t)10 * width()));
-  // uint16_t *pixbuf = (uint16_t *)rtos_malloc(2 * pixbufcount);
-  uint16_t *pixbuf = new (std::nothrow) uint16_t[pixbufcount];
-
-  // use SPI3 DMA if we could allocate buffer, else fall back to writing each
-  // pixel loop below
-  if (pixbuf) {
-    uint16_t const swap_color = __builtin_bswap16(color);
-
-    // fill buffer with color
-    for (uint32_t i = 0; i < pixbufcount; i++) {
-      pixbuf[i] = swap_color;
+  if (connection == TFT_HARD_SPI) {
+    if (wireCarry) {
+      // Pair the 12-bit pixel held back with the first one
+      writeWire(&color, TFT_WIRE_565, NULL, 1, false);
+      if (!--len)
+        return;
     }
 
-    while (len) {
-      uint32_t const count = min(len, pixbufcount);
-      writePixels(pixbuf, count, true, true);
-      len -= count;
+    dmaWait(); // fillBuf may still be going out
+
+    // One block of the color in the wire format. 12-bit pixels come in
+    // pairs of 3 bytes, an odd one at the end is held back.
+    uint16_t block[TFT_FILL_PIXELS];
+    for (uint32_t i = 0; i < TFT_FILL_PIXELS; i++) {
+      block[i] = color;
+    }
+    uint32_t rest = len % TFT_FILL_PIXELS, restBytes;
+    if (pixelFormat == TFT_PIXEL_RGB444) {
+      uint16_t carry;
+      bool carried = false;
+      pack444(fillBuf, block, TFT_FILL_PIXELS, false, &carry, &carried);
+      if (rest & 1) {
+        rest--;
+        wireCarry = true;
+        wireCarryColor = color;
+      }
+      restBytes = rest / 2 * 3;
+    } else if (pixelFormat == TFT_PIXEL_RGB666) {
+      pack666(fillBuf, block, TFT_FILL_PIXELS, false);
+      restBytes = rest * 3;
+    } else {
+      pack565(fillBuf, block, TFT_FILL_PIXELS, false);
+      restBytes = rest * 2;
     }
 
-    // rtos_free(pixbuf);
-    delete[] pixbuf; /* free memory */
+    // One block sent len / TFT_FILL_PIXELS times by the SPIM itself, then
+    // the rest of the pixels. Returns while they go out, like writePixels()
+    // with block = false.
+    uint32_t const blocks = len / TFT_FILL_PIXELS;
+    if (blocks) {
+      fillXfer[0].tx_buf = fillBuf;
+      fillXfer[0].count = (pixelFormat == TFT_PIXEL_RGB565)
+                              ? 2 * TFT_FILL_PIXELS
+                              : (pixelFormat == TFT_PIXEL_RGB444)
+                                    ? 3 * TFT_FILL_PIXELS / 2
+                                    : 3 * TFT_FILL_PIXELS;
+      fillXfer[0].repeat = blocks;
+      if (!hwspi._spi->queue(&fillXfer[0])) {
+        for (uint32_t b = 0; b < blocks; b++) {
+          hwspi._spi->transfer(fillBuf, nullptr, fillXfer[0].count);
+        }
+      }
+    }
+    if (restBytes) {
+      fillXfer[1].tx_buf = fillBuf;
+      fillXfer[1].count = restBytes;
+      fillXfer[1].repeat = 1;
+      if (!hwspi._spi->queue(&fillXfer[1])) {
+        hwspi._spi->transfer(fillBuf, nullptr, restBytes);
+      }
+    }
     return;
   }
 #else                      // !ESP32
@@ -1595,7 +2007,7 @@ void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
     // THEN set up transaction (if needed) and draw...
     startWrite();
     setAddrWindow(x, y, 1, 1);
-    SPI_WRITE16(color);
+    writePixelColor(color);
     endWrite();
   }
 }
@@ -1753,7 +2165,7 @@ void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h,
 */
 void Adafruit_SPITFT::pushColor(uint16_t color) {
   startWrite();
-  SPI_WRITE16(color);
+  writePixelColor(color);
   endWrite();
 }
 
@@ -1810,9 +2222,110 @@ void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
   endWrite();
 }
 
+/*!
+    @brief  Draw a paletted image (8-bit indices into a table of RGB565
+            colors) at the specified (x,y) position, with the same
+            clipping as drawRGBBitmap(). Half the memory of an RGB565
+            image. Self-contained, no transaction setup required.
+    @param  x        Top left corner horizontal coordinate.
+    @param  y        Top left corner vertical coordinate.
+    @param  bitmap   Pointer to 8-bit array of palette indices.
+    @param  palette  Pointer to the palette, '565' RGB colors.
+    @param  w        Width of bitmap in pixels.
+    @param  h        Height of bitmap in pixels.
+*/
+void Adafruit_SPITFT::drawPalettedBitmap(int16_t x, int16_t y,
+                                         const uint8_t *bitmap,
+                                         const uint16_t *palette, int16_t w,
+                                         int16_t h) {
+
+  int16_t x2, y2;                 // Lower-right coord
+  if ((x >= _width) ||            // Off-edge right
+      (y >= _height) ||           // " top
+      ((x2 = (x + w - 1)) < 0) || // " left
+      ((y2 = (y + h - 1)) < 0))
+    return; // " bottom
+
+  int16_t bx1 = 0, by1 = 0, // Clipped top-left within bitmap
+      saveW = w;            // Save original bitmap width value
+  if (x < 0) {              // Clip left
+    w += x;
+    bx1 = -x;
+    x = 0;
+  }
+  if (y < 0) { // Clip top
+    h += y;
+    by1 = -y;
+    y = 0;
+  }
+  if (x2 >= _width)
+    w = _width - x; // Clip right
+  if (y2 >= _height)
+    h = _height - y; // Clip bottom
+
+  bitmap += by1 * saveW + bx1; // Offset bitmap ptr to clipped top-left
+  startWrite();
+  setAddrWindow(x, y, w, h); // Clipped area
+  while (h--) {              // For each (clipped) scanline...
+    writePixels8(bitmap, palette, w, false); // Packed while the last goes
+    bitmap += saveW;
+  }
+  endWrite();
+}
+
+/*!
+    @brief  Draw a GFXcanvas8 through a palette at the specified (x,y)
+            position, e.g. a UI rendered in 8-bit indices. The canvas is
+            sent as it is in memory, its rotation doesn't apply.
+            Self-contained, no transaction setup required.
+    @param  x        Top left corner horizontal coordinate.
+    @param  y        Top left corner vertical coordinate.
+    @param  canvas   The canvas, its pixels are indices into palette.
+    @param  palette  Pointer to the 256 entry palette, '565' RGB colors.
+*/
+void Adafruit_SPITFT::drawPalettedBitmap(int16_t x, int16_t y,
+                                         const GFXcanvas8 &canvas,
+                                         const uint16_t *palette) {
+  // width() and height() follow the canvas' rotation
+  bool const swap = canvas.getRotation() & 1;
+  drawPalettedBitmap(x, y, canvas.getBuffer(), palette,
+                     swap ? canvas.height() : canvas.width(),
+                     swap ? canvas.width() : canvas.height());
+}
+
 // -------------------------------------------------------------------------
 // Miscellaneous class member functions that don't draw anything.
 
+/*!
+    @brief  Set the pixel format sent to the display. RGB444 sends 12 bits
+            per pixel, 25% less than RGB565, for screens that don't need
+            the color depth, e.g. UIs with a few flat colors. RGB666 sends
+            18 bits per pixel, so writePixels32() keeps the 2 bits RGB565
+            drops. RGB565 colors are packed on the fly, the rest of the API
+            stays RGB565. Only hardware SPI on the nRF52840 does the
+            packing; subclasses also tell the display (COLMOD).
+    @param  format  TFT_PIXEL_RGB565, TFT_PIXEL_RGB444 or TFT_PIXEL_RGB666.
+    @return true if the format is set, false if not supported here.
+*/
+bool Adafruit_SPITFT::setPixelFormat(uint8_t format) {
+  if (format > TFT_PIXEL_RGB666)
+    return false;
+  if (format != TFT_PIXEL_RGB565) {
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+    if (connection != TFT_HARD_SPI)
+      return false;
+#else
+    return false;
+#endif
+  }
+  startWrite();
+  invalidateAddrWindow(); // Sends a held back pixel in the old format
+  endWrite();
+  dmaWait();
+  pixelFormat = format;
+  return true;
+}
+
 /*!
     @brief  Invert the colors of the display (if supported by hardware).
             Self-contained, no transaction setup required.
@@ -1847,6 +2360,7 @@ data
 */
 void Adafruit_SPITFT::sendCommand(uint8_t commandByte, uint8_t *dataBytes,
                                   uint8_t numDataBytes) {
+  invalidateAddrWindow(); // Any command ends a memory write
   SPI_BEGIN_TRANSACTION();
   if (_cs >= 0)
     SPI_CS_LOW();
@@ -1879,6 +2393,7 @@ void Adafruit_SPITFT::sendCommand(uint8_t commandByte, uint8_t *dataBytes,
  */
 void Adafruit_SPITFT::sendCommand(uint8_t commandByte, const uint8_t *dataBytes,
                                   uint8_t numDataBytes) {
+  invalidateAddrWindow(); // Any command ends a memory write
   SPI_BEGIN_TRANSACTION();
   if (_cs >= 0)
     SPI_CS_LOW();
@@ -1915,6 +2430,7 @@ void Adafruit_SPITFT::sendCommand(uint8_t commandByte, const uint8_t *dataBytes,
 void Adafruit_SPITFT::sendCommand16(uint16_t commandWord,
                                     const uint8_t *dataBytes,
                                     uint8_t numDataBytes) {
+  invalidateAddrWindow(); // Any command ends a memory write
   SPI_BEGIN_TRANSACTION();
   if (_cs >= 0)
     SPI_CS_LOW();
@@ -1937,6 +2453,285 @@ void Adafruit_SPITFT::sendCommand16(uint16_t commandWord,
   SPI_END_TRANSACTION();
 }
 
+/*!
+ @brief   Issue several commands and their data at once. Chip-select and
+          transaction must have been previously set. On nRF52840 with SPIM3
+          each command goes out with its data in a single DMA transfer and
+          the SPI peripheral drives the DC line, otherwise the commands are
+          issued one byte at a time like writeCommand() and spiWrite().
+ @param   stream  Records of {numArgs, command, args...}, e.g.
+                  {4, CASET, x0h, x0l, x1h, x1l, 0, RAMWR}. Must be in RAM
+                  (not PROGMEM) since it may be read by DMA.
+ @param   len     Total number of bytes in stream.
+ */
+void Adafruit_SPITFT::writeCommandStream(const uint8_t *stream, uint16_t len) {
+  invalidateAddrWindow(); // Any command ends a memory write
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+  if ((connection == TFT_HARD_SPI) && hwspi._dcx) {
+    hwspi._spi->transferCommands(stream, len);
+    return;
+  }
+#endif
+
+  while (len >= 2) {
+    uint8_t numArgs = stream[0];
+    if (numArgs > len - 2)
+      numArgs = len - 2; // Truncated record
+    writeCommand(stream[1]);
+#if defined(__MBED__)
+    if (connection == TFT_HARD_SPI) {
+      if (numArgs)
+        hwspi._spi->transfer(stream + 2, nullptr, numArgs); // One transfer
+    } else
+#endif
+    {
+      for (uint8_t i = 0; i < numArgs; i++) {
+        spiWrite(stream[2 + i]);
+      }
+    }
+    stream += 2 + numArgs;
+    len -= 2 + numArgs;
+  }
+}
+
+/*!
+ @brief   Set the address window of a display that uses MIPI DCS style
+          column/row/memory write commands and start writing to it. Only
+          what the display doesn't already have is sent: CASET is skipped
+          if the columns didn't change, RASET if the first row didn't
+          change, and nothing at all is sent if the window continues where
+          the previous pixel writes left off (same columns, next row). For
+          the last case the rows always run to the bottom of the screen,
+          the display stops wherever the pixel data ends. Chip-select and
+          transaction must have been previously set.
+ @param   caset  Column address set command.
+ @param   raset  Row address set command.
+ @param   ramwr  Memory write command.
+ @param   x0     First column, including any _xstart offset.
+ @param   y0     First row, including any _ystart offset.
+ @param   x1     Last column, including any _xstart offset.
+ @param   y1     Last row, including any _ystart offset.
+ */
+void Adafruit_SPITFT::writeAddrWindow(uint8_t caset, uint8_t raset,
+                                      uint8_t ramwr, uint16_t x0, uint16_t y0,
+                                      uint16_t x1, uint16_t y1) {
+  uint16_t yEnd = _ystart + _height - 1;
+  if (y1 > yEnd)
+    yEnd = y1;
+
+  addrWindowStats.windows++;
+
+  // Display's write position is at the start of row y0 already?
+  if ((_winValid & TFT_WIN_WRITE) && (x0 == _winX0) && (x1 == _winX1) &&
+      (y1 <= _winY1)) {
+    uint16_t w = x1 - x0 + 1;
+    if (((_winPixels % w) == 0) && (_winRow + _winPixels / w == y0)) {
+      _winRow = y0;
+      _winPixels = 0;
+      addrWindowStats.continued++;
+      return;
+    }
+  }
+
+  uint8_t cmds[14], len = 0; // {numArgs, cmd, args...} for each command
+  if (!(_winValid & TFT_WIN_COLUMNS) || (x0 != _winX0) || (x1 != _winX1)) {
+    cmds[len++] = 4;
+    cmds[len++] = caset;
+    cmds[len++] = x0 >> 8;
+    cmds[len++] = x0;
+    cmds[len++] = x1 >> 8;
+    cmds[len++] = x1;
+    addrWindowStats.caset++;
+  }
+  if (!(_winValid & TFT_WIN_ROWS) || (y0 != _winY0) || (yEnd != _winY1)) {
+    cmds[len++] = 4;
+    cmds[len++] = raset;
+    cmds[len++] = y0 >> 8;
+    cmds[len++] = y0;
+    cmds[len++] = yEnd >> 8;
+    cmds[len++] = yEnd;
+    addrWindowStats.raset++;
+  }
+  cmds[len++] = 0;
+  cmds[len++] = ramwr;
+  addrWindowStats.ramwr++;
+
+  writeCommandStream(cmds, len);
+
+  _winX0 = x0;
+  _winX1 = x1;
+  _winY0 = y0;
+  _winY1 = yEnd;
+  _winRow = y0;
+  _winPixels = 0;
+  _winValid = TFT_WIN_COLUMNS | TFT_WIN_ROWS | TFT_WIN_WRITE;
+}
+
+/*!
+    @brief  Note the start of a panel refresh. Call on each rising edge of
+            the display's tearing effect (TE) output, after enabling it
+            (e.g. Adafruit_ST77xx::enableTearing()). Safe to call from an
+            interrupt. On a host, call it from a simulated TE source at the
+            panel's refresh rate.
+*/
+void Adafruit_SPITFT::tearingPulse(void) {
+  uint32_t const now = TFT_MICROS();
+  if (_teCount) {
+    uint32_t const period = now - _teTime;
+    // Smooth out interrupt latency, ignore gaps from missed pulses
+    if (!_tePeriod) {
+      _tePeriod = period;
+    } else if (period < 2 * _tePeriod) {
+      _tePeriod += ((int32_t)(period - _tePeriod)) / 8;
+    }
+  }
+  _teTime = now;
+  _teCount = _teCount + 1;
+  frameStats.pulses++;
+  frameStats.period = _tePeriod;
+}
+
+/*!
+    @brief   Wait for the next TE pulse, see tearingPulse().
+    @param   timeout  Microseconds to wait at most.
+    @return  true if a pulse came, false on timeout.
+*/
+bool Adafruit_SPITFT::waitTearing(uint32_t timeout) {
+  uint32_t const count = _teCount, start = TFT_MICROS();
+  while (_teCount == count) {
+    if ((TFT_MICROS() - start) >= timeout) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+    @brief   Estimate which line the panel is refreshing, from the time
+             since the last TE pulse and the measured refresh period.
+    @return  Scan line, 0 at the TE pulse, or -1 if not known (no pulses
+             yet, or the subclass did not set up the scan mapping).
+*/
+int16_t Adafruit_SPITFT::scanLine(void) {
+  uint32_t const period = _tePeriod;
+  if (!_scanLines || !period) {
+    return -1;
+  }
+  uint32_t const elapsed = (TFT_MICROS() - _teTime) % period;
+  return (uint64_t)elapsed * _scanLines / period;
+}
+
+/*!
+    @brief   Sort key for sending bands in the order that chases the scan
+             line: first the bands the scan has passed (the one it will
+             come back to first, first), then the ones it has yet to reach.
+    @param   y1  First row of the band.
+    @param   y2  Last row of the band.
+    @return  Key, lower goes first. 0 for all bands if the scan line is
+             not known.
+*/
+uint32_t Adafruit_SPITFT::scanOrder(int16_t y1, int16_t y2) {
+  int16_t const s = scanLine();
+  if ((s < 0) || (_scanFirst < 0)) {
+    return 0;
+  }
+  int32_t const a = (_scanFirst + y1) % _scanLines;
+  int32_t const b = (_scanFirst + y2) % _scanLines;
+  return (b < s) ? a : a + _scanLines;
+}
+
+/*!
+    @brief  Wait until a band of rows can be sent without the panel
+            refresh catching up with it in the middle (tearing): right
+            behind the scan line, so the next refresh shows all of it new.
+            The bands of a frame (see beginFrame()) all go behind the same
+            refresh, so it shows the whole frame. Call before
+            setAddrWindow() for the band, with any earlier pixels already
+            sent (dmaWait()). Returns right away if the scan line is not
+            known, see scanLine().
+    @param  y1      First row of the band.
+    @param  y2      Last row of the band.
+    @param  pixels  Pixels to send for the band.
+*/
+void Adafruit_SPITFT::chaseScanLine(int16_t y1, int16_t y2, uint32_t pixels) {
+  uint32_t const start = TFT_MICROS();
+  uint32_t const T = _tePeriod;
+  if (!_scanLines || (_scanFirst < 0) || !T || (y2 < y1) || !_freq) {
+    return;
+  }
+  frameStats.bands++;
+
+  int32_t const L = _scanLines, m = TFT_SCAN_MARGIN;
+  int32_t const a = (_scanFirst + y1) % L, n = y2 - y1 + 1;
+  static const uint8_t bits[] = {16, 12, 18}; // Per pixel, by pixelFormat
+  int64_t const w = (uint64_t)pixels * bits[pixelFormat] * 1000000 / _freq;
+  if (!_inFrame || _chaseFirst) {
+    _chaseTe = _teTime;
+  }
+
+  // Times from the start of the refresh (_chaseTe): the scan leaves the
+  // band, and comes back to its first and last rows one refresh later
+  for (uint8_t tries = 0;; tries++) {
+    int64_t const now = (int32_t)(start - _chaseTe);
+    int64_t const after = (int64_t)(a + n + m) * T / L;
+    int64_t const first = T + (int64_t)(a - m) * T / L;
+    int64_t const last = T + (int64_t)(a + n - 1 - m) * T / L;
+    int64_t const begin = (now > after) ? now : after;
+    if ((begin + w / n <= first) && (begin + w <= last)) {
+      if (begin > now) {
+        while ((int64_t)(uint32_t)(TFT_MICROS() - start) < begin - now)
+          ;
+        frameStats.chaseWaits++;
+        frameStats.chaseWaitTime += TFT_MICROS() - start;
+      }
+      break;
+    }
+    // Too late for this refresh. Go behind the next one, unless earlier
+    // bands of the frame went behind this one already, or the band is too
+    // tall for the SPI clock
+    _chaseTe += T;
+    if ((_inFrame && !_chaseFirst) || tries) {
+      frameStats.torn++;
+      break;
+    }
+  }
+  _chaseFirst = false;
+}
+
+/*!
+    @brief  Start a frame made of several bands (e.g. one LittlevGL
+            refresh). With pace set, and TE pulses coming, waits until the
+            panel started a refresh since the previous frame, so frames
+            are not drawn faster than the panel shows them.
+    @param  pace  Wait for a TE pulse if needed.
+*/
+void Adafruit_SPITFT::beginFrame(bool pace) {
+  if (pace && _tePeriod && (_teCount == _teFrame)) {
+    uint32_t const start = TFT_MICROS();
+    waitTearing(2 * _tePeriod); // Don't hang if the pulses stopped
+    frameStats.teWaits++;
+    frameStats.teWaitTime += TFT_MICROS() - start;
+  }
+  _teFrame = _teCount;
+  _frameStart = TFT_MICROS();
+  _inFrame = true;
+  _chaseFirst = true;
+}
+
+/*!
+    @brief  End a frame started with beginFrame(), once its pixels are out.
+*/
+void Adafruit_SPITFT::endFrame(void) {
+  dmaWait();
+  _inFrame = false;
+  uint32_t const time = TFT_MICROS() - _frameStart;
+  frameStats.frames++;
+  frameStats.frameTime = time;
+  if (time > frameStats.frameTimeMax) {
+    frameStats.frameTimeMax = time;
+  }
+}
+
 /*!
  @brief   Read 8 bits of data from display configuration memory (not RAM).
  This is highly undocumented/supported and should be avoided,
@@ -1950,6 +2745,7 @@ void Adafruit_SPITFT::sendCommand16(uint16_t commandWord,
 /**************************************************************************/
 uint8_t Adafruit_SPITFT::readcommand8(uint8_t commandByte, uint8_t index) {
   uint8_t result;
+  invalidateAddrWindow(); // Any command ends a memory write
   startWrite();
   SPI_DC_LOW(); // Command mode
   spiWrite(commandByte);
@@ -1971,6 +2767,7 @@ uint16_t Adafruit_SPITFT::readcommand16(uint16_t addr) {
 #if defined(USE_FAST_PINIO) // NOT SUPPORTED without USE_FAST_PINIO
   uint16_t result = 0;
   if ((connection == TFT_PARALLEL) && tft8.wide) {
+    invalidateAddrWindow(); // Any command ends a memory write
     startWrite();
     SPI_DC_LOW(); // Command mode
     SPI_WRITE16(addr);
@@ -2095,6 +2892,7 @@ void Adafruit_SPITFT::spiWrite(uint8_t b) {
     @param  cmd  8-bit command to write.
 */
 void Adafruit_SPITFT::writeCommand(uint8_t cmd) {
+  invalidateAddrWindow(); // Any command ends a memory write
   SPI_DC_LOW();
   spiWrite(cmd);
   SPI_DC_HIGH();
@@ -2194,6 +2992,7 @@ void Adafruit_SPITFT::write16(uint16_t w) {
     @param  cmd  16-bit command to write.
 */
 void Adafruit_SPITFT::writeCommand16(uint16_t cmd) {
+  invalidateAddrWindow(); // Any command ends a memory write
   SPI_DC_LOW();
   write16(cmd);
   SPI_DC_HIGH();
@@ -94,6 +94,19 @@ typedef volatile ADAGFX_PORT_t *PORTreg_t; ///< PORT register type
 #include <Adafruit_ZeroDMA.h>
 #endif
 
+// Pixel formats on the wire, see Adafruit_SPITFT::setPixelFormat()
+#define TFT_PIXEL_RGB565 0 ///< 16 bits per pixel, 2 bytes
+#define TFT_PIXEL_RGB444 1 ///< 12 bits per pixel, 2 pixels in 3 bytes
+#define TFT_PIXEL_RGB666 2 ///< 18 bits per pixel, 3 bytes
+
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+// writeColor() sends this many pixels over and over, the SPIM repeats them
+#define TFT_FILL_PIXELS 64 ///< Size of the writeColor() color block
+// Pixels not sent as RGB565 are packed into two buffers of this many, the
+// CPU packs one while the SPIM sends the other
+#define TFT_WIRE_PIXELS 128 ///< Size of a packed pixel buffer
+#endif
+
 // This is kind of a kludge. Needed a way to disambiguate the software SPI
 // and parallel constructors via their argument lists. Originally tried a
 // bool as the first argument to the parallel constructor (specifying 8-bit
@@ -105,6 +118,31 @@ typedef volatile ADAGFX_PORT_t *PORTreg_t; ///< PORT register type
 /*! For first arg to parallel constructor */
 enum tftBusWidth { tft8bitbus, tft16bitbus };
 
+/*! Address window bookkeeping, see Adafruit_SPITFT::writeAddrWindow() */
+typedef struct {
+  uint32_t windows;   ///< Address windows requested
+  uint32_t caset;     ///< Column address commands actually sent
+  uint32_t raset;     ///< Row address commands actually sent
+  uint32_t ramwr;     ///< Memory write commands actually sent
+  uint32_t continued; ///< Windows that continued the previous memory write
+} tftAddrWindowStats;
+
+/*! Frame pacing with the tearing effect (TE) signal, see
+    Adafruit_SPITFT::tearingPulse() */
+typedef struct {
+  uint32_t pulses;        ///< TE pulses seen
+  uint32_t period;        ///< Panel refresh period in microseconds
+  uint32_t frames;        ///< Frames presented with beginFrame()/endFrame()
+  uint32_t teWaits;       ///< Frames that waited for a TE pulse
+  uint32_t teWaitTime;    ///< Microseconds spent waiting for TE pulses
+  uint32_t bands;         ///< Bands passed to chaseScanLine()
+  uint32_t chaseWaits;    ///< Bands that waited for the scan line
+  uint32_t chaseWaitTime; ///< Microseconds spent waiting for the scan line
+  uint32_t torn;          ///< Bands that missed their refresh, sent anyway
+  uint32_t frameTime;     ///< Microseconds of the last frame
+  uint32_t frameTimeMax;  ///< Microseconds of the slowest frame
+} tftFrameStats;
+
 // CLASS DEFINITION --------------------------------------------------------
 
 /*!
@@ -196,7 +234,8 @@ public:
   // values defined in SPI.h, which are NOT the same as 0 for SPI_MODE0,
   // 1 for SPI_MODE1, etc...use ONLY the SPI_MODEn defines! Only!
   // Name is outdated (interface may be parallel) but for compatibility:
-  void initSPI(uint32_t freq = 0, uint8_t spiMode = SPI_MODE0);
+  void initSPI(uint32_t freq = 0, uint8_t spiMode = SPI_MODE0,
+               bool reset = true);
   void setSPISpeed(uint32_t freq);
   // Chip select and/or hardware SPI transaction start as needed:
   void startWrite(void);
@@ -208,6 +247,60 @@ public:
                    uint8_t numDataBytes = 0);
   void sendCommand16(uint16_t commandWord, const uint8_t *dataBytes = NULL,
                      uint8_t numDataBytes = 0);
+  // Several commands + data in one go, records are {numArgs, cmd, args...}.
+  // Not self-contained, should follow a startWrite() call:
+  void writeCommandStream(const uint8_t *stream, uint16_t len);
+  // MIPI DCS style address window (CASET/RASET/RAMWR) that skips whatever
+  // the display already has. Not self-contained, should follow startWrite():
+  void writeAddrWindow(uint8_t caset, uint8_t raset, uint8_t ramwr,
+                       uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+  /*!
+      @brief  Forget the address window the display is known to have, the
+              next writeAddrWindow() sends everything. Needed only after
+              sending pixel data or commands with the raw spiWrite(),
+              write16(), SPI_WRITE16() or SPI_WRITE32() functions.
+  */
+  void invalidateAddrWindow(void) {
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+    if (wireCarry) {
+      writeWireCarry(); // Before the command that ends the memory write
+    }
+#endif
+    _winValid = 0;
+  }
+  /*!
+      @brief   Counters of the address window commands sent and skipped.
+      @return  Reference to the counters.
+  */
+  const tftAddrWindowStats &getAddrWindowStats(void) const {
+    return addrWindowStats;
+  }
+  /*!
+      @brief  Clear the address window counters.
+  */
+  void resetAddrWindowStats(void) { addrWindowStats = {}; }
+  // Tearing effect (TE) frame pacing. tearingPulse() must be called on
+  // each rising edge of the display's TE output (e.g. from an InterruptIn),
+  // or from a simulated TE source:
+  void tearingPulse(void);
+  bool waitTearing(uint32_t timeout);
+  int16_t scanLine(void);
+  uint32_t scanOrder(int16_t y1, int16_t y2);
+  void chaseScanLine(int16_t y1, int16_t y2, uint32_t pixels);
+  void beginFrame(bool pace = true);
+  void endFrame(void);
+  /*!
+      @brief   Counters and timing of TE paced frames.
+      @return  Reference to the counters.
+  */
+  const tftFrameStats &getFrameStats(void) const { return frameStats; }
+  /*!
+      @brief  Clear the frame pacing counters.
+  */
+  void resetFrameStats(void) {
+    frameStats = {};
+    frameStats.period = _tePeriod;
+  }
   uint8_t readcommand8(uint8_t commandByte, uint8_t index = 0);
   uint16_t readcommand16(uint16_t addr);
 
@@ -221,6 +314,10 @@ public:
   void writePixels(uint16_t *colors, uint32_t len, bool block = true,
                    bool bigEndian = false);
   void writeColor(uint16_t color, uint32_t len);
+  void writePixelColor(uint16_t color);
+  void writePixels32(const uint32_t *colors, uint32_t len, bool block = true);
+  void writePixels8(const uint8_t *indices, const uint16_t *palette,
+                    uint32_t len, bool block = true);
   void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                      uint16_t color);
   void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
@@ -252,8 +349,18 @@ public:
   using Adafruit_GFX::drawRGBBitmap; // Check base class first
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
                      int16_t h);
+  void drawPalettedBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                          const uint16_t *palette, int16_t w, int16_t h);
+  void drawPalettedBitmap(int16_t x, int16_t y, const GFXcanvas8 &canvas,
+                          const uint16_t *palette);
 
   void invertDisplay(bool i);
+  virtual bool setPixelFormat(uint8_t format);
+  /*!
+      @brief   Pixel format on the wire, see setPixelFormat().
+      @return  TFT_PIXEL_RGB565, TFT_PIXEL_RGB444 or TFT_PIXEL_RGB666.
+  */
+  uint8_t getPixelFormat(void) const { return pixelFormat; }
   uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
 
   // Despite parallel additions, function names kept for compatibility:
@@ -348,6 +455,9 @@ public:
       @brief  Set the data/command line LOW (command mode).
   */
   void SPI_DC_LOW(void) {
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+    dmaWait(); // Pixels of a non-blocking writePixels() may still be going
+#endif
 #if defined(USE_FAST_PINIO)
 #if defined(HAS_PORT_SET_CLR)
 #if defined(KINETISK)
@@ -410,6 +520,7 @@ protected:
     uint32_t _freq; ///< SPI bitrate (if no SPI transactions)
 #endif
       uint32_t _mode; ///< SPI data mode (transactions or no)
+      bool _dcx;      ///< If true, SPI peripheral drives DC (command streams)
     } hwspi;          ///< Hardware SPI values
     struct {          //   Values specific to SOFTWARE SPI:
 #if defined(USE_FAST_PINIO)
@@ -499,6 +610,22 @@ protected:
   uint32_t lastFillLen = 0;          ///< # of pixels w/last fill
   uint8_t onePixelBuf;               ///< For hi==lo fill
 #endif
+#if defined(__MBED__) && defined(NRF52840_XXAA)
+  SPIXfer pixelXfer = {}; ///< Transfer of a non-blocking writePixels()
+  SPIXfer fillXfer[2] = {};         ///< Repeated block + rest of writeColor()
+  uint8_t fillBuf[TFT_FILL_PIXELS * 3]; ///< Color block of writeColor()
+  uint8_t wireBuf[2][TFT_WIRE_PIXELS * 3]; ///< Packed pixels
+  SPIXfer wireXfer[2] = {};                ///< Transfers of wireBuf
+  volatile bool wireBusy[2] = {};          ///< wireBuf still going out
+  uint8_t wireIdx = 0;                     ///< wireBuf to pack next
+  bool wireCarry = false;    ///< A 12-bit pixel is held back, half a byte
+  uint16_t wireCarryColor;   ///< Its color, RGB565
+
+  void writeWire(const void *colors, uint8_t source, const uint16_t *palette,
+                 uint32_t len, bool block);
+  void writeWireCarry(void);
+#endif
+  uint8_t pixelFormat = TFT_PIXEL_RGB565; ///< Wire format, setPixelFormat()
 #if defined(USE_FAST_PINIO)
 #if defined(HAS_PORT_SET_CLR)
 #if !defined(KINETISK)
@@ -522,6 +649,38 @@ protected:
   uint8_t invertOnCommand = 0;  ///< Command to enable invert mode
   uint8_t invertOffCommand = 0; ///< Command to disable invert mode
 
+  uint16_t _winX0 = 0;     ///< First column last sent to the display
+  uint16_t _winX1 = 0;     ///< Last column last sent to the display
+  uint16_t _winY0 = 0;     ///< First row last sent to the display
+  uint16_t _winY1 = 0;     ///< Last row last sent to the display
+  uint16_t _winRow = 0;    ///< Row where the current memory write began
+  uint32_t _winPixels = 0; ///< Pixels written since then
+  uint8_t _winValid = 0;   ///< What the display is known to have
+  tftAddrWindowStats addrWindowStats = {}; ///< Address window counters
+
+  /*!
+      @brief  Tell the frame pacing how the panel refreshes, called by
+              subclasses on rotation.
+      @param  lines  Lines of one panel refresh, 0 if unknown.
+      @param  first  Scan line of row 0 if the scan runs down the rows in
+                     this rotation, else -1.
+  */
+  void setScanMapping(uint16_t lines, int16_t first) {
+    _scanLines = lines;
+    _scanFirst = first;
+  }
+  uint16_t _scanLines = 0;         ///< Lines of a panel refresh, 0 if unknown
+  int16_t _scanFirst = -1;         ///< Scan line of row 0, -1 if not rows
+  volatile uint32_t _teTime = 0;   ///< When the last TE pulse came
+  volatile uint32_t _tePeriod = 0; ///< Averaged TE period in microseconds
+  volatile uint32_t _teCount = 0;  ///< TE pulses seen
+  uint32_t _teFrame = 0;           ///< _teCount at the last beginFrame()
+  uint32_t _frameStart = 0;        ///< When the frame in progress began
+  uint32_t _chaseTe = 0;           ///< Refresh the frame's bands go behind
+  bool _inFrame = false;           ///< Between beginFrame() and endFrame()
+  bool _chaseFirst = true;         ///< No band of the frame sent yet
+  tftFrameStats frameStats = {};   ///< Frame pacing counters
+
   uint32_t _freq = 0; ///< Dummy var to keep subclasses happy
 };
 
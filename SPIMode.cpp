@@ -26,6 +26,8 @@
 #include "mbed.h"
 #include <assert.h>
 #include "SPIMode.h"
+#include "nrfx_ppi.h"
+#include <hal/nrf_timer.h>
 
 extern const uint32_t g_ADigitalPinMap[];
 
@@ -68,9 +70,23 @@ SPIClass::SPIClass(NRF_SPIM_Type *p_spi, uint8_t uc_pinMISO, uint8_t uc_pinSCK,
   _uc_pinMiso = g_ADigitalPinMap[uc_pinMISO];
   _uc_pinSCK = g_ADigitalPinMap[uc_pinSCK];
   _uc_pinMosi = g_ADigitalPinMap[uc_pinMOSI];
+  _uc_pinDCX = NRFX_SPIM_PIN_NOT_USED;
 
   _dataMode = SPI_MODE0;
   _bitOrder = NRF_SPIM_BIT_ORDER_MSB_FIRST;
+
+  _configured = false;
+  _cfgApplied = 0;
+  _cfgSkipped = 0;
+
+  _q_head = NULL;
+  _q_tail = NULL;
+  _q_pos = 0;
+  _q_len = 0;
+  _q_rep = 0;
+  _q_running = false;
+  _q_dcx = false;
+  _q_vector = 0;
 }
 
 void SPIClass::begin()
@@ -95,6 +111,7 @@ void SPIClass::begin()
 
   _dataMode = SPI_MODE0;
   _bitOrder = NRF_SPIM_BIT_ORDER_MSB_FIRST;
+  _configured = false;
 
   // blocking
   nrfx_spim_init(&_spim, &cfg, NULL, NULL);
@@ -117,8 +134,10 @@ void SPIClass::begin()
 
 void SPIClass::end()
 {
+  waitQueue();
   nrfx_spim_uninit(&_spim);
   initialized = false;
+  _configured = false;
 }
 
 void SPIClass::usingInterrupt(int /*interruptNumber*/)
@@ -127,6 +146,16 @@ void SPIClass::usingInterrupt(int /*interruptNumber*/)
 
 void SPIClass::beginTransaction(SPISettings settings)
 {
+  waitQueue();
+
+  // Same settings as the last transaction: mode, bit order and frequency
+  // registers are unchanged, only turn the SPIM back on
+  if (_configured && settings == _settings) {
+    _cfgSkipped++;
+    nrf_spim_enable(_spim.p_reg);
+    return;
+  }
+
   nrf_spim_disable(_spim.p_reg);
 
   this->_dataMode = settings.dataMode;
@@ -136,11 +165,16 @@ void SPIClass::beginTransaction(SPISettings settings)
 
   setClockDivider(64000000 / settings.clockFreq);
 
+  _settings = settings;
+  _configured = true;
+  _cfgApplied++;
+
   nrf_spim_enable(_spim.p_reg);
 }
 
 void SPIClass::endTransaction(void)
 {
+  waitQueue();
   nrf_spim_disable(_spim.p_reg);
 }
 
@@ -154,12 +188,14 @@ void SPIClass::setPins(uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI
 void SPIClass::setBitOrder(BitOrder order)
 {
   this->_bitOrder = (order == MSBFIRST ? NRF_SPIM_BIT_ORDER_MSB_FIRST : NRF_SPIM_BIT_ORDER_LSB_FIRST);
+  _configured = false;
   nrf_spim_configure(_spim.p_reg, (nrf_spim_mode_t) _dataMode, (nrf_spim_bit_order_t) _bitOrder);
 }
 
 void SPIClass::setDataMode(uint8_t mode)
 {
   this->_dataMode = mode;
+  _configured = false;
   nrf_spim_configure(_spim.p_reg, (nrf_spim_mode_t) _dataMode, (nrf_spim_bit_order_t) _bitOrder);
 }
 
@@ -196,6 +232,7 @@ void SPIClass::setClockDivider(uint32_t div)
     }
   }
 
+  _configured = false;
   nrf_spim_frequency_set(_spim.p_reg, clockFreq);
 }
 
@@ -210,6 +247,8 @@ void SPIClass::transfer(const void *tx_buf, void *rx_buf, size_t count)
   const uint8_t* tx_buf8 = (const uint8_t*) tx_buf;
   uint8_t* rx_buf8 = (uint8_t*) rx_buf;
 
+  waitQueue();
+
   while (count)
   {
     // each transfer can only up to 64KB (16-bit) bytes
@@ -232,6 +271,354 @@ core_util_critical_section_exit();
   }
 }
 
+// Let the SPIM drive the data/command line of a display (see transferCommands).
+// Only SPIM3 has the DCX feature, returns false if it's not available.
+bool SPIClass::setDCXPin(uint8_t uc_pinDCX)
+{
+#if defined(NRF_SPIM_DCX_PRESENT)
+  if ( _spim.p_reg != NRF_SPIM3 ) return false;
+
+  _uc_pinDCX = g_ADigitalPinMap[uc_pinDCX];
+  return true;
+#else
+  (void) uc_pinDCX;
+  return false;
+#endif
+}
+
+// Send a stream of display commands, each record is
+//   [number of data bytes] [command] [data bytes...]
+// The command byte and its data go out in one EasyDMA transfer with DCXCNT = 1,
+// so the SPIM switches the DC line itself and no GPIO toggling is needed.
+// The stream must be in RAM. Must be called inside a transaction and after a
+// successful setDCXPin().
+void SPIClass::transferCommands(const uint8_t *stream, size_t count)
+{
+#if defined(NRF_SPIM_DCX_PRESENT)
+  NRF_SPIM_Type *p_reg = _spim.p_reg;
+
+  waitQueue();
+core_util_critical_section_enter();
+  // PSEL registers must only be written while the SPIM is disabled
+  nrf_spim_disable(p_reg);
+  nrf_spim_dcx_pin_set(p_reg, _uc_pinDCX);
+  nrf_spim_enable(p_reg);
+
+  nrf_spim_rx_buffer_set(p_reg, NULL, 0);
+  nrf_spim_dcx_cnt_set(p_reg, 1);
+
+  while (count >= 2)
+  {
+    size_t const xfer_len = _min((size_t) stream[0] + 1, count - 1);
+
+    nrf_spim_tx_buffer_set(p_reg, stream + 1, xfer_len);
+    nrf_spim_event_clear(p_reg, NRF_SPIM_EVENT_END);
+    nrf_spim_task_trigger(p_reg, NRF_SPIM_TASK_START);
+    while ( !nrf_spim_event_check(p_reg, NRF_SPIM_EVENT_END) ) {}
+
+    stream += 1 + xfer_len;
+    count -= 1 + xfer_len;
+  }
+
+  // give the DC line back to GPIO, it keeps driving its last (data) level
+  nrf_spim_dcx_cnt_set(p_reg, 0);
+  nrf_spim_disable(p_reg);
+  nrf_spim_dcx_pin_set(p_reg, NRF_SPIM_PIN_NOT_CONNECTED);
+  nrf_spim_enable(p_reg);
+core_util_critical_section_exit();
+#else
+  (void) stream;
+  (void) count;
+#endif
+}
+
+// Queue a transfer and return without waiting for it. Transfers go out in
+// order, each one started from the SPIM end interrupt of the previous one,
+// and the callback of a transfer is called from that interrupt. xfer must
+// stay valid (and tx_buf untouched) until the callback or waitQueue().
+// Blocking transfers and the transaction functions wait for the queue
+// first. Must be called inside a transaction.
+bool SPIClass::queue(SPIXfer *xfer)
+{
+  if ( !xfer || !xfer->tx_buf || !xfer->count ) return false;
+  // SPIM0 & SPIM1 share their interrupt with TWI0 & TWI1
+  if ( _spim.p_reg != NRF_SPIM2 && _spim.p_reg != NRF_SPIM3 ) return false;
+#if defined(NRF_SPIM_DCX_PRESENT)
+  if ( xfer->cmd_count && _uc_pinDCX == NRFX_SPIM_PIN_NOT_USED ) return false;
+#else
+  if ( xfer->cmd_count ) return false;
+#endif
+
+  xfer->next = NULL;
+
+core_util_critical_section_enter();
+  if ( _q_head ) {
+    _q_tail->next = xfer;
+  } else {
+    _q_head = xfer;
+  }
+  _q_tail = xfer;
+
+  // else the end interrupt picks it up
+  if ( !_q_running ) {
+    _q_running = true;
+    queueBegin();
+    queueNext();
+  }
+core_util_critical_section_exit();
+
+  return true;
+}
+
+void SPIClass::waitQueue(void)
+{
+  while ( _q_running ) {}
+}
+
+SPIClass *SPIClass::_q_owner[2];
+
+void SPIClass::_q_irq_spim2(void)
+{
+  if ( _q_owner[0] ) _q_owner[0]->queueIrq();
+}
+
+void SPIClass::_q_irq_spim3(void)
+{
+  if ( _q_owner[1] ) _q_owner[1]->queueIrq();
+}
+
+// Take over the SPIM interrupt, blocking transfers don't use it.
+// queueEnd() puts the previous handler back.
+void SPIClass::queueBegin(void)
+{
+  NRF_SPIM_Type *p_reg = _spim.p_reg;
+  IRQn_Type irq = nrfx_get_irq_number(p_reg);
+
+  _q_vector = NVIC_GetVector(irq);
+  if ( p_reg == NRF_SPIM3 ) {
+    _q_owner[1] = this;
+    NVIC_SetVector(irq, (uint32_t) _q_irq_spim3);
+  } else {
+    _q_owner[0] = this;
+    NVIC_SetVector(irq, (uint32_t) _q_irq_spim2);
+  }
+
+  _q_pos = 0;
+  _q_rep = 0;
+
+  nrf_spim_rx_buffer_set(p_reg, NULL, 0);
+  nrf_spim_event_clear(p_reg, NRF_SPIM_EVENT_END);
+  nrf_spim_int_enable(p_reg, NRF_SPIM_INT_END_MASK);
+  NVIC_SetPriority(irq, 3);
+  NVIC_ClearPendingIRQ(irq);
+  NVIC_EnableIRQ(irq);
+}
+
+// Start the next chunk of _q_head
+void SPIClass::queueNext(void)
+{
+  NRF_SPIM_Type *p_reg = _spim.p_reg;
+  SPIXfer *xfer = _q_head;
+
+#if defined(NRF_SPIM_DCX_PRESENT)
+  uint32_t dcx_cnt = (_q_pos == 0 && _q_rep == 0) ? xfer->cmd_count : 0;
+  if ( dcx_cnt && !_q_dcx ) {
+    // PSEL registers must only be written while the SPIM is disabled
+    nrf_spim_disable(p_reg);
+    nrf_spim_dcx_pin_set(p_reg, _uc_pinDCX);
+    nrf_spim_enable(p_reg);
+    _q_dcx = true;
+  }
+  if ( _q_dcx ) nrf_spim_dcx_cnt_set(p_reg, dcx_cnt);
+#endif
+
+  // each transfer can only up to 64KB (16-bit) bytes
+  _q_len = _min(xfer->count - _q_pos, (size_t) UINT16_MAX);
+
+  // A repeated buffer that fits one transfer is restarted by hardware,
+  // only the last repeat interrupts. Without the TIMER every repeat does.
+  if ( xfer->repeat > 1 && _q_rep == 0 && !xfer->cmd_count && _q_len == xfer->count ) {
+    repeatBegin(xfer->repeat);
+  }
+
+  nrf_spim_tx_buffer_set(p_reg, (const uint8_t *) xfer->tx_buf + _q_pos, _q_len);
+  nrf_spim_task_trigger(p_reg, NRF_SPIM_TASK_START);
+}
+
+// Queue is empty, give the interrupt (and the DCX pin) back
+void SPIClass::queueEnd(void)
+{
+  NRF_SPIM_Type *p_reg = _spim.p_reg;
+  IRQn_Type irq = nrfx_get_irq_number(p_reg);
+
+  nrf_spim_int_disable(p_reg, NRF_SPIM_INT_END_MASK);
+  NVIC_DisableIRQ(irq);
+  NVIC_SetVector(irq, _q_vector);
+
+#if defined(NRF_SPIM_DCX_PRESENT)
+  if ( _q_dcx ) {
+    nrf_spim_dcx_cnt_set(p_reg, 0);
+    nrf_spim_disable(p_reg);
+    nrf_spim_dcx_pin_set(p_reg, NRF_SPIM_PIN_NOT_CONNECTED);
+    nrf_spim_enable(p_reg);
+    _q_dcx = false;
+  }
+#endif
+
+  _q_tail = NULL;
+  _q_running = false;
+}
+
+void SPIClass::queueIrq(void)
+{
+  NRF_SPIM_Type *p_reg = _spim.p_reg;
+
+  if ( !nrf_spim_event_check(p_reg, NRF_SPIM_EVENT_END) ) return;
+  nrf_spim_event_clear(p_reg, NRF_SPIM_EVENT_END);
+
+  queueAdvance();
+}
+
+// The chunk in progress is out, start the next one
+void SPIClass::queueAdvance(void)
+{
+  SPIXfer *xfer = _q_head;
+  if ( !xfer ) return;
+
+  _q_pos += _q_len;
+  if ( _q_pos >= xfer->count ) {
+    _q_pos = 0;
+    _q_rep++;
+  }
+
+  if ( _q_pos == 0 && _q_rep >= (xfer->repeat ? xfer->repeat : 1) ) {
+    // done, the callback may queue more transfers
+    _q_head = xfer->next;
+    _q_rep = 0;
+    if ( xfer->callback ) xfer->callback(xfer->context);
+  }
+
+  if ( _q_head ) {
+    queueNext();
+  } else {
+    queueEnd();
+  }
+}
+
+// PPI channels: END -> START (in the group), END -> COUNT and
+// COMPARE0 -> group disable
+static nrf_ppi_channel_t _rep_ch[3];
+static nrf_ppi_channel_group_t _rep_group;
+static int8_t _rep_alloc;  // 0: not yet, 1: allocated, -1: none left
+
+SPIClass *SPIClass::_rep_owner;
+static uint32_t _rep_vector;  // handler of the TIMER before repeatBegin()
+
+static bool repeatAlloc(void)
+{
+  if ( _rep_alloc ) return _rep_alloc > 0;
+
+  _rep_alloc = -1;
+  for (int i = 0; i < 3; i++) {
+    if ( nrfx_ppi_channel_alloc(&_rep_ch[i]) != NRFX_SUCCESS ) {
+      while ( i-- ) nrfx_ppi_channel_free(_rep_ch[i]);
+      return false;
+    }
+  }
+  if ( nrfx_ppi_group_alloc(&_rep_group) != NRFX_SUCCESS ) {
+    for (int i = 0; i < 3; i++) nrfx_ppi_channel_free(_rep_ch[i]);
+    return false;
+  }
+  nrf_ppi_channel_include_in_group(_rep_ch[0], _rep_group);
+
+  _rep_alloc = 1;
+  return true;
+}
+
+// Let the SPIM send the next transfer repeat times on its own: every END
+// starts it again and is counted by the TIMER. The count before the last
+// one stops the restarts, the last one interrupts.
+bool SPIClass::repeatBegin(uint32_t repeat)
+{
+  NRF_SPIM_Type *p_reg = _spim.p_reg;
+  NRF_TIMER_Type *timer = SPI_REPEAT_TIMER;
+
+  // the other SPIM has it
+  if ( _rep_owner || !repeatAlloc() ) return false;
+  _rep_owner = this;
+
+  nrf_timer_task_trigger(timer, NRF_TIMER_TASK_STOP);
+  nrf_timer_mode_set(timer, NRF_TIMER_MODE_COUNTER);
+  nrf_timer_bit_width_set(timer, NRF_TIMER_BIT_WIDTH_32);
+  nrf_timer_task_trigger(timer, NRF_TIMER_TASK_CLEAR);
+  nrf_timer_cc_write(timer, NRF_TIMER_CC_CHANNEL0, repeat - 1);
+  nrf_timer_cc_write(timer, NRF_TIMER_CC_CHANNEL1, repeat);
+  nrf_timer_event_clear(timer, NRF_TIMER_EVENT_COMPARE0);
+  nrf_timer_event_clear(timer, NRF_TIMER_EVENT_COMPARE1);
+  nrf_timer_int_enable(timer, NRF_TIMER_INT_COMPARE1_MASK);
+
+  _rep_vector = NVIC_GetVector(SPI_REPEAT_TIMER_IRQn);
+  NVIC_SetVector(SPI_REPEAT_TIMER_IRQn, (uint32_t) _rep_irq);
+  NVIC_SetPriority(SPI_REPEAT_TIMER_IRQn, 3);
+  NVIC_ClearPendingIRQ(SPI_REPEAT_TIMER_IRQn);
+  NVIC_EnableIRQ(SPI_REPEAT_TIMER_IRQn);
+  nrf_timer_task_trigger(timer, NRF_TIMER_TASK_START);
+
+  uint32_t end_evt = nrf_spim_event_address_get(p_reg, NRF_SPIM_EVENT_END);
+  nrf_ppi_channel_endpoint_setup(_rep_ch[0], end_evt,
+                                 nrf_spim_task_address_get(p_reg, NRF_SPIM_TASK_START));
+  nrf_ppi_channel_endpoint_setup(_rep_ch[1], end_evt,
+                                 nrf_timer_task_address_get(timer, NRF_TIMER_TASK_COUNT));
+  nrf_ppi_channel_endpoint_setup(_rep_ch[2],
+                                 nrf_timer_event_address_get(timer, NRF_TIMER_EVENT_COMPARE0),
+                                 nrf_ppi_task_group_disable_address_get(_rep_group));
+  nrf_ppi_group_enable(_rep_group);
+  nrf_ppi_channel_enable(_rep_ch[1]);
+  nrf_ppi_channel_enable(_rep_ch[2]);
+
+  // the TIMER interrupts instead
+  nrf_spim_int_disable(p_reg, NRF_SPIM_INT_END_MASK);
+
+  return true;
+}
+
+// The last repeat is out, give the TIMER back and the END interrupt to the
+// queue again
+void SPIClass::repeatEnd(void)
+{
+  NRF_SPIM_Type *p_reg = _spim.p_reg;
+  NRF_TIMER_Type *timer = SPI_REPEAT_TIMER;
+
+  nrf_ppi_group_disable(_rep_group);
+  nrf_ppi_channel_disable(_rep_ch[1]);
+  nrf_ppi_channel_disable(_rep_ch[2]);
+
+  nrf_timer_task_trigger(timer, NRF_TIMER_TASK_STOP);
+  nrf_timer_int_disable(timer, NRF_TIMER_INT_COMPARE1_MASK);
+  nrf_timer_event_clear(timer, NRF_TIMER_EVENT_COMPARE0);
+  nrf_timer_event_clear(timer, NRF_TIMER_EVENT_COMPARE1);
+  NVIC_DisableIRQ(SPI_REPEAT_TIMER_IRQn);
+  NVIC_SetVector(SPI_REPEAT_TIMER_IRQn, _rep_vector);
+
+  nrf_spim_event_clear(p_reg, NRF_SPIM_EVENT_END);
+  nrf_spim_int_enable(p_reg, NRF_SPIM_INT_END_MASK);
+
+  _rep_owner = NULL;
+}
+
+void SPIClass::_rep_irq(void)
+{
+  SPIClass *spi = _rep_owner;
+
+  if ( !spi || !nrf_timer_event_check(SPI_REPEAT_TIMER, NRF_TIMER_EVENT_COMPARE1) ) return;
+
+  spi->repeatEnd();
+
+  // carry on as if the SPIM had interrupted after each repeat
+  spi->_q_rep = spi->_q_head->repeat - 1;
+  spi->queueAdvance();
+}
+
 void SPIClass::transfer(void *buf, size_t count)
 {
   transfer(buf, buf, count);
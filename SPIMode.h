@@ -53,6 +53,12 @@ class SPISettings {
       this->dataMode = SPI_MODE0;
     }
 
+    bool operator==(const SPISettings &rhs) const {
+      return (clockFreq == rhs.clockFreq) && (bitOrder == rhs.bitOrder) &&
+             (dataMode == rhs.dataMode);
+    }
+    bool operator!=(const SPISettings &rhs) const { return !(*this == rhs); }
+
   private:
     uint32_t clockFreq;
     uint8_t  dataMode;
@@ -61,6 +67,26 @@ class SPISettings {
     friend class SPIClass;
 };
 
+// Repeated transfers of the queue are restarted by the SPIM END event
+// through PPI, a TIMER in counter mode stops them after the last repeat
+#ifndef SPI_REPEAT_TIMER
+#define SPI_REPEAT_TIMER      NRF_TIMER4
+#define SPI_REPEAT_TIMER_IRQn TIMER4_IRQn
+#endif
+
+// Asynchronous transfers, see SPIClass::queue()
+typedef void (*SPIXferCallback)(void *context);
+
+struct SPIXfer {
+  const void *tx_buf;       // bytes to send, must be in RAM (EasyDMA)
+  size_t count;             // number of bytes in tx_buf
+  uint32_t repeat;          // send tx_buf this many times (0 or 1: once)
+  uint8_t cmd_count;        // leading bytes sent as command, needs setDCXPin()
+  SPIXferCallback callback; // called from the SPIM interrupt when done, or NULL
+  void *context;            // passed to callback
+  SPIXfer *next;            // used by the queue
+};
+
 class SPIClass {
   public:
     SPIClass(NRF_SPIM_Type *p_spi, uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI);
@@ -70,11 +96,27 @@ class SPIClass {
     void transfer(void *buf, size_t count);
     void transfer(const void *tx_buf, void *rx_buf, size_t count);
 
+    // Command streams with hardware data/command line (SPIM3 only)
+    bool setDCXPin(uint8_t uc_pinDCX);
+    void transferCommands(const uint8_t *stream, size_t count);
+
+    // Asynchronous transfers, chained from the SPIM end interrupt (SPIM2 &
+    // SPIM3 only, queue() returns false on the others)
+    bool queue(SPIXfer *xfer);
+    bool queueBusy(void) const { return _q_running; }
+    void waitQueue(void);
+
     // Transaction Functions
     void usingInterrupt(int interruptNumber);
     void beginTransaction(SPISettings settings);
     void endTransaction(void);
 
+    // Transactions that had to reprogram the SPIM vs. ones that reused the
+    // configuration of the previous transaction
+    uint32_t configApplied(void) const { return _cfgApplied; }
+    uint32_t configSkipped(void) const { return _cfgSkipped; }
+    void resetConfigStats(void) { _cfgApplied = _cfgSkipped = 0; }
+
     // SPI Configuration methods
     void attachInterrupt();
     void detachInterrupt();
@@ -94,10 +136,41 @@ class SPIClass {
     uint8_t _uc_pinMiso;
     uint8_t _uc_pinMosi;
     uint8_t _uc_pinSCK;
+    uint8_t _uc_pinDCX;
 
     uint8_t _dataMode;
     uint8_t _bitOrder;
 
+    SPISettings _settings;  // of the last transaction
+    bool _configured;       // SPIM is still set up for _settings
+    uint32_t _cfgApplied;
+    uint32_t _cfgSkipped;
+
+    SPIXfer *volatile _q_head;  // transfer in progress, then the waiting ones
+    SPIXfer *_q_tail;
+    size_t _q_pos;              // bytes of the current repeat already sent
+    size_t _q_len;              // bytes of the chunk in progress
+    uint32_t _q_rep;            // repeats of _q_head already sent
+    volatile bool _q_running;
+    bool _q_dcx;                // DCX pin is connected for the queue
+    uint32_t _q_vector;         // SPIM interrupt handler before queueBegin()
+
+    void queueBegin(void);
+    void queueNext(void);
+    void queueEnd(void);
+    void queueIrq(void);
+    void queueAdvance(void);
+
+    bool repeatBegin(uint32_t repeat);
+    void repeatEnd(void);
+
+    static SPIClass *_q_owner[2];  // SPIM2, SPIM3
+    static void _q_irq_spim2(void);
+    static void _q_irq_spim3(void);
+
+    static SPIClass *_rep_owner;   // queue using SPI_REPEAT_TIMER
+    static void _rep_irq(void);
+
     bool initialized;
 };
 
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+#
+# Convert images to run-length encoded LVGL images (`LV_IMG_CF_RLE_...`)
+#
+# Inputs:
+#   - XBM headers like the ones in `Adafruit_gfx_mbed/Pictures` -> LV_IMG_CF_RLE_ALPHA
+#     (the set bits are opaque, the color comes from the image's recolor style)
+#   - PNG, BMP, etc. if Pillow is installed -> LV_IMG_CF_RLE_TRUE_COLOR(_ALPHA)
+#
+# Usage:
+#   img_conv_rle.py schedule_event_add_40.h -o schedule_event_add_40_rle.c
+#   img_conv_rle.py logo.png --depth 16 --alpha -o logo.c
+#
+# The encoding is described in `lv_img_buf.h` next to `LV_IMG_RLE_REPEAT`.
+
+import argparse
+import os
+import re
+import sys
+
+RLE_REPEAT = 0x80
+RLE_MAX_CNT = 128
+
+CF_RLE_TRUE_COLOR = 'LV_IMG_CF_RLE_TRUE_COLOR'
+CF_RLE_TRUE_COLOR_ALPHA = 'LV_IMG_CF_RLE_TRUE_COLOR_ALPHA'
+CF_RLE_ALPHA = 'LV_IMG_CF_RLE_ALPHA'
+
+
+def read_xbm(path):
+    """Return (name, width, height, rows of alpha values) of an XBM header"""
+    with open(path) as f:
+        text = f.read()
+
+    w = re.search(r'#define\s+(\w+)_width\s+(\d+)', text)
+    h = re.search(r'#define\s+\w+_height\s+(\d+)', text)
+    bits = re.search(r'_bits\s*\[\s*\]\s*=\s*\{([^}]*)\}', text)
+    if not w or not h or not bits:
+        sys.exit('%s: not an XBM header' % path)
+
+    name = w.group(1)
+    width = int(w.group(2))
+    height = int(h.group(1))
+    data = [int(v, 16) for v in re.findall(r'0x[0-9a-fA-F]+', bits.group(1))]
+
+    stride = (width + 7) // 8
+    if len(data) < stride * height:
+        sys.exit('%s: too few bytes' % path)
+
+    rows = []
+    for y in range(height):
+        row = []
+        for x in range(width):
+            byte = data[y * stride + x // 8]
+            row.append(255 if byte & (1 << (x % 8)) else 0)   # XBM is LSB first
+        rows.append(row)
+
+    return name, width, height, rows
+
+
+def read_image(path):
+    """Return (name, width, height, rows of (r, g, b, a) tuples) of an image using Pillow"""
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit('Pillow is required to convert %s' % path)
+
+    img = Image.open(path).convert('RGBA')
+    width, height = img.size
+    px = list(img.getdata())
+    rows = [px[y * width:(y + 1) * width] for y in range(height)]
+    name = re.sub(r'\W', '_', os.path.splitext(os.path.basename(path))[0])
+    return name, width, height, rows
+
+
+def color_bytes(r, g, b, depth, swap):
+    """The bytes of an `lv_color_t` in memory (little endian)"""
+    if depth == 32:
+        return [b, g, r, 0xFF]
+    if depth == 16:
+        c = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+        if swap:
+            return [c >> 8, c & 0xFF]
+        return [c & 0xFF, c >> 8]
+    if depth == 8:
+        return [(r & 0xE0) | ((g >> 3) & 0x1C) | (b >> 6)]
+    if depth == 1:
+        return [1 if (r + g + b) > 3 * 127 else 0]
+    sys.exit('Invalid color depth: %d' % depth)
+
+
+def encode_line(pixels):
+    """Encode a line of pixels (tuples of bytes) to packets"""
+    out = []
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:RLE_MAX_CNT]
+            del literal[:RLE_MAX_CNT]
+            out.append(len(chunk) - 1)
+            for p in chunk:
+                out.extend(p)
+
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and run < RLE_MAX_CNT and pixels[i + run] == pixels[i]:
+            run += 1
+
+        # A run of 2 costs the same as 2 literal pixels if a literal packet is already open
+        if run >= 3 or (run == 2 and not literal):
+            flush_literal()
+            out.append(RLE_REPEAT | (run - 1))
+            out.extend(pixels[i])
+        else:
+            literal.extend(pixels[i:i + run])
+        i += run
+
+    flush_literal()
+    return out
+
+
+def encode(rows):
+    """Encode the lines and put the table of line offsets before them"""
+    lines = [encode_line(row) for row in rows]
+    ofs = 4 * len(lines)
+    data = []
+    for line in lines:
+        data.extend([ofs & 0xFF, (ofs >> 8) & 0xFF, (ofs >> 16) & 0xFF, (ofs >> 24) & 0xFF])
+        ofs += len(line)
+    for line in lines:
+        data.extend(line)
+    return data
+
+
+def to_c(name, width, height, cf, data, raw_size):
+    out = []
+    out.append('#if defined(LV_LVGL_H_INCLUDE_SIMPLE)')
+    out.append('#include "lvgl.h"')
+    out.append('#else')
+    out.append('#include "lvgl/lvgl.h"')
+    out.append('#endif')
+    out.append('')
+    out.append('#ifndef LV_ATTRIBUTE_MEM_ALIGN')
+    out.append('#define LV_ATTRIBUTE_MEM_ALIGN')
+    out.append('#endif')
+    out.append('')
+    out.append('/*%d bytes run-length encoded, %d bytes not encoded*/' % (len(data), raw_size))
+    out.append('const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST uint8_t %s_map[] = {' % name)
+    for i in range(0, len(data), 16):
+        out.append('  ' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+    out.append('};')
+    out.append('')
+    out.append('const lv_img_dsc_t %s = {' % name)
+    out.append('  .header.always_zero = 0,')
+    out.append('  .header.w = %d,' % width)
+    out.append('  .header.h = %d,' % height)
+    out.append('  .data_size = %d,' % len(data))
+    out.append('  .header.cf = %s,' % cf)
+    out.append('  .data = %s_map,' % name)
+    out.append('};')
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert images to run-length encoded LVGL images')
+    parser.add_argument('input', help='XBM header (.h/.xbm) or an image file readable by Pillow')
+    parser.add_argument('-o', '--output', help='output C file (default: stdout)')
+    parser.add_argument('-n', '--name', help='name of the image variable (default: from the input)')
+    parser.add_argument('--depth', type=int, default=16, choices=[1, 8, 16, 32], help='LV_COLOR_DEPTH')
+    parser.add_argument('--swap', action='store_true', help='LV_COLOR_16_SWAP')
+    parser.add_argument('--alpha', action='store_true', help='keep the alpha channel of true color images')
+    args = parser.parse_args()
+
+    ext = os.path.splitext(args.input)[1].lower()
+    if ext in ('.h', '.xbm'):
+        name, width, height, rows = read_xbm(args.input)
+        cf = CF_RLE_ALPHA
+        rows = [[(a,) for a in row] for row in rows]
+        raw_size = width * height
+    else:
+        name, width, height, rgba = read_image(args.input)
+        cf = CF_RLE_TRUE_COLOR_ALPHA if args.alpha else CF_RLE_TRUE_COLOR
+        rows = []
+        for row in rgba:
+            line = []
+            for r, g, b, a in row:
+                px = color_bytes(r, g, b, args.depth, args.swap)
+                if args.alpha:
+                    px.append(a)
+                line.append(tuple(px))
+            rows.append(line)
+        raw_size = width * height * len(rows[0][0]) if rows and rows[0] else 0
+
+    if args.name:
+        name = args.name
+
+    data = encode(rows)
+    text = to_c(name, width, height, cf, data, raw_size)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+    sys.stderr.write('%s: %dx%d %s, %d bytes (%d not encoded)\n' % (name, width, height, cf, len(data), raw_size))
+
+
+if __name__ == '__main__':
+    main()
@@ -613,6 +613,38 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Memory budget of the image cache in bytes.
+ * The least recently used images are closed to keep the estimated memory of the opened images below it.
+ * Set it to 0 to limit the cache only by LV_IMG_CACHE_DEF_SIZE */
+#ifndef LV_IMG_CACHE_DEF_BUDGET
+#  ifdef CONFIG_LV_IMG_CACHE_DEF_BUDGET
+#    define LV_IMG_CACHE_DEF_BUDGET CONFIG_LV_IMG_CACHE_DEF_BUDGET
+#  else
+#    define  LV_IMG_CACHE_DEF_BUDGET     0
+#  endif
+#endif
+
+/* Read-ahead cache of the built-in decoder for images opened from files (in bytes).
+ * Files are read in LV_IMG_FS_BLOCK_SIZE aligned chunks of this size instead of
+ * seeking and reading for every line. Enlarged to hold at least one line of the image.
+ * Set it to 0 to read the files line by line */
+#ifndef LV_IMG_FS_CACHE_SIZE
+#  ifdef CONFIG_LV_IMG_FS_CACHE_SIZE
+#    define LV_IMG_FS_CACHE_SIZE CONFIG_LV_IMG_FS_CACHE_SIZE
+#  else
+#    define  LV_IMG_FS_CACHE_SIZE        2048
+#  endif
+#endif
+
+/* Alignment of the reads of the file cache. Use the block size of the file system (> 0)*/
+#ifndef LV_IMG_FS_BLOCK_SIZE
+#  ifdef CONFIG_LV_IMG_FS_BLOCK_SIZE
+#    define LV_IMG_FS_BLOCK_SIZE CONFIG_LV_IMG_FS_BLOCK_SIZE
+#  else
+#    define  LV_IMG_FS_BLOCK_SIZE        512
+#  endif
+#endif
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 
 /*=====================
@@ -1115,6 +1147,51 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Size of the glyph bitmap cache in bytes (0: disable).
+ * The decompressed glyphs of `lv_font_fmt_txt` fonts are stored with 8 bit per pixel
+ * and the least recently used glyphs are dropped when the cache is full.
+ * Saves the decompression and bit unpacking of the glyphs drawn frequently.*/
+#ifndef LV_FONT_GLYPH_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#    define LV_FONT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#  else
+#    define  LV_FONT_GLYPH_CACHE_SIZE    0
+#  endif
+#endif
+
+/* Number of entries in the codepoint -> glyph id cache of `lv_font_fmt_txt` fonts.
+ * Has to be a power of 2 (0: disable, only the last letter is cached).*/
+#ifndef LV_FONT_FMT_TXT_GID_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_FMT_TXT_GID_CACHE_SIZE
+#    define LV_FONT_FMT_TXT_GID_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_GID_CACHE_SIZE
+#  else
+#    define  LV_FONT_FMT_TXT_GID_CACHE_SIZE  0
+#  endif
+#endif
+
+/* 1: Build a two-level lookup table lazily for the Basic Multilingual Plane (U+0000..U+FFFF)
+ * to find the glyph id of a codepoint without searching the cmaps.
+ * Requires (4 * 256) bytes per used font + (2 * 256) bytes per used 256 codepoint page.*/
+#ifndef LV_FONT_FMT_TXT_CMAP_PAGES
+#  ifdef CONFIG_LV_FONT_FMT_TXT_CMAP_PAGES
+#    define LV_FONT_FMT_TXT_CMAP_PAGES CONFIG_LV_FONT_FMT_TXT_CMAP_PAGES
+#  else
+#    define  LV_FONT_FMT_TXT_CMAP_PAGES      0
+#  endif
+#endif
+
+/* 1: Build a hash table lazily from the kerning pairs of `lv_font_fmt_txt` fonts
+ * to find a pair's kerning value without binary search.
+ * Requires about (5 * 4 / 3 * pair count) bytes per font with kerning pairs.
+ * Fonts with class based kerning are not affected.*/
+#ifndef LV_FONT_FMT_TXT_KERN_HASH
+#  ifdef CONFIG_LV_FONT_FMT_TXT_KERN_HASH
+#    define LV_FONT_FMT_TXT_KERN_HASH CONFIG_LV_FONT_FMT_TXT_KERN_HASH
+#  else
+#    define  LV_FONT_FMT_TXT_KERN_HASH       0
+#  endif
+#endif
+
 /* Enable subpixel rendering */
 #ifndef LV_USE_FONT_SUBPX
 #  ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1677,6 +1754,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_LABEL_LONG_TXT_HINT          0
 #  endif
 #endif
+
+/*Cache the start and width of the lines of labels with texts longer than this (in bytes).
+ * Speeds up drawing and cursor positioning in long texts. 0: disable*/
+#ifndef LV_LABEL_LINE_CACHE
+#  ifdef CONFIG_LV_LABEL_LINE_CACHE
+#    define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+#  else
+#    define  LV_LABEL_LINE_CACHE             256
+#  endif
+#endif
 #endif
 
 /*LED (dependencies: -)*/
@@ -1843,7 +1930,8 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
-/*Number of extra "pages" when the roller is infinite*/
+/*Number of "pages" an infinite roller can be scrolled over before it wraps around.
+ * The options are stored and laid out only once.*/
 #ifndef LV_ROLLER_INF_PAGES
 #  ifdef CONFIG_LV_ROLLER_INF_PAGES
 #    define LV_ROLLER_INF_PAGES CONFIG_LV_ROLLER_INF_PAGES
@@ -23,6 +23,10 @@
     #include "../lv_widgets/lv_label.h"
 #endif
 
+#if LV_USE_CANVAS
+    #include "../lv_widgets/lv_canvas.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -84,6 +88,10 @@ void lv_refr_now(lv_disp_t * disp)
     lv_anim_refr_now();
 #endif
 
+#if LV_USE_CANVAS
+    lv_canvas_inv_now();
+#endif
+
     if(disp) {
         _lv_disp_refr_task(disp->refr_task);
     }
@@ -378,29 +386,46 @@ static void lv_refr_areas(void)
 
     if(disp_refr->inv_p == 0) return;
 
-    /*Find the last area which will be drawn*/
+    /*Collect the unjoined areas in the order they will be drawn*/
+    uint16_t order[LV_INV_BUF_SIZE];
+    uint16_t cnt = 0;
     int32_t i;
-    int32_t last_i = 0;
-    for(i = disp_refr->inv_p - 1; i >= 0; i--) {
-        if(disp_refr->inv_area_joined[i] == 0) {
-            last_i = i;
-            break;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i] == 0) order[cnt++] = i;
+    }
+
+    if(disp_refr->driver.refr_order_cb && cnt > 1) {
+        /*Stable insertion sort by the keys of the driver, there are only a few areas*/
+        uint32_t key[LV_INV_BUF_SIZE];
+        uint16_t j;
+        for(j = 0; j < cnt; j++) {
+            key[j] = disp_refr->driver.refr_order_cb(&disp_refr->driver, &disp_refr->inv_areas[order[j]]);
+        }
+        for(j = 1; j < cnt; j++) {
+            uint32_t k = key[j];
+            uint16_t o = order[j];
+            uint16_t m = j;
+            while(m > 0 && key[m - 1] > k) {
+                key[m] = key[m - 1];
+                order[m] = order[m - 1];
+                m--;
+            }
+            key[m] = k;
+            order[m] = o;
         }
     }
 
     disp_refr->driver.buffer->last_area = 0;
     disp_refr->driver.buffer->last_part = 0;
 
-    for(i = 0; i < disp_refr->inv_p; i++) {
-        /*Refresh the unjoined areas*/
-        if(disp_refr->inv_area_joined[i] == 0) {
+    for(i = 0; i < cnt; i++) {
+        lv_area_t * area_p = &disp_refr->inv_areas[order[i]];
 
-            if(i == last_i) disp_refr->driver.buffer->last_area = 1;
-            disp_refr->driver.buffer->last_part = 0;
-            lv_refr_area(&disp_refr->inv_areas[i]);
+        if(i == cnt - 1) disp_refr->driver.buffer->last_area = 1;
+        disp_refr->driver.buffer->last_part = 0;
+        lv_refr_area(area_p);
 
-            px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
-        }
+        px_num += lv_area_get_size(area_p);
     }
 }
 
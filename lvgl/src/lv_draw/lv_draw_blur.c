@@ -0,0 +1,520 @@
+/**
+ * @file lv_draw_blur.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_blur.h"
+#include "lv_draw_img.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The color channels are summed in 21 bit wide lanes of a 64 bit word: blue at 0, green at 21, red at 42*/
+#define BLUR_LANE_SHIFT     21
+#define BLUR_LANE_MASK      0x1FFFFF
+
+#if LV_COLOR_DEPTH == 16
+    #define BLUR_CH_MAX     63
+#else
+    #define BLUR_CH_MAX     255
+#endif
+
+#define BLUR_CLAMP(x, last) ((x) < 0 ? 0 : ((x) > (last) ? (last) : (x)))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void blur_img_line(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, bool ver, int32_t len, int32_t i1,
+                          int32_t i2, uint16_t win, uint8_t passes, lv_color_t color, lv_color_t ** c_buf,
+                          lv_opa_t ** a_buf);
+static void img_line_get(const lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, bool ver, int32_t len,
+                         lv_color_t * c, lv_opa_t * a, lv_color_t color);
+static void img_line_set(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, bool ver, int32_t i1, int32_t i2,
+                         const lv_color_t * c, const lv_opa_t * a);
+static inline uint32_t blur_recip(uint16_t win, uint32_t max_sample);
+static inline uint32_t blur_div(uint32_t sum, uint16_t win, uint32_t recip);
+static inline uint64_t color_expand(lv_color_t c);
+static inline lv_color_t color_pack(uint64_t sum, uint16_t win, uint32_t recip);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Box blur a line of 16 bit samples with a running sum. The samples out of the line are clamped to the edges.
+ * @param src the original samples. Not modified.
+ * @param dst store the result here. Only the `[x1..x2]` range is written. Can't be the same as `src`.
+ * @param len number of samples in `src`
+ * @param x1 first sample to calculate
+ * @param x2 last sample to calculate
+ * @param win number of samples to average
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blur_line_u16(const uint16_t * src, uint16_t * dst, int32_t len, int32_t x1,
+                                             int32_t x2, uint16_t win)
+{
+    if(win == 0) win = 1;
+    if(win > LV_BLUR_WIN_MAX) win = LV_BLUR_WIN_MAX;
+
+    int32_t r_back = win >> 1;
+    int32_t r_front = win >> 1;
+    if((win & 0x1) == 0) r_back--;
+
+    uint32_t recip = blur_recip(win, UINT16_MAX);
+    int32_t last = len - 1;
+    uint32_t sum = 0;
+    int32_t x;
+    for(x = x1 - r_back; x <= x1 + r_front; x++) {
+        sum += src[BLUR_CLAMP(x, last)];
+    }
+
+    for(x = x1; x <= x2; x++) {
+        dst[x] = blur_div(sum, win, recip);
+
+        int32_t i_out = x - r_back;
+        int32_t i_in = x + 1 + r_front;
+        sum -= src[i_out < 0 ? 0 : i_out];
+        sum += src[i_in > last ? last : i_in];
+    }
+}
+
+/**
+ * Box blur a line of colors and/or opacities with a running sum.
+ * The color channels are accumulated together in one 64 bit word.
+ * The samples out of the line are clamped to the edges.
+ * @param src_c the original colors or `NULL` if there are only opacities
+ * @param src_a the original opacities or `NULL` if there are only colors
+ * @param dst_c store the resulting colors here (ignored if `src_c == NULL`)
+ * @param dst_a store the resulting opacities here (ignored if `src_a == NULL`)
+ * @param len number of samples in the line
+ * @param x1 first sample to calculate
+ * @param x2 last sample to calculate
+ * @param win number of samples to average
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blur_line(const lv_color_t * src_c, const lv_opa_t * src_a, lv_color_t * dst_c,
+                                         lv_opa_t * dst_a, int32_t len, int32_t x1, int32_t x2, uint16_t win)
+{
+    if(win == 0) win = 1;
+    if(win > LV_BLUR_WIN_MAX) win = LV_BLUR_WIN_MAX;
+
+    int32_t r_back = win >> 1;
+    int32_t r_front = win >> 1;
+    if((win & 0x1) == 0) r_back--;
+
+    int32_t last = len - 1;
+    int32_t x;
+
+    /*Only opacities*/
+    if(src_c == NULL) {
+        uint32_t recip_a = blur_recip(win, LV_OPA_COVER);
+        uint32_t asum = 0;
+        for(x = x1 - r_back; x <= x1 + r_front; x++) {
+            asum += src_a[BLUR_CLAMP(x, last)];
+        }
+
+        for(x = x1; x <= x2; x++) {
+            dst_a[x] = blur_div(asum, win, recip_a);
+
+            int32_t i_out = x - r_back;
+            int32_t i_in = x + 1 + r_front;
+            asum -= src_a[i_out < 0 ? 0 : i_out];
+            asum += src_a[i_in > last ? last : i_in];
+        }
+        return;
+    }
+
+    uint32_t recip_c = blur_recip(win, BLUR_CH_MAX);
+    uint64_t csum = 0;
+    for(x = x1 - r_back; x <= x1 + r_front; x++) {
+        csum += color_expand(src_c[BLUR_CLAMP(x, last)]);
+    }
+
+    /*Only colors*/
+    if(src_a == NULL) {
+        for(x = x1; x <= x2; x++) {
+            dst_c[x] = color_pack(csum, win, recip_c);
+
+            int32_t i_out = x - r_back;
+            int32_t i_in = x + 1 + r_front;
+            /*Subtract first: every lane holds the leaving sample so it can't borrow from the next lane*/
+            csum -= color_expand(src_c[i_out < 0 ? 0 : i_out]);
+            csum += color_expand(src_c[i_in > last ? last : i_in]);
+        }
+        return;
+    }
+
+    /*Colors with opacity*/
+    uint32_t recip_a = blur_recip(win, LV_OPA_COVER);
+    uint32_t asum = 0;
+    for(x = x1 - r_back; x <= x1 + r_front; x++) {
+        asum += src_a[BLUR_CLAMP(x, last)];
+    }
+
+    for(x = x1; x <= x2; x++) {
+        dst_a[x] = blur_div(asum, win, recip_a);
+
+        /*Keep the color of the fully transparent pixels*/
+        if(asum) dst_c[x] = color_pack(csum, win, recip_c);
+        else dst_c[x] = src_c[x];
+
+        int32_t i_out = x - r_back;
+        int32_t i_in = x + 1 + r_front;
+        if(i_out < 0) i_out = 0;
+        if(i_in > last) i_in = last;
+        csum -= color_expand(src_c[i_out]);
+        csum += color_expand(src_c[i_in]);
+        asum -= src_a[i_out];
+        asum += src_a[i_in];
+    }
+}
+
+/**
+ * Separable box blur of a `w` x `h` 16 bit buffer in place.
+ * @param buf pointer to the samples, `w * h` long
+ * @param w width of the buffer
+ * @param h height of the buffer
+ * @param win number of samples to average in both directions
+ * @param passes number of times to repeat the blur. `LV_BLUR_GAUSS_PASSES` gives a Gaussian-like result.
+ */
+void _lv_blur_u16(uint16_t * buf, int32_t w, int32_t h, uint16_t win, uint8_t passes)
+{
+    if(win <= 1 || passes == 0 || w <= 0 || h <= 0) return;
+
+    int32_t len_max = LV_MATH_MAX(w, h);
+    uint16_t * src = _lv_mem_buf_get(len_max * sizeof(uint16_t));
+    uint16_t * dst = _lv_mem_buf_get(len_max * sizeof(uint16_t));
+    int32_t x;
+    int32_t y;
+    uint8_t p;
+
+    /*Horizontal blur: copy each line and blur it back to its place*/
+    uint16_t * row = buf;
+    for(y = 0; y < h; y++) {
+        for(p = 0; p < passes; p++) {
+            _lv_memcpy(src, row, w * sizeof(uint16_t));
+            _lv_blur_line_u16(src, row, w, 0, w - 1, win);
+        }
+        row += w;
+    }
+
+    /*Vertical blur: gather a column, blur it and write it back*/
+    for(x = 0; x < w; x++) {
+        uint16_t * col = &buf[x];
+        for(y = 0; y < h; y++, col += w) src[y] = *col;
+
+        for(p = 0; p < passes; p++) {
+            _lv_blur_line_u16(src, dst, h, 0, h - 1, win);
+            uint16_t * tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+
+        col = &buf[x];
+        for(y = 0; y < h; y++, col += w) *col = src[y];
+    }
+
+    _lv_mem_buf_release(src);
+    _lv_mem_buf_release(dst);
+}
+
+/**
+ * Blur an area of an image buffer in place.
+ * `LV_IMG_CF_TRUE_COLOR/CHROMA_KEYED/ALPHA` and `LV_IMG_CF_ALPHA_8BIT` are read and written directly,
+ * other formats go through `lv_img_buf_get/set_px_...`.
+ * @param dsc the image to blur
+ * @param area the area to blur. Has to be on the image.
+ * @param win number of samples to average
+ * @param passes number of times to repeat the blur. `LV_BLUR_GAUSS_PASSES` gives a Gaussian-like result.
+ * @param dir `LV_BLUR_DIR_HOR/VER/BOTH`
+ * @param color color of the pixels with `LV_IMG_CF_ALPHA_...` formats
+ */
+void _lv_blur_img(lv_img_dsc_t * dsc, const lv_area_t * area, uint16_t win, uint8_t passes, lv_blur_dir_t dir,
+                  lv_color_t color)
+{
+    if(win <= 1 || passes == 0) return;
+
+    lv_img_cf_t cf = dsc->header.cf;
+    bool has_alpha = lv_img_cf_has_alpha(cf);
+    bool has_color = cf != LV_IMG_CF_ALPHA_1BIT && cf != LV_IMG_CF_ALPHA_2BIT &&
+                     cf != LV_IMG_CF_ALPHA_4BIT && cf != LV_IMG_CF_ALPHA_8BIT;
+
+    int32_t len_max = LV_MATH_MAX(dsc->header.w, dsc->header.h);
+    lv_color_t * c_buf[2] = {NULL, NULL};
+    lv_opa_t * a_buf[2] = {NULL, NULL};
+    if(has_color) {
+        c_buf[0] = _lv_mem_buf_get(len_max * sizeof(lv_color_t));
+        c_buf[1] = _lv_mem_buf_get(len_max * sizeof(lv_color_t));
+    }
+    if(has_alpha) {
+        a_buf[0] = _lv_mem_buf_get(len_max);
+        a_buf[1] = _lv_mem_buf_get(len_max);
+    }
+
+    lv_coord_t x;
+    lv_coord_t y;
+    if(dir & LV_BLUR_DIR_HOR) {
+        for(y = area->y1; y <= area->y2; y++) {
+            blur_img_line(dsc, 0, y, false, dsc->header.w, area->x1, area->x2, win, passes, color, c_buf, a_buf);
+        }
+    }
+
+    if(dir & LV_BLUR_DIR_VER) {
+        for(x = area->x1; x <= area->x2; x++) {
+            blur_img_line(dsc, x, 0, true, dsc->header.h, area->y1, area->y2, win, passes, color, c_buf, a_buf);
+        }
+    }
+
+    if(a_buf[1]) _lv_mem_buf_release(a_buf[1]);
+    if(a_buf[0]) _lv_mem_buf_release(a_buf[0]);
+    if(c_buf[1]) _lv_mem_buf_release(c_buf[1]);
+    if(c_buf[0]) _lv_mem_buf_release(c_buf[0]);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Blur one row or column of an image
+ * @param dsc the image
+ * @param x x coordinate of the column (if `ver == true`)
+ * @param y y coordinate of the row (if `ver == false`)
+ * @param ver true: blur a column; false: blur a row
+ * @param len length of the row or column
+ * @param i1 first pixel to write back
+ * @param i2 last pixel to write back
+ * @param win number of samples to average
+ * @param passes number of times to repeat the blur
+ * @param color color of the pixels with `LV_IMG_CF_ALPHA_...` formats
+ * @param c_buf two color buffers with `len` elements (`NULL`s if the image has no color)
+ * @param a_buf two opacity buffers with `len` elements (`NULL`s if the image has no alpha)
+ */
+static void blur_img_line(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, bool ver, int32_t len, int32_t i1,
+                          int32_t i2, uint16_t win, uint8_t passes, lv_color_t color, lv_color_t ** c_buf,
+                          lv_opa_t ** a_buf)
+{
+    lv_color_t * c_src = c_buf[0];
+    lv_color_t * c_dst = c_buf[1];
+    lv_opa_t * a_src = a_buf[0];
+    lv_opa_t * a_dst = a_buf[1];
+
+    img_line_get(dsc, x, y, ver, len, c_src, a_src, color);
+
+    uint8_t p;
+    for(p = 0; p < passes; p++) {
+        /*The intermediate passes need the whole line to blur the edges of the area correctly*/
+        bool last = p == passes - 1;
+        _lv_blur_line(c_src, a_src, c_dst, a_dst, len, last ? i1 : 0, last ? i2 : len - 1, win);
+        if(!last) {
+            lv_color_t * c_tmp = c_src;
+            c_src = c_dst;
+            c_dst = c_tmp;
+            lv_opa_t * a_tmp = a_src;
+            a_src = a_dst;
+            a_dst = a_tmp;
+        }
+    }
+
+    img_line_set(dsc, x, y, ver, i1, i2, c_dst, a_dst);
+}
+
+/**
+ * Read a row or a column of an image into separate color and opacity buffers
+ * @param dsc the image
+ * @param x x coordinate of the column (if `ver == true`)
+ * @param y y coordinate of the row (if `ver == false`)
+ * @param ver true: read a column; false: read a row
+ * @param len number of pixels to read
+ * @param c store the colors here or `NULL` to skip them
+ * @param a store the opacities here or `NULL` to skip them
+ * @param color color of the pixels with `LV_IMG_CF_ALPHA_...` formats
+ */
+static void img_line_get(const lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, bool ver, int32_t len,
+                         lv_color_t * c, lv_opa_t * a, lv_color_t color)
+{
+    uint32_t step = ver ? dsc->header.w : 1;
+    uint32_t first = ver ? (uint32_t)x : (uint32_t)y * dsc->header.w;
+    int32_t i;
+
+    switch(dsc->header.cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
+                const lv_color_t * px = (const lv_color_t *)dsc->data + first;
+                for(i = 0; i < len; i++, px += step) c[i] = *px;
+                break;
+            }
+        case LV_IMG_CF_TRUE_COLOR_ALPHA: {
+                const uint8_t * px = dsc->data + first * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                step *= LV_IMG_PX_SIZE_ALPHA_BYTE;
+                for(i = 0; i < len; i++, px += step) {
+#if LV_COLOR_DEPTH == 16
+                    c[i].full = px[0] + (px[1] << 8);
+#else
+                    _lv_memcpy_small(&c[i], px, sizeof(lv_color_t));
+#endif
+                    a[i] = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                }
+                break;
+            }
+        case LV_IMG_CF_ALPHA_8BIT: {
+                const uint8_t * px = dsc->data + first;
+                for(i = 0; i < len; i++, px += step) a[i] = *px;
+                break;
+            }
+        default: {
+                lv_img_dsc_t * dsc_rw = (lv_img_dsc_t *)dsc;
+                for(i = 0; i < len; i++) {
+                    lv_coord_t px_x = ver ? x : i;
+                    lv_coord_t px_y = ver ? i : y;
+                    if(c) c[i] = lv_img_buf_get_px_color(dsc_rw, px_x, px_y, color);
+                    if(a) a[i] = lv_img_buf_get_px_alpha(dsc_rw, px_x, px_y);
+                }
+                break;
+            }
+    }
+}
+
+/**
+ * Write back a part of a row or a column of an image from separate color and opacity buffers
+ * @param dsc the image
+ * @param x x coordinate of the column (if `ver == true`)
+ * @param y y coordinate of the row (if `ver == false`)
+ * @param ver true: write a column; false: write a row
+ * @param i1 first pixel to write
+ * @param i2 last pixel to write
+ * @param c the colors or `NULL` to skip them
+ * @param a the opacities or `NULL` to skip them
+ */
+static void img_line_set(lv_img_dsc_t * dsc, lv_coord_t x, lv_coord_t y, bool ver, int32_t i1, int32_t i2,
+                         const lv_color_t * c, const lv_opa_t * a)
+{
+    uint32_t step = ver ? dsc->header.w : 1;
+    uint32_t first = ver ? (uint32_t)i1 * dsc->header.w + x : (uint32_t)y * dsc->header.w + i1;
+    int32_t i;
+
+    switch(dsc->header.cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
+                lv_color_t * px = (lv_color_t *)dsc->data + first;
+                for(i = i1; i <= i2; i++, px += step) *px = c[i];
+                break;
+            }
+        case LV_IMG_CF_TRUE_COLOR_ALPHA: {
+                uint8_t * px = (uint8_t *)dsc->data + first * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                step *= LV_IMG_PX_SIZE_ALPHA_BYTE;
+                for(i = i1; i <= i2; i++, px += step) {
+#if LV_COLOR_DEPTH == 16
+                    px[0] = c[i].full & 0xFF;
+                    px[1] = c[i].full >> 8;
+#else
+                    _lv_memcpy_small(px, &c[i], sizeof(lv_color_t));
+#endif
+                    px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = a[i];
+                }
+                break;
+            }
+        case LV_IMG_CF_ALPHA_8BIT: {
+                uint8_t * px = (uint8_t *)dsc->data + first;
+                for(i = i1; i <= i2; i++, px += step) *px = a[i];
+                break;
+            }
+        default: {
+                for(i = i1; i <= i2; i++) {
+                    lv_coord_t px_x = ver ? x : i;
+                    lv_coord_t px_y = ver ? i : y;
+                    if(c) lv_img_buf_set_px_color(dsc, px_x, px_y, c[i]);
+                    if(a) lv_img_buf_set_px_alpha(dsc, px_x, px_y, a[i]);
+                }
+                break;
+            }
+    }
+}
+
+/**
+ * Get a reciprocal of `win` to replace the division with a multiplication
+ * @param win the divisor
+ * @param max_sample the largest sample which will be summed
+ * @return the reciprocal or 0 if `sum * recip >> 32` wouldn't be exact so real division is required
+ */
+static inline uint32_t blur_recip(uint16_t win, uint32_t max_sample)
+{
+    if(win <= 1) return 0;
+
+    /*Exact while `max_sum * (win - 1) < 2^32`*/
+    if((uint64_t)max_sample * win * win >= ((uint64_t)1 << 32)) return 0;
+
+    return (uint32_t)(0xFFFFFFFFUL / win) + 1;
+}
+
+static inline uint32_t blur_div(uint32_t sum, uint16_t win, uint32_t recip)
+{
+    if(recip) return (uint32_t)(((uint64_t)sum * recip) >> 32);
+    else return sum / win;
+}
+
+/**
+ * Spread the channels of a color to the lanes of a 64 bit word
+ * @param c a color
+ * @return blue in bits 0..20, green in bits 21..41, red from bit 42
+ */
+static inline uint64_t color_expand(lv_color_t c)
+{
+#if LV_COLOR_DEPTH == 16
+    uint32_t v = c.full;
+#if LV_COLOR_16_SWAP
+    v = ((v >> 8) | (v << 8)) & 0xFFFF;
+#endif
+    return (uint64_t)(v & 0x001F) | ((uint64_t)(v & 0x07E0) << 16) | ((uint64_t)(v & 0xF800) << 31);
+#else
+    return (uint64_t)LV_COLOR_GET_B(c) | ((uint64_t)LV_COLOR_GET_G(c) << BLUR_LANE_SHIFT) |
+           ((uint64_t)LV_COLOR_GET_R(c) << (2 * BLUR_LANE_SHIFT));
+#endif
+}
+
+/**
+ * Average the channel sums of `color_expand`ed colors
+ * @param sum sum of `win` expanded colors
+ * @param win number of summed colors
+ * @param recip reciprocal of `win` from `blur_recip`
+ * @return the average color
+ */
+static inline lv_color_t color_pack(uint64_t sum, uint16_t win, uint32_t recip)
+{
+    uint32_t b = blur_div((uint32_t)sum & BLUR_LANE_MASK, win, recip);
+    uint32_t g = blur_div((uint32_t)(sum >> BLUR_LANE_SHIFT) & BLUR_LANE_MASK, win, recip);
+    uint32_t r = blur_div((uint32_t)(sum >> (2 * BLUR_LANE_SHIFT)), win, recip);
+
+    lv_color_t c;
+#if LV_COLOR_DEPTH == 16
+    uint32_t v = (r << 11) | (g << 5) | b;
+#if LV_COLOR_16_SWAP
+    v = (v >> 8) | (v << 8);
+#endif
+    c.full = (uint16_t)v;
+#else
+    c.full = 0;
+    LV_COLOR_SET_R(c, r);
+    LV_COLOR_SET_G(c, g);
+    LV_COLOR_SET_B(c, b);
+#if LV_COLOR_DEPTH == 32
+    c.ch.alpha = 0xFF;
+#endif
+#endif
+    return c;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file lv_draw_blur.h
+ *
+ */
+
+#ifndef LV_DRAW_BLUR_H
+#define LV_DRAW_BLUR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../lv_misc/lv_color.h"
+#include "../lv_misc/lv_area.h"
+#include "lv_img_buf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Number of box blur passes which approximate a Gaussian blur*/
+#define LV_BLUR_GAUSS_PASSES    3
+
+/*The largest window the running sums can hold without overflowing a channel*/
+#define LV_BLUR_WIN_MAX         8191
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+enum {
+    LV_BLUR_DIR_HOR  = 0x01,
+    LV_BLUR_DIR_VER  = 0x02,
+    LV_BLUR_DIR_BOTH = 0x03,
+};
+
+typedef uint8_t lv_blur_dir_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+//! @cond Doxygen_Suppress
+
+/**
+ * Box blur a line of 16 bit samples with a running sum. The samples out of the line are clamped to the edges.
+ * @param src the original samples. Not modified.
+ * @param dst store the result here. Only the `[x1..x2]` range is written. Can't be the same as `src`.
+ * @param len number of samples in `src`
+ * @param x1 first sample to calculate
+ * @param x2 last sample to calculate
+ * @param win number of samples to average
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blur_line_u16(const uint16_t * src, uint16_t * dst, int32_t len, int32_t x1,
+                                             int32_t x2, uint16_t win);
+
+/**
+ * Box blur a line of colors and/or opacities with a running sum.
+ * The color channels are accumulated together in one 64 bit word.
+ * The samples out of the line are clamped to the edges.
+ * @param src_c the original colors or `NULL` if there are only opacities
+ * @param src_a the original opacities or `NULL` if there are only colors
+ * @param dst_c store the resulting colors here (ignored if `src_c == NULL`)
+ * @param dst_a store the resulting opacities here (ignored if `src_a == NULL`)
+ * @param len number of samples in the line
+ * @param x1 first sample to calculate
+ * @param x2 last sample to calculate
+ * @param win number of samples to average
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blur_line(const lv_color_t * src_c, const lv_opa_t * src_a, lv_color_t * dst_c,
+                                         lv_opa_t * dst_a, int32_t len, int32_t x1, int32_t x2, uint16_t win);
+
+/**
+ * Separable box blur of a `w` x `h` 16 bit buffer in place.
+ * @param buf pointer to the samples, `w * h` long
+ * @param w width of the buffer
+ * @param h height of the buffer
+ * @param win number of samples to average in both directions
+ * @param passes number of times to repeat the blur. `LV_BLUR_GAUSS_PASSES` gives a Gaussian-like result.
+ */
+void _lv_blur_u16(uint16_t * buf, int32_t w, int32_t h, uint16_t win, uint8_t passes);
+
+/**
+ * Blur an area of an image buffer in place.
+ * `LV_IMG_CF_TRUE_COLOR/CHROMA_KEYED/ALPHA` and `LV_IMG_CF_ALPHA_8BIT` are read and written directly,
+ * other formats go through `lv_img_buf_get/set_px_...`.
+ * @param dsc the image to blur
+ * @param area the area to blur. Has to be on the image.
+ * @param win number of samples to average
+ * @param passes number of times to repeat the blur. `LV_BLUR_GAUSS_PASSES` gives a Gaussian-like result.
+ * @param dir `LV_BLUR_DIR_HOR/VER/BOTH`
+ * @param color color of the pixels with `LV_IMG_CF_ALPHA_...` formats
+ */
+void _lv_blur_img(lv_img_dsc_t * dsc, const lv_area_t * area, uint16_t win, uint8_t passes, lv_blur_dir_t dir,
+                  lv_color_t color);
+
+//! @endcond
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_BLUR_H*/
@@ -22,6 +22,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*Repeated opaque pixels of RLE images are filled instead of copied from this length*/
+#define RLE_FILL_MIN_LEN    8
 
 /**********************
  *      TYPEDEFS
@@ -39,6 +41,8 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
                                               const lv_draw_img_dsc_t * draw_dsc,
                                               bool chroma_key, bool alpha_byte);
 
+LV_ATTRIBUTE_FAST_MEM static void draw_rle(const lv_area_t * coords, const lv_area_t * clip_area,
+                                           const lv_img_decoder_dsc_t * dec_dsc, const lv_draw_img_dsc_t * draw_dsc);
 static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, const char * msg);
 static void draw_cleanup(lv_img_cache_entry_t * cache);
 
@@ -183,6 +187,8 @@ bool lv_img_cf_has_alpha(lv_img_cf_t cf)
         case LV_IMG_CF_ALPHA_2BIT:
         case LV_IMG_CF_ALPHA_4BIT:
         case LV_IMG_CF_ALPHA_8BIT:
+        case LV_IMG_CF_RLE_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_RLE_ALPHA:
             has_alpha = true;
             break;
         default:
@@ -193,6 +199,16 @@ bool lv_img_cf_has_alpha(lv_img_cf_t cf)
     return has_alpha;
 }
 
+/**
+ * Check if a color format is run-length encoded or not
+ * @param cf a color format (`LV_IMG_CF_...`)
+ * @return true: run-length encoded; false: not run-length encoded
+ */
+bool lv_img_cf_is_rle(lv_img_cf_t cf)
+{
+    return cf == LV_IMG_CF_RLE_TRUE_COLOR || cf == LV_IMG_CF_RLE_TRUE_COLOR_ALPHA || cf == LV_IMG_CF_RLE_ALPHA;
+}
+
 /**
  * Get the type of an image source
  * @param src pointer to an image source:
@@ -276,6 +292,12 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
 
         lv_draw_map(coords, &mask_com, cdsc->dec_dsc.img_data, draw_dsc, chroma_keyed, alpha_byte);
     }
+    /* Run-length encoded variables can be blended run by run if there is nothing else to do with the pixels*/
+    else if(lv_img_cf_is_rle(cdsc->dec_dsc.header.cf) && cdsc->dec_dsc.src_type == LV_IMG_SRC_VARIABLE &&
+            lv_draw_mask_get_cnt() == 0 && draw_dsc->angle == 0 && draw_dsc->zoom == LV_IMG_ZOOM_NONE &&
+            draw_dsc->recolor_opa == LV_OPA_TRANSP) {
+        draw_rle(coords, clip_area, &cdsc->dec_dsc, draw_dsc);
+    }
     /* The whole uncompressed image is not available. Try to read it line-by-line*/
     else {
         lv_area_t mask_com; /*Common area of mask and coords*/
@@ -527,28 +549,21 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
 
 #if LV_USE_IMG_TRANSFORM
                 int32_t rot_x = disp_area->x1 + draw_area.x1 - map_area->x1;
-#endif
-                for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
-
-#if LV_USE_IMG_TRANSFORM
-                    if(transform) {
-
-                        /*Transform*/
-                        bool ret;
-                        ret = _lv_img_buf_transform(&trans_dsc, rot_x + x, rot_y + y);
-                        if(ret == false) {
-                            mask_buf[px_i] = LV_OPA_TRANSP;
-                            continue;
-                        }
-                        else {
-                            mask_buf[px_i] = trans_dsc.res.opa;
-                            c.full = trans_dsc.res.color.full;
+                if(transform) {
+                    /*Transform the whole line at once*/
+                    _lv_img_buf_transform_line(&trans_dsc, rot_x, rot_y + y, draw_area_w, &map2[px_i], &mask_buf[px_i]);
+                    if(draw_dsc->recolor_opa != 0) {
+                        for(x = 0; x < draw_area_w; x++) {
+                            if(mask_buf[px_i + x] == LV_OPA_TRANSP) continue;
+                            map2[px_i + x] = lv_color_mix_premult(recolor_premult, map2[px_i + x], recolor_opa_inv);
                         }
                     }
-                    /*No transform*/
-                    else
+                    px_i += draw_area_w;
+                }
+                else
 #endif
-                    {
+                {
+                    for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
                         if(alpha_byte) {
                             lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
                             mask_buf[px_i] = px_opa;
@@ -582,13 +597,13 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
                                 continue;
                             }
                         }
-                    }
 
-                    if(draw_dsc->recolor_opa != 0) {
-                        c = lv_color_mix_premult(recolor_premult, c, recolor_opa_inv);
-                    }
+                        if(draw_dsc->recolor_opa != 0) {
+                            c = lv_color_mix_premult(recolor_premult, c, recolor_opa_inv);
+                        }
 
-                    map2[px_i].full = c.full;
+                        map2[px_i].full = c.full;
+                    }
                 }
 
                 /*Apply the masks if any*/
@@ -639,6 +654,125 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
     }
 }
 
+/**
+ * Draw a run-length encoded image without transformation, recoloring and masks.
+ * Long runs of opaque pixels are filled, the other visible pixels are copied line by line.
+ * Transparent pixels are skipped.
+ * @param coords the coordinates of the image
+ * @param clip_area the image will be drawn only in this area
+ * @param dec_dsc the opened image. It's source is an `lv_img_dsc_t` variable with `LV_IMG_CF_RLE_...` color format.
+ * @param draw_dsc pointer to an initialized `lv_draw_img_dsc_t` variable
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_rle(const lv_area_t * coords, const lv_area_t * clip_area,
+                                           const lv_img_decoder_dsc_t * dec_dsc, const lv_draw_img_dsc_t * draw_dsc)
+{
+    lv_area_t mask_com; /*Common area of mask and coords*/
+    if(_lv_area_intersect(&mask_com, clip_area, coords) == false) return;
+
+    const uint8_t * data = ((const lv_img_dsc_t *)dec_dsc->src)->data;
+    lv_img_cf_t cf = dec_dsc->header.cf;
+    uint8_t px_size;
+    if(cf == LV_IMG_CF_RLE_ALPHA) px_size = 1;
+    else if(cf == LV_IMG_CF_RLE_TRUE_COLOR_ALPHA) px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+    else px_size = LV_COLOR_SIZE / 8;
+
+    /*The pixels to copy are collected here*/
+    int32_t w = lv_area_get_width(&mask_com);
+    lv_color_t * color_buf = _lv_mem_buf_get(w * sizeof(lv_color_t));
+    lv_opa_t * opa_buf = cf == LV_IMG_CF_RLE_TRUE_COLOR ? NULL : _lv_mem_buf_get(w);
+
+    lv_area_t span;
+    int32_t y;
+    for(y = mask_com.y1; y <= mask_com.y2; y++) {
+        uint32_t line_ofs;
+        _lv_memcpy_small(&line_ofs, &data[(y - coords->y1) * sizeof(uint32_t)], sizeof(uint32_t));
+        const uint8_t * p = &data[line_ofs];
+
+        span.y1 = y;
+        span.y2 = y;
+        int32_t span_len = 0;
+
+        int32_t x = coords->x1;
+        while(x <= mask_com.x2) {
+            uint8_t head = *p;
+            p++;
+            int32_t cnt = (head & LV_IMG_RLE_CNT_MASK) + 1;
+            bool repeat = head & LV_IMG_RLE_REPEAT ? true : false;
+
+            /*The visible part of the packet*/
+            int32_t vx1 = LV_MATH_MAX(x, mask_com.x1);
+            int32_t vx2 = LV_MATH_MIN(x + cnt - 1, mask_com.x2);
+            const uint8_t * px = repeat ? p : p + (vx1 - x) * px_size;
+
+            /*Literal true color pixels are the same as in `lv_color_t` arrays*/
+            if(!repeat && cf == LV_IMG_CF_RLE_TRUE_COLOR && vx1 <= vx2) {
+                if(span_len == 0) span.x1 = vx1;
+                _lv_memcpy(&color_buf[span_len], px, (vx2 - vx1 + 1) * sizeof(lv_color_t));
+                span_len += vx2 - vx1 + 1;
+                p += cnt * px_size;
+                x += cnt;
+                continue;
+            }
+
+            int32_t i;
+            for(i = vx1; i <= vx2; i++) {
+                lv_color_t c = dec_dsc->color;
+                lv_opa_t opa = LV_OPA_COVER;
+                if(cf == LV_IMG_CF_RLE_ALPHA) {
+                    opa = px[0];
+                }
+                else {
+                    _lv_memcpy_small(&c, px, LV_COLOR_SIZE / 8);
+                    if(cf == LV_IMG_CF_RLE_TRUE_COLOR_ALPHA) opa = px[LV_COLOR_SIZE / 8];
+                }
+
+                /*Transparent pixels and long opaque runs end the collected pixels*/
+                bool fill = repeat && opa == LV_OPA_COVER && vx2 - i + 1 >= RLE_FILL_MIN_LEN;
+                if(opa == LV_OPA_TRANSP || fill) {
+                    if(span_len) {
+                        span.x2 = span.x1 + span_len - 1;
+                        _lv_blend_map(clip_area, &span, color_buf, opa_buf,
+                                      opa_buf ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER,
+                                      draw_dsc->opa, draw_dsc->blend_mode);
+                        span_len = 0;
+                    }
+
+                    if(fill) {
+                        lv_area_t fill_area;
+                        lv_area_set(&fill_area, i, y, vx2, y);
+                        _lv_blend_fill(clip_area, &fill_area, c, NULL, LV_DRAW_MASK_RES_FULL_COVER, draw_dsc->opa,
+                                       draw_dsc->blend_mode);
+                    }
+
+                    /*The rest of a repeated run is the same*/
+                    if(repeat) break;
+                }
+                else {
+                    if(span_len == 0) span.x1 = i;
+                    color_buf[span_len] = c;
+                    if(opa_buf) opa_buf[span_len] = opa;
+                    span_len++;
+                }
+
+                if(!repeat) px += px_size;
+            }
+
+            p += repeat ? px_size : cnt * px_size;
+            x += cnt;
+        }
+
+        if(span_len) {
+            span.x2 = span.x1 + span_len - 1;
+            _lv_blend_map(clip_area, &span, color_buf, opa_buf,
+                          opa_buf ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER,
+                          draw_dsc->opa, draw_dsc->blend_mode);
+        }
+    }
+
+    if(opa_buf) _lv_mem_buf_release(opa_buf);
+    _lv_mem_buf_release(color_buf);
+}
+
 static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, const char * msg)
 {
     lv_draw_rect_dsc_t rect_dsc;
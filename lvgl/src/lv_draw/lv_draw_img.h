@@ -89,6 +89,13 @@ bool lv_img_cf_is_chroma_keyed(lv_img_cf_t cf);
  */
 bool lv_img_cf_has_alpha(lv_img_cf_t cf);
 
+/**
+ * Check if a color format is run-length encoded or not
+ * @param cf a color format (`LV_IMG_CF_...`)
+ * @return true: run-length encoded; false: not run-length encoded
+ */
+bool lv_img_cf_is_rle(lv_img_cf_t cf);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
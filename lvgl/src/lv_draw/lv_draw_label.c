@@ -128,8 +128,14 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, mask);
     if(!clip_ok) return;
 
-    if((dsc->flag & LV_TXT_FLAG_EXPAND) == 0) {
-        /*Normally use the label's width as width*/
+    /*Use the cached line breaks if they belong to this text*/
+    const lv_txt_line_cache_t * lines = dsc->line_cache;
+    if(lines && !_lv_txt_line_cache_is_valid(lines, txt, font, dsc->letter_space, lv_area_get_width(coords), dsc->flag)) {
+        lines = NULL;
+    }
+
+    if((dsc->flag & LV_TXT_FLAG_EXPAND) == 0 || lines) {
+        /*Normally use the label's width as width. (The lines in the cache are already broken)*/
         w = lv_area_get_width(coords);
     }
     else {
@@ -156,10 +162,20 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_end       = 0;
+    uint32_t line_i         = 0;
     int32_t last_line_start = -1;
 
+    if(lines) {
+        /*Jump to the first visible line directly*/
+        line_i = _lv_txt_line_cache_get_line_at(lines, mask->y1 - pos.y, line_height_font, dsc->line_space);
+        if(line_i >= lines->line_cnt) return;
+        line_start = lines->lines[line_i].start;
+        line_end = lines->lines[line_i + 1].start;
+        pos.y += (int32_t)line_i * line_height;
+    }
     /*Check the hint to use the cached info*/
-    if(hint && y_ofs == 0 && coords->y1 < 0) {
+    else if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_MATH_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             hint->line_start = -1;
@@ -173,10 +189,12 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    if(lines == NULL) {
+        line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < mask->y1) {
+    while(lines == NULL && pos.y + line_height_font < mask->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
@@ -194,14 +212,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     /*Align to middle*/
     if(dsc->flag & LV_TXT_FLAG_CENTER) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines->lines[line_i].w;
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines->lines[line_i].w;
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -355,21 +375,29 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        if(lines) {
+            line_i++;
+            if(line_i < lines->line_cnt) line_end = lines->lines[line_i + 1].start;
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(dsc->flag & LV_TXT_FLAG_CENTER) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines->lines[line_i].w;
+            else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space,
+                                                     dsc->flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines->lines[line_i].w;
+            else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space,
+                                                     dsc->flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -534,33 +562,43 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
     uint32_t col_bit_max = 8 - bpp;
     uint32_t col_bit_row_ofs = (box_w + col_start - col_end) * bpp;
 
+    /*8 bit per pixel without opacity can be copied directly (e.g. from the glyph cache)*/
+    bool direct_copy = bpp == 8 && bpp_opa_table_p == _lv_bpp8_opa_table ? true : false;
+
     for(row = row_start ; row < row_end; row++) {
         int32_t mask_p_start = mask_p;
 
-        bitmask = bitmask_init >> col_bit;
-        for(col = col_start; col < col_end; col++) {
-            /*Load the pixel's opacity into the mask*/
-            letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
-            if(letter_px) {
-                mask_buf[mask_p] = bpp_opa_table_p[letter_px];
-            }
-            else {
-                mask_buf[mask_p] = 0;
-            }
+        if(direct_copy) {
+            _lv_memcpy(&mask_buf[mask_p], map_p, col_end - col_start);
+            map_p += col_end - col_start;
+            mask_p += col_end - col_start;
+        }
+        else {
+            bitmask = bitmask_init >> col_bit;
+            for(col = col_start; col < col_end; col++) {
+                /*Load the pixel's opacity into the mask*/
+                letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
+                if(letter_px) {
+                    mask_buf[mask_p] = bpp_opa_table_p[letter_px];
+                }
+                else {
+                    mask_buf[mask_p] = 0;
+                }
 
-            /*Go to the next column*/
-            if(col_bit < col_bit_max) {
-                col_bit += bpp;
-                bitmask = bitmask >> bpp;
-            }
-            else {
-                col_bit = 0;
-                bitmask = bitmask_init;
-                map_p++;
-            }
+                /*Go to the next column*/
+                if(col_bit < col_bit_max) {
+                    col_bit += bpp;
+                    bitmask = bitmask >> bpp;
+                }
+                else {
+                    col_bit = 0;
+                    bitmask = bitmask_init;
+                    map_p++;
+                }
 
-            /*Next mask byte*/
-            mask_p++;
+                /*Next mask byte*/
+                mask_p++;
+            }
         }
 
         /*Apply masks if any*/
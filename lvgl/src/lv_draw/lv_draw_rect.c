@@ -9,6 +9,7 @@
 #include "lv_draw_rect.h"
 #include "lv_draw_blend.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_blur.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_txt_ap.h"
 #include "../lv_core/lv_refr.h"
@@ -1036,10 +1037,8 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coord
         }
         else {
             int32_t i;
-            sh_ups_tmp_buf[0] = (mask_line[0] << SHADOW_UPSCALE_SHIFT) / sw;
-            for(i = 1; i < size; i++) {
-                if(mask_line[i] == mask_line[i - 1]) sh_ups_tmp_buf[i] = sh_ups_tmp_buf[i - 1];
-                else sh_ups_tmp_buf[i] = (mask_line[i] << SHADOW_UPSCALE_SHIFT) / sw;
+            for(i = 0; i < size; i++) {
+                sh_ups_tmp_buf[i] = mask_line[i] << SHADOW_UPSCALE_SHIFT;
             }
         }
 
@@ -1058,103 +1057,55 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coord
 
     shadow_blur_corner(size, sw, sh_buf);
 
-#if SHADOW_ENHANCE == 0
-    /*The result is required in lv_opa_t not uint16_t*/
-    uint32_t x;
-    lv_opa_t * res_buf = (lv_opa_t *)sh_buf;
-    for(x = 0; x < size * size; x++) {
-        res_buf[x] = sh_buf[x];
-    }
-#else
+#if SHADOW_ENHANCE
     sw += sw_ori & 1;
-    if(sw > 1) {
-        uint32_t i;
-        sh_buf[0] = (sh_buf[0] << SHADOW_UPSCALE_SHIFT) / sw;
-        for(i = 1; i < (uint32_t) size * size; i++) {
-            if(sh_buf[i] == sh_buf[i - 1]) sh_buf[i] = sh_buf[i - 1];
-            else sh_buf[i] = (sh_buf[i] << SHADOW_UPSCALE_SHIFT) / sw;
-        }
+    if(sw > 1) shadow_blur_corner(size, sw, sh_buf);
+#endif
 
-        shadow_blur_corner(size, sw, sh_buf);
-    }
+    /*The result is required in lv_opa_t not uint16_t*/
     int32_t x;
     lv_opa_t * res_buf = (lv_opa_t *)sh_buf;
     for(x = 0; x < size * size; x++) {
-        res_buf[x] = sh_buf[x];
+        res_buf[x] = sh_buf[x] >> SHADOW_UPSCALE_SHIFT;
     }
-#endif
-
 }
 
+/**
+ * Box blur the corner buffer in both directions.
+ * The outer side of the shadow is on the right and on the top, so the columns are blurred bottom to top
+ * to keep the longer half of an even window on the outer side in both directions.
+ * @param size width and height of the corner buffer
+ * @param sw shadow width (number of samples to average)
+ * @param sh_ups_buf the upscaled samples, `size * size` long
+ */
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf)
 {
-    int32_t s_left = sw >> 1;
-    int32_t s_right = (sw >> 1);
-    if((sw & 1) == 0) s_left--;
+    uint16_t * src = _lv_mem_buf_get(size * sizeof(uint16_t));
+    uint16_t * dst = _lv_mem_buf_get(size * sizeof(uint16_t));
 
     /*Horizontal blur*/
-    uint16_t * sh_ups_blur_buf = _lv_mem_buf_get(size * sizeof(uint16_t));
-
     int32_t x;
     int32_t y;
-
     uint16_t * sh_ups_tmp_buf = sh_ups_buf;
-
     for(y = 0; y < size; y++) {
-        int32_t v = sh_ups_tmp_buf[size - 1] * sw;
-        for(x = size - 1; x >= 0; x--) {
-            sh_ups_blur_buf[x] = v;
-
-            /*Forget the right pixel*/
-            uint32_t right_val = 0;
-            if(x + s_right < size) right_val = sh_ups_tmp_buf[x + s_right];
-            v -= right_val;
-
-            /*Add the left pixel*/
-            uint32_t left_val;
-            if(x - s_left - 1 < 0) left_val = sh_ups_tmp_buf[0];
-            else left_val = sh_ups_tmp_buf[x - s_left - 1];
-            v += left_val;
-        }
-        _lv_memcpy(sh_ups_tmp_buf, sh_ups_blur_buf, size * sizeof(uint16_t));
+        _lv_memcpy(src, sh_ups_tmp_buf, size * sizeof(uint16_t));
+        _lv_blur_line_u16(src, sh_ups_tmp_buf, size, 0, size - 1, sw);
         sh_ups_tmp_buf += size;
     }
 
-    /*Vertical blur*/
-    uint32_t i;
-    sh_ups_buf[0] = sh_ups_buf[0] / sw;
-    for(i = 1; i < (uint32_t)size * size; i++) {
-        if(sh_ups_buf[i] == sh_ups_buf[i - 1]) sh_ups_buf[i] = sh_ups_buf[i - 1];
-        else sh_ups_buf[i] = sh_ups_buf[i] / sw;
-    }
-
+    /*Vertical blur with the columns read upside down*/
     for(x = 0; x < size; x++) {
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        int32_t v = sh_ups_tmp_buf[0] * sw;
-        for(y = 0; y < size ; y++, sh_ups_tmp_buf += size) {
-            sh_ups_blur_buf[y] = v < 0 ? 0 : (v >> SHADOW_UPSCALE_SHIFT);
-
-            /*Forget the top pixel*/
-            uint32_t top_val;
-            if(y - s_right <= 0) top_val = sh_ups_tmp_buf[0];
-            else top_val = sh_ups_buf[(y - s_right) * size + x];
-            v -= top_val;
-
-            /*Add the bottom pixel*/
-            uint32_t bottom_val;
-            if(y + s_left + 1 < size) bottom_val = sh_ups_buf[(y + s_left + 1) * size + x];
-            else bottom_val = sh_ups_buf[(size - 1) * size + x];
-            v += bottom_val;
-        }
+        sh_ups_tmp_buf = &sh_ups_buf[(size - 1) * size + x];
+        for(y = 0; y < size; y++, sh_ups_tmp_buf -= size) src[y] = *sh_ups_tmp_buf;
 
-        /*Write back the result into `sh_ups_buf`*/
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        for(y = 0; y < size; y++, sh_ups_tmp_buf += size) {
-            (*sh_ups_tmp_buf) = sh_ups_blur_buf[y];
-        }
+        _lv_blur_line_u16(src, dst, size, 0, size - 1, sw);
+
+        sh_ups_tmp_buf = &sh_ups_buf[(size - 1) * size + x];
+        for(y = 0; y < size; y++, sh_ups_tmp_buf -= size) *sh_ups_tmp_buf = dst[y];
     }
 
-    _lv_mem_buf_release(sh_ups_blur_buf);
+    _lv_mem_buf_release(src);
+    _lv_mem_buf_release(dst);
 }
 
 #endif
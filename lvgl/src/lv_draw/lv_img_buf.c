@@ -25,6 +25,10 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_USE_IMG_TRANSFORM
+static inline bool transform_line_aa(lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t xs_int,
+                                     int32_t ys_int, uint32_t pxi, uint8_t px_size, lv_color_t * c, lv_opa_t * opa);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -33,6 +37,45 @@
 /**********************
  *      MACROS
  **********************/
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+#define PX_READ_COLOR(c, px) (c).full = (px)[0]
+#elif LV_COLOR_DEPTH == 16
+#define PX_READ_COLOR(c, px) (c).full = (px)[0] + ((px)[1] << 8)
+#elif LV_COLOR_DEPTH == 32
+#define PX_READ_COLOR(c, px) do { _lv_memcpy_small(&(c), (px), 3); (c).ch.alpha = 0xFF; } while(0)
+#endif
+
+/*Step through a line of `_lv_img_buf_transform_line`. `px_get` reads `c`, `opa`, `pxi` from `xs_int` and `ys_int`.
+ *The source position is calculated with the same rounding as in `_lv_img_buf_transform`*/
+#define TRANSFORM_LINE(px_get)                                                                  \
+    for(i = 0; i < len; i++, xz_up += zoom_inv) {                                               \
+        int32_t xz = (int32_t)xz_up >> zoom_shift;                                              \
+        int32_t xs;                                                                             \
+        int32_t ys;                                                                             \
+        if(rotate) {                                                                            \
+            xs = ((cosma * xz - sinma_yz) >> _LV_TRANSFORM_TRIGO_SHIFT) + pivot_x_256;          \
+            ys = ((sinma * xz + cosma_yz) >> _LV_TRANSFORM_TRIGO_SHIFT) + pivot_y_256;          \
+        }                                                                                       \
+        else {                                                                                  \
+            xs = xz + pivot_x_256;                                                              \
+            ys = yz + pivot_y_256;                                                              \
+        }                                                                                       \
+        int32_t xs_int = xs >> 8;                                                               \
+        int32_t ys_int = ys >> 8;                                                               \
+        if((uint32_t)xs_int >= (uint32_t)src_w || (uint32_t)ys_int >= (uint32_t)src_h) {        \
+            abuf[i] = LV_OPA_TRANSP;                                                            \
+            continue;                                                                           \
+        }                                                                                       \
+        px_get                                                                                  \
+        if(aa) {                                                                                \
+            if(!transform_line_aa(dsc, xs, ys, xs_int, ys_int, pxi, px_size, &c, &opa)) {      \
+                abuf[i] = LV_OPA_TRANSP;                                                        \
+                continue;                                                                       \
+            }                                                                                   \
+        }                                                                                       \
+        cbuf[i] = c;                                                                            \
+        abuf[i] = opa;                                                                          \
+    }
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -676,7 +719,165 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
 
     return true;
 }
+
+/**
+ * Get the transformed colors and opacities of a horizontal line.
+ * The result is the same as calling `_lv_img_buf_transform` for every pixel of the line
+ * but the zoomed coordinates are stepped incrementally and the color format is checked only once.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel
+ * @param y the y coordinate of the line
+ * @param len number of pixels to transform
+ * @param cbuf store the colors here. Not written where the opacity is `LV_OPA_TRANSP`.
+ * @param abuf store the opacities here. `LV_OPA_TRANSP` if the rotated pixel was out of the image.
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    const uint8_t * src_u8 = (const uint8_t *)dsc->cfg.src;
+    int32_t src_w = dsc->cfg.src_w;
+    int32_t src_h = dsc->cfg.src_h;
+    bool aa = dsc->cfg.antialias;
+
+    /* Zoom the coordinates relative to the pivot like `_lv_img_buf_transform` does (in 1/256 pixels).
+     * `xt` grows by 1 for every pixel so the zoomed x is stepped with `zoom_inv` in its upscaled format.
+     * Without zoom the coordinates are multiplied by 256 which gives the same result
+     * as rotating first and shifting with `_LV_TRANSFORM_TRIGO_SHIFT - 8`*/
+    int32_t xt = x - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+    uint32_t zoom_inv;
+    uint8_t zoom_shift;
+    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+        zoom_inv = 256;
+        zoom_shift = 0;
+    }
+    else {
+        zoom_inv = dsc->tmp.zoom_inv;
+        zoom_shift = _LV_ZOOM_INV_UPSCALE;
+    }
+
+    uint32_t xz_up = (int32_t)xt * zoom_inv;
+    int32_t yz = (int32_t)((int32_t)yt * zoom_inv) >> zoom_shift;
+
+    bool rotate = dsc->cfg.zoom == LV_IMG_ZOOM_NONE || dsc->cfg.angle != 0;
+    int32_t sinma = dsc->tmp.sinma;
+    int32_t cosma = dsc->tmp.cosma;
+    int32_t sinma_yz = sinma * yz;
+    int32_t cosma_yz = cosma * yz;
+    int32_t pivot_x_256 = dsc->tmp.pivot_x_256;
+    int32_t pivot_y_256 = dsc->tmp.pivot_y_256;
+
+    lv_color_t c = dsc->cfg.color;
+    lv_opa_t opa = LV_OPA_COVER;
+    uint32_t pxi = 0;
+    uint8_t px_size = 0;
+    lv_coord_t i;
+
+    switch(dsc->cfg.cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+            px_size = LV_COLOR_SIZE >> 3;
+            TRANSFORM_LINE(
+                pxi = (ys_int * src_w + xs_int) * px_size;
+                PX_READ_COLOR(c, &src_u8[pxi]);
+                opa = LV_OPA_COVER;
+            )
+            break;
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
+                lv_color_t ct = LV_COLOR_TRANSP;
+                px_size = LV_COLOR_SIZE >> 3;
+                TRANSFORM_LINE(
+                    pxi = (ys_int * src_w + xs_int) * px_size;
+                    PX_READ_COLOR(c, &src_u8[pxi]);
+                    opa = LV_OPA_COVER;
+                    if(c.full == ct.full) {
+                        abuf[i] = LV_OPA_TRANSP;
+                        continue;
+                    }
+                )
+                break;
+            }
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+            TRANSFORM_LINE(
+                pxi = (ys_int * src_w + xs_int) * px_size;
+                PX_READ_COLOR(c, &src_u8[pxi]);
+                opa = src_u8[pxi + px_size - 1];
+            )
+            break;
+        case LV_IMG_CF_INDEXED_1BIT:
+        case LV_IMG_CF_INDEXED_2BIT:
+        case LV_IMG_CF_INDEXED_4BIT:
+        case LV_IMG_CF_INDEXED_8BIT: {
+                /*Like `lv_img_buf_get_px_color` return the palette index in `full`*/
+                uint8_t bpp = lv_img_cf_get_px_size(dsc->cfg.cf);
+                uint8_t mask = (1 << bpp) - 1;
+                uint32_t stride = (src_w * bpp + 7) >> 3;
+                const uint8_t * map = src_u8 + (4 << bpp);
+                TRANSFORM_LINE(
+                    uint32_t bit = xs_int * bpp;
+                    c.full = (map[ys_int * stride + (bit >> 3)] >> (8 - bpp - (bit & 0x7))) & mask;
+                    opa = LV_OPA_COVER;
+                )
+                break;
+            }
+        case LV_IMG_CF_ALPHA_1BIT:
+        case LV_IMG_CF_ALPHA_2BIT:
+        case LV_IMG_CF_ALPHA_4BIT:
+        case LV_IMG_CF_ALPHA_8BIT: {
+                /*Same opacity mapping as `lv_img_buf_get_px_alpha`*/
+                uint8_t bpp = lv_img_cf_get_px_size(dsc->cfg.cf);
+                uint8_t mask = (1 << bpp) - 1;
+                uint8_t opa_mul = bpp == 2 ? 85 : (bpp == 4 ? 17 : 1);
+                uint32_t stride = (src_w * bpp + 7) >> 3;
+                TRANSFORM_LINE(
+                    uint32_t bit = xs_int * bpp;
+                    c = dsc->cfg.color;
+                    uint8_t px_opa = (src_u8[ys_int * stride + (bit >> 3)] >> (8 - bpp - (bit & 0x7))) & mask;
+                    if(bpp == 1) opa = px_opa ? LV_OPA_TRANSP : LV_OPA_COVER;
+                    else opa = px_opa * opa_mul;
+                )
+                break;
+            }
+        default:
+            _lv_memset_00(abuf, len);
+            break;
+    }
+}
 #endif
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_USE_IMG_TRANSFORM
+/**
+ * Anti-alias a pixel of `_lv_img_buf_transform_line` with `_lv_img_buf_transform_anti_alias`
+ * @param dsc pointer to the transformation descriptor
+ * @param xs source x coordinate in 1/256 pixels
+ * @param ys source y coordinate in 1/256 pixels
+ * @param xs_int integer part of `xs`
+ * @param ys_int integer part of `ys`
+ * @param pxi byte index of the source pixel (only for true color formats)
+ * @param px_size pixel size in bytes (only for true color formats)
+ * @param c the color of the source pixel. The result is written back here.
+ * @param opa the opacity of the source pixel. The result is written back here.
+ * @return true: the pixel is visible; false: the pixel is transparent
+ */
+static inline bool transform_line_aa(lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t xs_int,
+                                     int32_t ys_int, uint32_t pxi, uint8_t px_size, lv_color_t * c, lv_opa_t * opa)
+{
+    dsc->tmp.xs = xs;
+    dsc->tmp.ys = ys;
+    dsc->tmp.xs_int = xs_int;
+    dsc->tmp.ys_int = ys_int;
+    dsc->tmp.pxi = pxi;
+    dsc->tmp.px_size = px_size;
+    dsc->res.color = *c;
+    dsc->res.opa = *opa;
+
+    if(_lv_img_buf_transform_anti_alias(dsc) == false) return false;
+
+    *c = dsc->res.color;
+    *opa = dsc->res.opa;
+    return true;
+}
+#endif
@@ -45,6 +45,15 @@ extern "C" {
 #define LV_IMG_BUF_SIZE_INDEXED_4BIT(w, h) (LV_IMG_BUF_SIZE_ALPHA_4BIT(w, h) + 4 * 16)
 #define LV_IMG_BUF_SIZE_INDEXED_8BIT(w, h) (LV_IMG_BUF_SIZE_ALPHA_8BIT(w, h) + 4 * 256)
 
+/* Run-length encoded images (`LV_IMG_CF_RLE_...`) start with the `uint32_t` offset of every line
+ * from the beginning of the data. A line is a series of packets. Packets don't continue in the next line.
+ * - literal: a `0nnnnnnn` byte followed by `n + 1` pixels
+ * - repeat: a `1nnnnnnn` byte followed by one pixel which is repeated `n + 1` times
+ * A pixel is `LV_COLOR_SIZE / 8` bytes color with `LV_IMG_CF_RLE_TRUE_COLOR`,
+ * color and an alpha byte with `LV_IMG_CF_RLE_TRUE_COLOR_ALPHA` and only an alpha byte with `LV_IMG_CF_RLE_ALPHA`*/
+#define LV_IMG_RLE_REPEAT   0x80
+#define LV_IMG_RLE_CNT_MASK 0x7F
+
 #define LV_IMG_ZOOM_NONE   256
 
 #define _LV_TRANSFORM_TRIGO_SHIFT 10
@@ -79,9 +88,9 @@ enum {
     LV_IMG_CF_ALPHA_4BIT, /**< Can have one color but 16 different alpha value*/
     LV_IMG_CF_ALPHA_8BIT, /**< Can have one color but 256 different alpha value*/
 
-    LV_IMG_CF_RESERVED_15,              /**< Reserved for further use. */
-    LV_IMG_CF_RESERVED_16,              /**< Reserved for further use. */
-    LV_IMG_CF_RESERVED_17,              /**< Reserved for further use. */
+    LV_IMG_CF_RLE_TRUE_COLOR,       /**< Run-length encoded `LV_IMG_CF_TRUE_COLOR`. Only as variable.*/
+    LV_IMG_CF_RLE_TRUE_COLOR_ALPHA, /**< Run-length encoded `LV_IMG_CF_TRUE_COLOR_ALPHA`. Only as variable.*/
+    LV_IMG_CF_RLE_ALPHA,            /**< Run-length encoded `LV_IMG_CF_ALPHA_8BIT`. Only as variable.*/
     LV_IMG_CF_RESERVED_18,              /**< Reserved for further use. */
     LV_IMG_CF_RESERVED_19,              /**< Reserved for further use. */
     LV_IMG_CF_RESERVED_20,              /**< Reserved for further use. */
@@ -366,6 +375,20 @@ static inline bool _lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_
 
     return ret;
 }
+
+/**
+ * Get the transformed colors and opacities of a horizontal line.
+ * The result is the same as calling `_lv_img_buf_transform` for every pixel of the line
+ * but the zoomed coordinates are stepped incrementally and the color format is checked only once.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel
+ * @param y the y coordinate of the line
+ * @param len number of pixels to transform
+ * @param cbuf store the colors here. Not written where the opacity is `LV_OPA_TRANSP`.
+ * @param abuf store the opacities here. `LV_OPA_TRANSP` if the rotated pixel was out of the image.
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * cbuf, lv_opa_t * abuf);
 #endif
 /**
  * Get the area of a rectangle if its rotated and scaled
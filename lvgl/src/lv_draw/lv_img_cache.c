@@ -16,15 +16,8 @@
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
-
-/*Boost life by this factor (multiply time_to_open with this value)*/
-#define LV_IMG_CACHE_LIFE_GAIN 1
-
-/*Don't let life to be greater than this limit because it would require a lot of time to
- * "die" from very high values */
-#define LV_IMG_CACHE_LIFE_LIMIT 1000
+/*Marks the end of a bucket's list*/
+#define ENTRY_NONE 0xFFFF
 
 /**********************
  *      TYPEDEFS
@@ -35,6 +28,12 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static uint32_t src_hash(const void * src);
+    static uint16_t * get_buckets(void);
+    static void entry_close(lv_img_cache_entry_t * entry);
+    static void entry_touch(lv_img_cache_entry_t * entry);
+    static uint32_t entry_get_size(const lv_img_cache_entry_t * entry);
+    static lv_img_cache_entry_t * find_lru(const lv_img_cache_entry_t * skip);
 #endif
 
 #if LV_IMG_CACHE_DEF_SIZE == 0
@@ -46,6 +45,14 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t bucket_mask;    /*Number of buckets - 1. The number of buckets is a power of 2*/
+    static uint16_t pinned_cnt;
+    static uint32_t use_cnt;        /*Incremented on every use of an entry*/
+    static uint32_t cache_size;     /*Sum of the `size` of the entries*/
+    static uint32_t cache_budget = LV_IMG_CACHE_DEF_BUDGET;
+    static uint32_t hit_cnt;
+    static uint32_t miss_cnt;
+    static uint32_t evict_cnt;
 #endif
 
 /**********************
@@ -76,47 +83,46 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
     }
 
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t * buckets = get_buckets();
 
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
-
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
+    /*Look for the image only among the entries with the same hash*/
+    uint32_t hash = src_hash(src);
+    uint16_t i = buckets[hash & bucket_mask];
+    while(i != ENTRY_NONE) {
+        if(cache[i].hash == hash && color.full == cache[i].dec_dsc.color.full &&
            lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /* If opened increment its life.
-             * Image difficult to open should live longer to keep avoid frequent their recaching.
-             * Therefore increase `life` with `time_to_open`*/
             cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
+            entry_touch(cached_src);
+            hit_cnt++;
             LV_LOG_TRACE("image draw: image found in the cache");
-            break;
+            return cached_src;
         }
+        i = cache[i].next;
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
+    miss_cnt++;
 
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
+    /*The image is not cached then cache it now.
+     *Use an empty entry or the least recently used one*/
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].dec_dsc.src == NULL) {
             cached_src = &cache[i];
+            break;
         }
     }
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+    if(cached_src) {
+        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
     }
     else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
+        cached_src = find_lru(NULL);
+        if(cached_src == NULL) {
+            LV_LOG_WARN("lv_img_cache_open: all entries are pinned");
+            return NULL;
+        }
+        entry_close(cached_src);
+        evict_cnt++;
+        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
     }
 #else
     cached_src = &cache_temp;
@@ -127,12 +133,9 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
         _lv_memset_00(cached_src, sizeof(lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its use  */
         return NULL;
     }
 
-    cached_src->life = 0;
-
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -140,6 +143,26 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Add the entry to its bucket*/
+    cached_src->hash = hash;
+    cached_src->next = buckets[hash & bucket_mask];
+    buckets[hash & bucket_mask] = (uint16_t)(cached_src - cache);
+
+    cached_src->size = entry_get_size(cached_src);
+    cache_size += cached_src->size;
+    entry_touch(cached_src);
+
+    /*Close the least recently used images to fit into the budget*/
+    while(cache_budget && cache_size > cache_budget) {
+        lv_img_cache_entry_t * lru = find_lru(cached_src);
+        if(lru == NULL) break;
+
+        entry_close(lru);
+        evict_cnt++;
+    }
+#endif
+
     return cached_src;
 }
 
@@ -147,6 +170,7 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
  * E.g. if 20 PNG or JPG images are open in the RAM they consume memory while opened in the cache.
+ * The images are closed and unpinned.
  * @param new_entry_cnt number of image to cache
  */
 void lv_img_cache_set_size(uint16_t new_entry_cnt)
@@ -161,17 +185,142 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt);
+    /*`ENTRY_NONE` can't be an index*/
+    if(new_entry_cnt == ENTRY_NONE) new_entry_cnt--;
+
+    /*Have about one bucket per entry*/
+    uint32_t bucket_cnt = 1;
+    while(bucket_cnt < new_entry_cnt) bucket_cnt <<= 1;
+
+    /*Reallocate the cache. The buckets are stored after the entries*/
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt +
+                                                   sizeof(uint16_t) * bucket_cnt);
     LV_ASSERT_MEM(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
         entry_cnt = 0;
         return;
     }
     entry_cnt = new_entry_cnt;
+    bucket_mask = bucket_cnt - 1;
+    pinned_cnt = 0;
+    cache_size = 0;
 
     /*Clean the cache*/
     _lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(lv_img_cache_entry_t));
+    _lv_memset_ff(get_buckets(), bucket_cnt * sizeof(uint16_t));
+#endif
+}
+
+/**
+ * Set the memory budget of the cache.
+ * The least recently used images are closed to keep the estimated memory of the opened images below the budget.
+ * @param budget the budget in bytes. 0: limit the cache only by its number of entries
+ */
+void lv_img_cache_set_budget(uint32_t budget)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(budget);
+    LV_LOG_WARN("Can't set the cache budget because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    cache_budget = budget;
+
+    while(cache_budget && cache_size > cache_budget) {
+        lv_img_cache_entry_t * lru = find_lru(NULL);
+        if(lru == NULL) break;
+
+        entry_close(lru);
+        evict_cnt++;
+    }
+#endif
+}
+
+/**
+ * Open an image and keep it in the cache until it's unpinned or invalidated.
+ * Useful for images which are visible all the time.
+ * At least one entry always remains for the not pinned images.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return LV_RES_OK: the image is pinned; LV_RES_INV: the image can't be opened or there is no free entry
+ */
+lv_res_t lv_img_cache_pin(const void * src, lv_color_t color)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    LV_LOG_WARN("Can't pin an image because the cache is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+    return LV_RES_INV;
+#else
+    /*Already pinned: doesn't need a new entry*/
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].pinned && color.full == cache[i].dec_dsc.color.full &&
+           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
+            return LV_RES_OK;
+        }
+    }
+
+    if(pinned_cnt + 1 >= entry_cnt) {
+        LV_LOG_WARN("lv_img_cache_pin: no more entries can be pinned");
+        return LV_RES_INV;
+    }
+
+    lv_img_cache_entry_t * entry = _lv_img_cache_open(src, color);
+    if(entry == NULL) return LV_RES_INV;
+
+    if(entry->pinned == 0) {
+        entry->pinned = 1;
+        pinned_cnt++;
+    }
+
+    return LV_RES_OK;
+#endif
+}
+
+/**
+ * Let a pinned image be closed again when its entry is needed for other images.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ */
+void lv_img_cache_unpin(const void * src)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].pinned && lv_img_cache_match(src, cache[i].dec_dsc.src)) {
+            cache[i].pinned = 0;
+            pinned_cnt--;
+        }
+    }
+#else
+    LV_UNUSED(src);
+#endif
+}
+
+/**
+ * Give information about the image cache
+ * @param mon_p pointer to an `lv_img_cache_monitor_t` variable, the result will be stored here
+ */
+void lv_img_cache_monitor(lv_img_cache_monitor_t * mon_p)
+{
+    _lv_memset_00(mon_p, sizeof(lv_img_cache_monitor_t));
+
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].dec_dsc.src) mon_p->used_cnt++;
+    }
+
+    mon_p->hit_cnt    = hit_cnt;
+    mon_p->miss_cnt   = miss_cnt;
+    mon_p->evict_cnt  = evict_cnt;
+    mon_p->size       = cache_size;
+    mon_p->budget     = cache_budget;
+    mon_p->entry_cnt  = entry_cnt;
+    mon_p->pinned_cnt = pinned_cnt;
 #endif
 }
 
@@ -187,12 +336,10 @@ void lv_img_cache_invalidate_src(const void * src)
 
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
+        if(cache[i].dec_dsc.src == NULL) continue;
 
-            _lv_memset_00(&cache[i], sizeof(lv_img_cache_entry_t));
+        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
+            entry_close(&cache[i]);
         }
     }
 #endif
@@ -214,4 +361,135 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * Hash an image source: the address of variables, the characters of file names
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @return the hash
+ */
+static uint32_t src_hash(const void * src)
+{
+    uint32_t hash;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
+        hash = (uint32_t)(lv_uintptr_t)src;
+        hash ^= hash >> 4;   /*Variables are aligned so mix in the upper bits*/
+        hash ^= hash >> 12;
+    }
+    else {
+        /*FNV-1a*/
+        const uint8_t * s = src;
+        hash = 2166136261u;
+        while(*s) {
+            hash ^= *s;
+            hash *= 16777619u;
+            s++;
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * Get the bucket table. It's stored after the entries.
+ * @return pointer to the first bucket. A bucket is the index of its first entry or `ENTRY_NONE`
+ */
+static uint16_t * get_buckets(void)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    return (uint16_t *)&cache[entry_cnt];
+}
+
+/**
+ * Close the image of an entry and make the entry empty
+ * @param entry pointer to a used entry
+ */
+static void entry_close(lv_img_cache_entry_t * entry)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t id = (uint16_t)(entry - cache);
+
+    /*Remove from the bucket*/
+    uint16_t * i = &get_buckets()[entry->hash & bucket_mask];
+    while(*i != ENTRY_NONE) {
+        if(*i == id) {
+            *i = entry->next;
+            break;
+        }
+        i = &cache[*i].next;
+    }
+
+    lv_img_decoder_close(&entry->dec_dsc);
+
+    cache_size -= entry->size;
+    if(entry->pinned) pinned_cnt--;
+
+    _lv_memset_00(entry, sizeof(lv_img_cache_entry_t));
+}
+
+/**
+ * Mark an entry as the most recently used one
+ * @param entry pointer to a used entry
+ */
+static void entry_touch(lv_img_cache_entry_t * entry)
+{
+    use_cnt++;
+
+    /*On overflow restart the counting. The order of the entries is lost once in a long while.*/
+    if(use_cnt == 0) {
+        lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+        uint16_t i;
+        for(i = 0; i < entry_cnt; i++) cache[i].last_use = 0;
+        use_cnt = 1;
+    }
+
+    entry->last_use = use_cnt;
+}
+
+/**
+ * Estimate the memory used by an opened image
+ * @param entry pointer to an entry with an opened image
+ * @return the size in bytes
+ */
+static uint32_t entry_get_size(const lv_img_cache_entry_t * entry)
+{
+    const lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+    uint32_t size = 0;
+
+    if(dsc->img_data) {
+        /*The image data of variables are used directly (no extra memory)*/
+        if(dsc->src_type != LV_IMG_SRC_VARIABLE || dsc->img_data != ((const lv_img_dsc_t *)dsc->src)->data) {
+            size += lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+        }
+    }
+
+    /*The copy of the file name*/
+    if(dsc->src_type == LV_IMG_SRC_FILE) size += strlen(dsc->src) + 1;
+
+    /*The buffers of the decoder (e.g. read-ahead buffer of files, palette of indexed images)*/
+    if(dsc->decoder && dsc->decoder->open_cb == lv_img_decoder_built_in_open) {
+        size += lv_img_decoder_built_in_get_buf_size(dsc);
+    }
+
+    return size;
+}
+
+/**
+ * Find the least recently used entry which can be closed
+ * @param skip don't return this entry (can be `NULL`)
+ * @return pointer to the entry or `NULL` if all used entries are pinned
+ */
+static lv_img_cache_entry_t * find_lru(const lv_img_cache_entry_t * skip)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_cache_entry_t * lru = NULL;
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].dec_dsc.src == NULL || cache[i].pinned || &cache[i] == skip) continue;
+
+        if(lru == NULL || cache[i].last_use < lru->last_use) lru = &cache[i];
+    }
+
+    return lru;
+}
 #endif
@@ -31,12 +31,27 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information */
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused */
-    int32_t life;
+    uint32_t last_use;  /**< Value of the usage counter when the entry was used the last time. Smaller is older.*/
+    uint32_t size;      /**< Estimated memory used by the opened image in bytes*/
+    uint32_t hash;      /**< Hash of the image source*/
+    uint16_t next;      /**< Index of the next entry in the same hash bucket*/
+    uint8_t pinned : 1; /**< 1: the entry is never reused for other images*/
 } lv_img_cache_entry_t;
 
+/**
+ * Image cache information structure.
+ */
+typedef struct {
+    uint32_t hit_cnt;    /**< Number of opens served from the cache*/
+    uint32_t miss_cnt;   /**< Number of opens when the image had to be opened by a decoder*/
+    uint32_t evict_cnt;  /**< Number of images closed to make room for other images*/
+    uint32_t size;       /**< Estimated memory used by the cached images in bytes*/
+    uint32_t budget;     /**< Memory budget of the cache in bytes. 0: no limit*/
+    uint16_t entry_cnt;  /**< Number of entries*/
+    uint16_t used_cnt;   /**< Number of entries with an opened image*/
+    uint16_t pinned_cnt; /**< Number of pinned entries*/
+} lv_img_cache_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -55,10 +70,40 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color);
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
  * E.g. if 20 PNG or JPG images are open in the RAM they consume memory while opened in the cache.
+ * The images are closed and unpinned.
  * @param new_entry_cnt number of image to cache
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Set the memory budget of the cache.
+ * The least recently used images are closed to keep the estimated memory of the opened images below the budget.
+ * @param budget the budget in bytes. 0: limit the cache only by its number of entries
+ */
+void lv_img_cache_set_budget(uint32_t budget);
+
+/**
+ * Open an image and keep it in the cache until it's unpinned or invalidated.
+ * Useful for images which are visible all the time.
+ * At least one entry always remains for the not pinned images.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return LV_RES_OK: the image is pinned; LV_RES_INV: the image can't be opened or there is no free entry
+ */
+lv_res_t lv_img_cache_pin(const void * src, lv_color_t color);
+
+/**
+ * Let a pinned image be closed again when its entry is needed for other images.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ */
+void lv_img_cache_unpin(const void * src);
+
+/**
+ * Give information about the image cache
+ * @param mon_p pointer to an `lv_img_cache_monitor_t` variable, the result will be stored here
+ */
+void lv_img_cache_monitor(lv_img_cache_monitor_t * mon_p);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
@@ -16,7 +16,7 @@
  *      DEFINES
  *********************/
 #define CF_BUILT_IN_FIRST LV_IMG_CF_TRUE_COLOR
-#define CF_BUILT_IN_LAST LV_IMG_CF_ALPHA_8BIT
+#define CF_BUILT_IN_LAST LV_IMG_CF_RLE_ALPHA
 
 /**********************
  *      TYPEDEFS
@@ -24,6 +24,12 @@
 typedef struct {
 #if LV_USE_FILESYSTEM
     lv_fs_file_t f;
+#if LV_IMG_FS_CACHE_SIZE
+    uint8_t * fs_cache;         /*Read-ahead buffer of the file*/
+    uint32_t fs_cache_size;     /*Size of `fs_cache`*/
+    uint32_t fs_cache_pos;      /*Position of `fs_cache[0]` in the file*/
+    uint32_t fs_cache_len;      /*Number of valid bytes in `fs_cache`*/
+#endif
 #endif
     lv_color_t * palette;
     lv_opa_t * opa;
@@ -38,6 +44,12 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+static lv_res_t lv_img_decoder_built_in_line_rle(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf);
+#if LV_USE_FILESYSTEM
+static void fs_cache_init(lv_img_decoder_dsc_t * dsc);
+static const uint8_t * fs_cache_read(lv_img_decoder_built_in_data_t * user_data, uint32_t pos, uint32_t len);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -331,6 +343,11 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         /*Support only "*.bin" files*/
         if(strcmp(lv_fs_get_ext(dsc->src), "bin")) return LV_RES_INV;
 
+        if(lv_img_cf_is_rle(dsc->header.cf)) {
+            LV_LOG_WARN("Built-in image decoder can't open run-length encoded images from file");
+            return LV_RES_INV;
+        }
+
         lv_fs_file_t f;
         lv_fs_res_t res = lv_fs_open(&f, dsc->src, LV_FS_MODE_RD);
         if(res != LV_FS_RES_OK) {
@@ -352,6 +369,8 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
         _lv_memcpy_small(&user_data->f, &f, sizeof(f));
+
+        fs_cache_init(dsc);
 #else
         LV_LOG_WARN("Image built-in decoder cannot read file because LV_USE_FILESYSTEM = 0");
         return LV_RES_INV;
@@ -410,14 +429,30 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         if(dsc->src_type == LV_IMG_SRC_FILE) {
             /*Read the palette from file*/
 #if LV_USE_FILESYSTEM
+            /*Read the whole palette at once*/
+            lv_color32_t * palette_buf = _lv_mem_buf_get(palette_size * sizeof(lv_color32_t));
+            if(palette_buf == NULL) {
+                lv_img_decoder_built_in_close(decoder, dsc);
+                return LV_RES_INV;
+            }
+
+            uint32_t br = 0;
             lv_fs_seek(&user_data->f, 4); /*Skip the header*/
-            lv_color32_t cur_color;
+            lv_fs_res_t res = lv_fs_read(&user_data->f, palette_buf, palette_size * sizeof(lv_color32_t), &br);
+            if(res != LV_FS_RES_OK || br != palette_size * sizeof(lv_color32_t)) {
+                LV_LOG_WARN("Built-in image decoder can't read the palette");
+                _lv_mem_buf_release(palette_buf);
+                lv_img_decoder_built_in_close(decoder, dsc);
+                return LV_RES_INV;
+            }
+
             uint32_t i;
             for(i = 0; i < palette_size; i++) {
-                lv_fs_read(&user_data->f, &cur_color, sizeof(lv_color32_t), NULL);
-                user_data->palette[i] = lv_color_make(cur_color.ch.red, cur_color.ch.green, cur_color.ch.blue);
-                user_data->opa[i]     = cur_color.ch.alpha;
+                user_data->palette[i] = lv_color_make(palette_buf[i].ch.red, palette_buf[i].ch.green,
+                                                      palette_buf[i].ch.blue);
+                user_data->opa[i]     = palette_buf[i].ch.alpha;
             }
+            _lv_mem_buf_release(palette_buf);
 #else
             LV_LOG_WARN("Image built-in decoder can read the palette because LV_USE_FILESYSTEM = 0");
             return LV_RES_INV;
@@ -441,6 +476,10 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         return LV_RES_INV;
 #endif
     }
+    /*Run-length encoded images are decoded line by line*/
+    else if(lv_img_cf_is_rle(cf)) {
+        return LV_RES_OK;
+    }
     /*Alpha indexed images. */
     else if(cf == LV_IMG_CF_ALPHA_1BIT || cf == LV_IMG_CF_ALPHA_2BIT || cf == LV_IMG_CF_ALPHA_4BIT ||
             cf == LV_IMG_CF_ALPHA_8BIT) {
@@ -496,6 +535,9 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
             dsc->header.cf == LV_IMG_CF_INDEXED_4BIT || dsc->header.cf == LV_IMG_CF_INDEXED_8BIT) {
         res = lv_img_decoder_built_in_line_indexed(dsc, x, y, len, buf);
     }
+    else if(lv_img_cf_is_rle(dsc->header.cf)) {
+        res = lv_img_decoder_built_in_line_rle(dsc, x, y, len, buf);
+    }
     else {
         LV_LOG_WARN("Built-in image decoder read not supports the color format");
         return LV_RES_INV;
@@ -518,6 +560,9 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
 #if LV_USE_FILESYSTEM
         if(dsc->src_type == LV_IMG_SRC_FILE)
             lv_fs_close(&user_data->f);
+#if LV_IMG_FS_CACHE_SIZE
+        if(user_data->fs_cache) lv_mem_free(user_data->fs_cache);
+#endif
 #endif
         if(user_data->palette) lv_mem_free(user_data->palette);
         if(user_data->opa) lv_mem_free(user_data->opa);
@@ -527,6 +572,28 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
     }
 }
 
+/**
+ * Get the memory the built-in decoder allocated for an opened image, besides the image data.
+ * (Its descriptor data, the read-ahead buffer of files and the palette of indexed images.)
+ * @param dsc pointer to decoder descriptor opened by the built-in decoder
+ * @return the size in bytes
+ */
+uint32_t lv_img_decoder_built_in_get_buf_size(const lv_img_decoder_dsc_t * dsc)
+{
+    const lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    if(user_data == NULL) return 0;
+
+    uint32_t size = sizeof(lv_img_decoder_built_in_data_t);
+#if LV_USE_FILESYSTEM && LV_IMG_FS_CACHE_SIZE
+    if(user_data->fs_cache) size += user_data->fs_cache_size;
+#endif
+    if(user_data->palette) {
+        size += (1 << lv_img_cf_get_px_size(dsc->header.cf)) * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+    }
+
+    return size;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -541,12 +608,19 @@ static lv_res_t lv_img_decoder_built_in_line_true_color(lv_img_decoder_dsc_t * d
 
     uint32_t pos = ((y * dsc->header.w + x) * px_size) >> 3;
     pos += 4; /*Skip the header*/
+    uint32_t btr = len * (px_size >> 3);
+
+    const uint8_t * cached = fs_cache_read(user_data, pos, btr);
+    if(cached) {
+        _lv_memcpy(buf, cached, btr);
+        return LV_RES_OK;
+    }
+
     res = lv_fs_seek(&user_data->f, pos);
     if(res != LV_FS_RES_OK) {
         LV_LOG_WARN("Built-in image decoder seek failed");
         return LV_RES_INV;
     }
-    uint32_t btr = len * (px_size >> 3);
     uint32_t br  = 0;
     res = lv_fs_read(&user_data->f, buf, btr, &br);
     if(res != LV_FS_RES_OK || btr != br) {
@@ -628,8 +702,7 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
 
 #if LV_USE_FILESYSTEM
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
+    uint8_t * fs_buf = NULL;
 #endif
 
     const uint8_t * data_tmp = NULL;
@@ -640,9 +713,15 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
     }
     else {
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(&user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
+        uint32_t btr = (((x * px_size) & 0x7) + len * px_size + 7) >> 3;
+        data_tmp = fs_cache_read(user_data, ofs + 4, btr); /*+4 to skip the header*/
+        if(data_tmp == NULL) {
+            fs_buf = _lv_mem_buf_get(w);
+            if(fs_buf == NULL) return LV_RES_INV;
+            lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
+            lv_fs_read(&user_data->f, fs_buf, w, NULL);
+            data_tmp = fs_buf;
+        }
 #else
         LV_LOG_WARN("Image built-in alpha line reader can't read file because LV_USE_FILESYSTEM = 0");
         data_tmp = NULL; /*To avoid warnings*/
@@ -663,7 +742,7 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
         }
     }
 #if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
 #endif
     return LV_RES_OK;
 #else
@@ -712,8 +791,7 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
 
 #if LV_USE_FILESYSTEM
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
+    uint8_t * fs_buf = NULL;
 #endif
     const uint8_t * data_tmp = NULL;
     if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
@@ -722,9 +800,15 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     }
     else {
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(&user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
+        uint32_t btr = (((x * px_size) & 0x7) + len * px_size + 7) >> 3;
+        data_tmp = fs_cache_read(user_data, ofs + 4, btr); /*+4 to skip the header*/
+        if(data_tmp == NULL) {
+            fs_buf = _lv_mem_buf_get(w);
+            if(fs_buf == NULL) return LV_RES_INV;
+            lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
+            lv_fs_read(&user_data->f, fs_buf, w, NULL);
+            data_tmp = fs_buf;
+        }
 #else
         LV_LOG_WARN("Image built-in indexed line reader can't read file because LV_USE_FILESYSTEM = 0");
         data_tmp = NULL; /*To avoid warnings*/
@@ -757,7 +841,7 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
         }
     }
 #if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
 #endif
     return LV_RES_OK;
 #else
@@ -765,3 +849,140 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     return LV_RES_INV;
 #endif
 }
+
+static lv_res_t lv_img_decoder_built_in_line_rle(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf)
+{
+    lv_img_cf_t cf = dsc->header.cf;
+
+    /*Size of a pixel in the encoded data and in `buf`*/
+    uint8_t px_size;
+    uint8_t buf_px_size;
+    if(cf == LV_IMG_CF_RLE_TRUE_COLOR) {
+        px_size = LV_COLOR_SIZE / 8;
+        buf_px_size = LV_COLOR_SIZE / 8;
+    }
+    else if(cf == LV_IMG_CF_RLE_TRUE_COLOR_ALPHA) {
+        px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+        buf_px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+    else {
+        px_size = 1;
+        buf_px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+
+    /*Alpha only images are decoded to the color of the image and their alpha*/
+    uint8_t alpha_px[LV_IMG_PX_SIZE_ALPHA_BYTE];
+    _lv_memcpy_small(alpha_px, &dsc->color, LV_COLOR_SIZE / 8);
+
+    const uint8_t * data = ((const lv_img_dsc_t *)dsc->src)->data;
+    uint32_t line_ofs;
+    _lv_memcpy_small(&line_ofs, &data[y * sizeof(uint32_t)], sizeof(uint32_t));
+    const uint8_t * p = &data[line_ofs];
+
+    int32_t x_end = x + len - 1;
+    int32_t px_x = 0;
+    while(px_x <= x_end) {
+        uint8_t head = *p;
+        p++;
+        int32_t cnt = (head & LV_IMG_RLE_CNT_MASK) + 1;
+        bool repeat = head & LV_IMG_RLE_REPEAT ? true : false;
+
+        int32_t vx1 = LV_MATH_MAX(px_x, x);
+        int32_t vx2 = LV_MATH_MIN(px_x + cnt - 1, x_end);
+        const uint8_t * px = repeat ? p : p + (vx1 - px_x) * px_size;
+
+        int32_t i;
+        for(i = vx1; i <= vx2; i++) {
+            if(cf == LV_IMG_CF_RLE_ALPHA) {
+                alpha_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = px[0];
+                _lv_memcpy_small(&buf[(i - x) * buf_px_size], alpha_px, buf_px_size);
+            }
+            else {
+                _lv_memcpy_small(&buf[(i - x) * buf_px_size], px, buf_px_size);
+            }
+
+            if(!repeat) px += px_size;
+        }
+
+        p += repeat ? px_size : cnt * px_size;
+        px_x += cnt;
+    }
+
+    return LV_RES_OK;
+}
+
+#if LV_USE_FILESYSTEM
+/**
+ * Allocate the read-ahead cache of an image opened from file.
+ * It's large enough to hold at least one line of the image wherever the line starts in a block.
+ * @param dsc pointer to decoder descriptor. The file is already opened in its user data.
+ */
+static void fs_cache_init(lv_img_decoder_dsc_t * dsc)
+{
+#if LV_IMG_FS_CACHE_SIZE
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    user_data->fs_cache_pos = 0;
+    user_data->fs_cache_len = 0;
+    if(user_data->fs_cache) return; /*Already allocated*/
+
+    uint32_t line_size = ((uint32_t)dsc->header.w * lv_img_cf_get_px_size(dsc->header.cf) + 7) >> 3;
+    uint32_t size = line_size + 2 * LV_IMG_FS_BLOCK_SIZE - 1;
+    size -= size % LV_IMG_FS_BLOCK_SIZE;
+    if(size < LV_IMG_FS_CACHE_SIZE) size = LV_IMG_FS_CACHE_SIZE;
+
+    user_data->fs_cache = lv_mem_alloc(size);
+    if(user_data->fs_cache == NULL) {
+        LV_LOG_WARN("Built-in image decoder: no memory for the file cache. Reading line by line.");
+        size = 0;
+    }
+    user_data->fs_cache_size = size;
+#else
+    LV_UNUSED(dsc);
+#endif
+}
+
+/**
+ * Get data of an image file from the read-ahead cache.
+ * On a miss the cache is refilled with data starting at the block containing `pos`.
+ * @param user_data the built-in decoder's data of the image. The file is opened in it.
+ * @param pos position of the first byte in the file
+ * @param len number of bytes to get
+ * @return pointer to the data or `NULL` if it can't be cached or the read failed
+ */
+static const uint8_t * fs_cache_read(lv_img_decoder_built_in_data_t * user_data, uint32_t pos, uint32_t len)
+{
+#if LV_IMG_FS_CACHE_SIZE
+    if(user_data->fs_cache == NULL) return NULL;
+
+    /*Hit*/
+    if(pos >= user_data->fs_cache_pos && pos + len <= user_data->fs_cache_pos + user_data->fs_cache_len) {
+        return &user_data->fs_cache[pos - user_data->fs_cache_pos];
+    }
+
+    uint32_t start = pos - (pos % LV_IMG_FS_BLOCK_SIZE);
+    if(pos + len - start > user_data->fs_cache_size) return NULL;
+
+    /*Read as much as possible. At the end of the file less data will be read*/
+    uint32_t br = 0;
+    user_data->fs_cache_len = 0;
+    lv_fs_res_t res = lv_fs_seek(&user_data->f, start);
+    if(res == LV_FS_RES_OK) res = lv_fs_read(&user_data->f, user_data->fs_cache, user_data->fs_cache_size, &br);
+    if(res != LV_FS_RES_OK) {
+        LV_LOG_WARN("Built-in image decoder read failed");
+        return NULL;
+    }
+
+    user_data->fs_cache_pos = start;
+    user_data->fs_cache_len = br;
+    if(pos + len > start + br) return NULL;
+
+    return &user_data->fs_cache[pos - start];
+#else
+    LV_UNUSED(user_data);
+    LV_UNUSED(pos);
+    LV_UNUSED(len);
+    return NULL;
+#endif
+}
+#endif
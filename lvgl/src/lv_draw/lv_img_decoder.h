@@ -259,6 +259,14 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
  */
 void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 
+/**
+ * Get the memory the built-in decoder allocated for an opened image, besides the image data.
+ * (Its descriptor data, the read-ahead buffer of files and the palette of indexed images.)
+ * @param dsc pointer to decoder descriptor opened by the built-in decoder
+ * @return the size in bytes
+ */
+uint32_t lv_img_decoder_built_in_get_buf_size(const lv_img_decoder_dsc_t * dsc);
+
 /**********************
  *      MACROS
  **********************/
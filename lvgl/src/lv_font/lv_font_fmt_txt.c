@@ -14,10 +14,19 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_draw/lv_draw_label.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE & (LV_FONT_FMT_TXT_GID_CACHE_SIZE - 1)
+    #error "LV_FONT_FMT_TXT_GID_CACHE_SIZE has to be a power of 2"
+#endif
+
+#if LV_FONT_FMT_TXT_CMAP_PAGES
+    #define CMAP_PAGE_CNT   256     /*Pages of the BMP*/
+    #define CMAP_PAGE_SIZE  256     /*Code points per page*/
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -28,15 +37,71 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE
+/*An entry of the codepoint -> glyph id cache*/
+typedef struct {
+    const lv_font_t * font;
+    uint32_t letter;
+    uint32_t gid;
+} gid_cache_entry_t;
+#endif
+
+#if LV_FONT_FMT_TXT_CMAP_PAGES
+/*Glyph ids of the BMP of a font in pages of `CMAP_PAGE_SIZE` code points*/
+typedef struct {
+    const lv_font_t * font;
+    const uint16_t * pages[CMAP_PAGE_CNT];  /*NULL: not built yet*/
+} cmap_pages_t;
+#endif
+
+#if LV_FONT_FMT_TXT_KERN_HASH
+/*Kerning pairs of a font in an open addressing hash table*/
+typedef struct {
+    const lv_font_t * font;
+    uint32_t * keys;        /*`(gid_left << 16) + gid_right` or 0 for empty slots. NULL: no table*/
+    int8_t * values;        /*Kerning value of the pair in the same slot*/
+    uint8_t shift;          /*32 - log2(slot count)*/
+} kern_hash_t;
+#endif
+
+#if LV_FONT_GLYPH_CACHE_SIZE
+/*A glyph in the glyph cache*/
+typedef struct {
+    const lv_font_t * font;
+    uint32_t gid;
+    uint32_t size;          /*Size of `bitmap` and this descriptor in bytes*/
+    uint8_t * bitmap;       /*8 bit per pixel bitmap of the glyph*/
+} glyph_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+#if LV_FONT_FMT_TXT_CMAP_PAGES
+    static uint32_t cmap_pages_get(const lv_font_t * font, uint32_t letter);
+#endif
+#if LV_FONT_FMT_TXT_KERN_HASH
+    static bool kern_hash_get(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right, int8_t * value);
+    static void kern_hash_build(kern_hash_t * kh, const lv_font_fmt_txt_kern_pair_t * kdsc);
+#endif
+#if LV_FONT_FMT_TXT_CMAP_PAGES || LV_FONT_FMT_TXT_KERN_HASH
+    static void * font_data_get(lv_ll_t * ll, const lv_font_t * font, uint32_t size);
+#endif
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
+#if LV_FONT_GLYPH_CACHE_SIZE
+    static const uint8_t * glyph_cache_get(const lv_font_t * font, uint32_t gid);
+    static const uint8_t * glyph_cache_add(const lv_font_t * font, uint32_t gid, const uint8_t * bitmap,
+                                           uint32_t px_cnt, uint8_t bpp);
+    static void glyph_cache_drop(lv_ll_t * ll, glyph_cache_entry_t * entry);
+    static void expand_to_a8(const uint8_t * in, uint8_t * out, uint32_t px_cnt, uint8_t bpp);
+#endif
+
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
     static inline void decompress_line(uint8_t * out, lv_coord_t w);
@@ -58,6 +123,18 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static rle_state_t rle_state;
 #endif /* LV_USE_FONT_COMPRESSED */
 
+#if LV_FONT_GLYPH_CACHE_SIZE
+    static uint32_t glyph_cache_used;
+#endif
+
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE
+    static gid_cache_entry_t gid_cache[LV_FONT_FMT_TXT_GID_CACHE_SIZE];
+#endif
+
+#if LV_FONT_FMT_TXT_CMAP_PAGES
+    static const uint16_t cmap_empty_page[CMAP_PAGE_SIZE];  /*Shared by the pages without glyphs*/
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -84,10 +161,16 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
     if(!gid) return NULL;
 
+#if LV_FONT_GLYPH_CACHE_SIZE
+    const uint8_t * cached = glyph_cache_get(font, gid);
+    if(cached) return cached;
+#endif
+
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    const uint8_t * bitmap;
 
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
-        return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+        bitmap = &fdsc->glyph_bitmap[gdsc->bitmap_index];
     }
     /*Handle compressed bitmap*/
     else {
@@ -122,14 +205,18 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
         decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
+        bitmap = LV_GC_ROOT(_lv_font_decompr_buf);
 #else /* !LV_USE_FONT_COMPRESSED */
         return NULL;
 #endif
     }
 
-    /*If not returned earlier then the letter is not found in this font*/
-    return NULL;
+#if LV_FONT_GLYPH_CACHE_SIZE
+    /*Store the glyph with 8 bit per pixel because `lv_font_get_glyph_dsc_fmt_txt` reports it that way*/
+    return glyph_cache_add(font, gid, bitmap, gdsc->box_w * gdsc->box_h, (uint8_t)fdsc->bpp);
+#else
+    return bitmap;
+#endif
 }
 
 /**
@@ -176,7 +263,11 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     dsc_out->box_w = gdsc->box_w;
     dsc_out->ofs_x = gdsc->ofs_x;
     dsc_out->ofs_y = gdsc->ofs_y;
+#if LV_FONT_GLYPH_CACHE_SIZE
+    dsc_out->bpp   = 8;  /*The glyph cache stores the bitmaps with 8 bit per pixel*/
+#else
     dsc_out->bpp   = (uint8_t)fdsc->bpp;
+#endif
 
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
 
@@ -194,6 +285,70 @@ void _lv_font_clean_up_fmt_txt(void)
     }
 }
 
+/**
+ * Remove the cached glyph bitmaps, glyph ids, cmap pages and kerning tables of a font.
+ * Should be called before a font is freed or its glyphs are modified.
+ * @param font pointer to a font or `NULL` to empty the whole cache
+ */
+void lv_font_fmt_txt_glyph_cache_invalidate(const lv_font_t * font)
+{
+#if LV_FONT_GLYPH_CACHE_SIZE
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_glyph_cache_ll);
+    if(ll->n_size) {
+        glyph_cache_entry_t * entry = _lv_ll_get_head(ll);
+        while(entry) {
+            glyph_cache_entry_t * next = _lv_ll_get_next(ll, entry);
+            if(font == NULL || entry->font == font) glyph_cache_drop(ll, entry);
+            entry = next;
+        }
+    }
+#endif
+
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_GID_CACHE_SIZE; i++) {
+        if(font == NULL || gid_cache[i].font == font) gid_cache[i].font = NULL;
+    }
+#endif
+
+#if LV_FONT_FMT_TXT_CMAP_PAGES
+    lv_ll_t * pages_ll = &LV_GC_ROOT(_lv_font_cmap_pages_ll);
+    if(pages_ll->n_size) {
+        cmap_pages_t * cp = _lv_ll_get_head(pages_ll);
+        while(cp) {
+            cmap_pages_t * next = _lv_ll_get_next(pages_ll, cp);
+            if(font == NULL || cp->font == font) {
+                uint32_t p;
+                for(p = 0; p < CMAP_PAGE_CNT; p++) {
+                    if(cp->pages[p] && cp->pages[p] != cmap_empty_page) lv_mem_free((void *)cp->pages[p]);
+                }
+                _lv_ll_remove(pages_ll, cp);
+                lv_mem_free(cp);
+            }
+            cp = next;
+        }
+    }
+#endif
+
+#if LV_FONT_FMT_TXT_KERN_HASH
+    lv_ll_t * kern_ll = &LV_GC_ROOT(_lv_font_kern_hash_ll);
+    if(kern_ll->n_size) {
+        kern_hash_t * kh = _lv_ll_get_head(kern_ll);
+        while(kh) {
+            kern_hash_t * next = _lv_ll_get_next(kern_ll, kh);
+            if(font == NULL || kh->font == font) {
+                if(kh->keys) lv_mem_free(kh->keys);
+                _lv_ll_remove(kern_ll, kh);
+                lv_mem_free(kh);
+            }
+            kh = next;
+        }
+    }
+#endif
+
+    LV_UNUSED(font);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -207,6 +362,42 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
     /*Check the cache first*/
     if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
 
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE
+    gid_cache_entry_t * ce = &gid_cache[(letter ^ ((lv_uintptr_t)font >> 4)) & (LV_FONT_FMT_TXT_GID_CACHE_SIZE - 1)];
+    if(ce->font == font && ce->letter == letter) {
+        fdsc->last_letter = letter;
+        fdsc->last_glyph_id = ce->gid;
+        return ce->gid;
+    }
+#endif
+
+    uint32_t glyph_id;
+#if LV_FONT_FMT_TXT_CMAP_PAGES
+    if(letter < CMAP_PAGE_CNT * CMAP_PAGE_SIZE) glyph_id = cmap_pages_get(font, letter);
+    else glyph_id = search_glyph_dsc_id(fdsc, letter);
+#else
+    glyph_id = search_glyph_dsc_id(fdsc, letter);
+#endif
+
+    /*Update the cache*/
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE
+    ce->font = font;
+    ce->letter = letter;
+    ce->gid = glyph_id;
+#endif
+    fdsc->last_letter = letter;
+    fdsc->last_glyph_id = glyph_id;
+    return glyph_id;
+}
+
+/**
+ * Search the glyph id of a letter in the cmaps of a font
+ * @param fdsc pointer to a font descriptor
+ * @param letter an unicode letter
+ * @return the glyph id or 0 if not found
+ */
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -243,17 +434,59 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        fdsc->last_letter = letter;
-        fdsc->last_glyph_id = glyph_id;
         return glyph_id;
     }
 
-    fdsc->last_letter = letter;
-    fdsc->last_glyph_id = 0;
     return 0;
+}
+
+#if LV_FONT_FMT_TXT_CMAP_PAGES
+/**
+ * Get the glyph id of a BMP letter from the font's page table.
+ * The table of the font and the letter's page are built on the first use.
+ * If there is no memory for them the cmaps are searched.
+ * @param font pointer to a font
+ * @param letter an unicode letter, < `CMAP_PAGE_CNT * CMAP_PAGE_SIZE`
+ * @return the glyph id or 0 if not found
+ */
+static uint32_t cmap_pages_get(const lv_font_t * font, uint32_t letter)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *) font->dsc;
+    cmap_pages_t * cp = font_data_get(&LV_GC_ROOT(_lv_font_cmap_pages_ll), font, sizeof(cmap_pages_t));
+    if(cp == NULL) return search_glyph_dsc_id(fdsc, letter);
+
+    uint32_t page_id = letter / CMAP_PAGE_SIZE;
+    const uint16_t * page = cp->pages[page_id];
+    if(page) return page[letter % CMAP_PAGE_SIZE];
+
+    /*Build the page*/
+    uint16_t * new_page = lv_mem_alloc(CMAP_PAGE_SIZE * sizeof(uint16_t));
+    if(new_page == NULL) return search_glyph_dsc_id(fdsc, letter);
+
+    bool empty = true;
+    uint32_t first = page_id * CMAP_PAGE_SIZE;
+    uint32_t i;
+    for(i = 0; i < CMAP_PAGE_SIZE; i++) {
+        uint32_t gid = first + i == 0 ? 0 : search_glyph_dsc_id(fdsc, first + i);
+        if(gid > UINT16_MAX) {
+            /*Can't be stored on 16 bit, keep searching in this page*/
+            lv_mem_free(new_page);
+            return search_glyph_dsc_id(fdsc, letter);
+        }
+        new_page[i] = gid;
+        if(gid) empty = false;
+    }
 
+    if(empty) {
+        lv_mem_free(new_page);
+        cp->pages[page_id] = cmap_empty_page;
+        return 0;
+    }
+
+    cp->pages[page_id] = new_page;
+    return new_page[letter % CMAP_PAGE_SIZE];
 }
+#endif
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
@@ -264,6 +497,9 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
         const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+#if LV_FONT_FMT_TXT_KERN_HASH
+        if(kern_hash_get(font, gid_left, gid_right, &value)) return value;
+#endif
         if(kdsc->glyph_ids_size == 0) {
             /* Use binary search to find the kern value.
              * The pairs are ordered left_id first, then right_id secondly. */
@@ -311,6 +547,124 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     return value;
 }
 
+#if LV_FONT_FMT_TXT_KERN_HASH
+/**
+ * Get the kerning value of a glyph pair from the font's hash table.
+ * The table is built on the first use.
+ * @param font pointer to a font with `lv_font_fmt_txt_kern_pair_t` kerning
+ * @param gid_left glyph id of the left letter
+ * @param gid_right glyph id of the right letter
+ * @param value store the kerning value here
+ * @return false: there is no table (e.g. out of memory), the pairs need to be searched
+ */
+static bool kern_hash_get(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right, int8_t * value)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *) font->dsc;
+    const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+
+    if(kdsc->glyph_ids_size > 1) return false;
+    if(gid_left > UINT16_MAX || gid_right > UINT16_MAX) return false;
+
+    kern_hash_t * kh = font_data_get(&LV_GC_ROOT(_lv_font_kern_hash_ll), font, sizeof(kern_hash_t));
+    if(kh == NULL) return false;
+    if(kh->shift == 0) kern_hash_build(kh, kdsc);
+    if(kh->keys == NULL) return false;
+
+    uint32_t key = (gid_left << 16) + gid_right;
+    uint32_t mask = UINT32_MAX >> kh->shift;
+    uint32_t i = (key * 2654435761U) >> kh->shift;
+    *value = 0;
+    while(kh->keys[i]) {
+        if(kh->keys[i] == key) {
+            *value = kh->values[i];
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+
+    return true;
+}
+
+/**
+ * Fill the kerning hash table of a font from its sorted pair list.
+ * `kh->keys` remains NULL if there is no memory.
+ * @param kh the font's hash table descriptor
+ * @param kdsc the kerning pairs
+ */
+static void kern_hash_build(kern_hash_t * kh, const lv_font_fmt_txt_kern_pair_t * kdsc)
+{
+    /*Keep the load factor <= 75%*/
+    uint32_t slot_cnt = 4;
+    uint8_t bits = 2;
+    while(slot_cnt * 3 < kdsc->pair_cnt * 4) {
+        slot_cnt <<= 1;
+        bits++;
+    }
+
+    kh->shift = 32 - bits;
+    kh->keys = lv_mem_alloc(slot_cnt * (sizeof(uint32_t) + sizeof(int8_t)));
+    if(kh->keys == NULL) return;
+    kh->values = (int8_t *)&kh->keys[slot_cnt];
+    _lv_memset_00(kh->keys, slot_cnt * sizeof(uint32_t));
+
+    uint32_t mask = slot_cnt - 1;
+    uint32_t p;
+    for(p = 0; p < kdsc->pair_cnt; p++) {
+        uint32_t left;
+        uint32_t right;
+        if(kdsc->glyph_ids_size == 0) {
+            const uint8_t * g_ids = kdsc->glyph_ids;
+            left = g_ids[p * 2];
+            right = g_ids[p * 2 + 1];
+        }
+        else {
+            const uint16_t * g_ids = kdsc->glyph_ids;
+            left = g_ids[p * 2];
+            right = g_ids[p * 2 + 1];
+        }
+
+        uint32_t key = (left << 16) + right;
+        if(key == 0) continue;  /*Glyph 0 is reserved, never looked up*/
+
+        uint32_t i = (key * 2654435761U) >> kh->shift;
+        while(kh->keys[i] && kh->keys[i] != key) i = (i + 1) & mask;
+        kh->keys[i] = key;
+        kh->values[i] = kdsc->values[p];
+    }
+}
+#endif
+
+#if LV_FONT_FMT_TXT_CMAP_PAGES || LV_FONT_FMT_TXT_KERN_HASH
+/**
+ * Get the runtime data of a font from a list or add a new zeroed entry if it's not there yet.
+ * The entries have to start with a `const lv_font_t *` field. The last used one is kept at the head.
+ * @param ll pointer to the list
+ * @param font pointer to the font
+ * @param size size of an entry
+ * @return the font's entry or NULL on out of memory
+ */
+static void * font_data_get(lv_ll_t * ll, const lv_font_t * font, uint32_t size)
+{
+    if(ll->n_size == 0) _lv_ll_init(ll, size);
+
+    void * head = _lv_ll_get_head(ll);
+    void * node;
+    _LV_LL_READ(*ll, node) {
+        if(*((const lv_font_t **)node) == font) {
+            if(node != head) _lv_ll_move_before(ll, node, head);
+            return node;
+        }
+    }
+
+    node = _lv_ll_ins_head(ll);
+    if(node == NULL) return NULL;
+
+    _lv_memset_00(node, size);
+    *((const lv_font_t **)node) = font;
+    return node;
+}
+#endif
+
 static int32_t kern_pair_8_compare(const void * ref, const void * element)
 {
     const uint8_t * ref8_p = ref;
@@ -580,3 +934,145 @@ static int32_t unicode_list_compare(const void * ref, const void * element)
 {
     return ((int32_t)(*(uint16_t *)ref)) - ((int32_t)(*(uint16_t *)element));
 }
+
+#if LV_FONT_GLYPH_CACHE_SIZE
+/**
+ * Find a glyph in the glyph cache and make it the most recently used
+ * @param font pointer to the font
+ * @param gid glyph id
+ * @return the 8 bit per pixel bitmap of the glyph or NULL if not cached
+ */
+static const uint8_t * glyph_cache_get(const lv_font_t * font, uint32_t gid)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_glyph_cache_ll);
+    if(ll->n_size == 0) return NULL;
+
+    /*The head is the most recently used*/
+    glyph_cache_entry_t * head = _lv_ll_get_head(ll);
+    glyph_cache_entry_t * entry;
+    _LV_LL_READ(*ll, entry) {
+        if(entry->gid == gid && entry->font == font) {
+            if(entry != head) _lv_ll_move_before(ll, entry, head);
+            return entry->bitmap;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Expand a glyph to 8 bit per pixel and add it to the glyph cache.
+ * The least recently used glyphs are dropped to keep the cache within `LV_FONT_GLYPH_CACHE_SIZE`.
+ * @param font pointer to the font
+ * @param gid glyph id
+ * @param bitmap the packed bitmap of the glyph. Can be `_lv_font_decompr_buf`.
+ * @param px_cnt number of pixels of the glyph
+ * @param bpp bit per pixel of `bitmap`
+ * @return the 8 bit per pixel bitmap. It's in `_lv_font_decompr_buf` if it couldn't be cached.
+ */
+static const uint8_t * glyph_cache_add(const lv_font_t * font, uint32_t gid, const uint8_t * bitmap,
+                                       uint32_t px_cnt, uint8_t bpp)
+{
+    /*Nothing to draw, e.g. space*/
+    if(px_cnt == 0) return bitmap;
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_glyph_cache_ll);
+    if(ll->n_size == 0) {
+        _lv_ll_init(ll, sizeof(glyph_cache_entry_t));
+        glyph_cache_used = 0;
+    }
+
+    /*Count the descriptor too to keep the real memory usage within the limit*/
+    uint32_t size = px_cnt + sizeof(glyph_cache_entry_t);
+    if(size <= LV_FONT_GLYPH_CACHE_SIZE) {
+        /*Drop the least recently used glyphs until the new one fits*/
+        while(glyph_cache_used + size > LV_FONT_GLYPH_CACHE_SIZE) {
+            glyph_cache_drop(ll, _lv_ll_get_tail(ll));
+        }
+
+        uint8_t * a8 = lv_mem_alloc(px_cnt);
+        if(a8) {
+            glyph_cache_entry_t * entry = _lv_ll_ins_head(ll);
+            if(entry) {
+                entry->font = font;
+                entry->gid = gid;
+                entry->size = size;
+                entry->bitmap = a8;
+                glyph_cache_used += size;
+
+                expand_to_a8(bitmap, a8, px_cnt, bpp);
+                return a8;
+            }
+            lv_mem_free(a8);
+        }
+    }
+
+    /*Couldn't cache it: expand into the decompression buffer*/
+    uint8_t * buf = LV_GC_ROOT(_lv_font_decompr_buf);
+    if(_lv_mem_get_size(buf) < px_cnt) {
+        uint8_t * tmp = lv_mem_realloc(buf, px_cnt);
+        LV_ASSERT_MEM(tmp);
+        if(tmp == NULL) return NULL;
+        if(bitmap == buf) bitmap = tmp;
+        LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+        buf = tmp;
+    }
+
+    expand_to_a8(bitmap, buf, px_cnt, bpp);
+    return buf;
+}
+
+/**
+ * Remove a glyph from the glyph cache and free its bitmap
+ * @param ll pointer to the cache's linked list
+ * @param entry the glyph to drop
+ */
+static void glyph_cache_drop(lv_ll_t * ll, glyph_cache_entry_t * entry)
+{
+    glyph_cache_used -= entry->size;
+    lv_mem_free(entry->bitmap);
+    _lv_ll_remove(ll, entry);
+    lv_mem_free(entry);
+}
+
+/**
+ * Expand a packed bitmap to 8 bit per pixel with the same opacity mapping `lv_draw_letter` uses.
+ * Works backward so `in` and `out` can be the same buffer.
+ * @param in the packed bitmap
+ * @param out store the result here. `px_cnt` bytes.
+ * @param px_cnt number of pixels
+ * @param bpp bit per pixel of `in`: 1, 2, 3, 4 or 8
+ */
+static void expand_to_a8(const uint8_t * in, uint8_t * out, uint32_t px_cnt, uint8_t bpp)
+{
+    const uint8_t * opa_table;
+    if(bpp == 3) bpp = 4;   /*3 bpp glyphs are stored on 4 bits*/
+
+    switch(bpp) {
+        case 1:
+            opa_table = _lv_bpp1_opa_table;
+            break;
+        case 2:
+            opa_table = _lv_bpp2_opa_table;
+            break;
+        case 4:
+            opa_table = _lv_bpp4_opa_table;
+            break;
+        case 8:
+            if(in != out) _lv_memcpy(out, in, px_cnt);
+            return;
+        default:
+            _lv_memset_00(out, px_cnt);
+            return;
+    }
+
+    uint8_t mask = (1 << bpp) - 1;
+    uint32_t i = px_cnt;
+    while(i > 0) {
+        i--;
+        uint32_t bit = i * bpp;
+        uint8_t v = (in[bit >> 3] >> (8 - bpp - (bit & 0x7))) & mask;
+        out[i] = opa_table[v];
+    }
+}
+#endif
@@ -220,6 +220,13 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Remove the glyphs of a font from the glyph cache and free its lookup tables.
+ * Should be called before a font is freed or its glyphs are modified.
+ * @param font pointer to a font or `NULL` to empty the whole cache
+ */
+void lv_font_fmt_txt_glyph_cache_invalidate(const lv_font_t * font);
+
 /**********************
  *      MACROS
  **********************/
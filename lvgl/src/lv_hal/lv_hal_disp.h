@@ -115,6 +115,11 @@ typedef struct _disp_drv_t {
      * number of flushed pixels */
     void (*monitor_cb)(struct _disp_drv_t * disp_drv, uint32_t time, uint32_t px);
 
+    /** OPTIONAL: Sort key of an invalidated area. The areas of a refresh are drawn in ascending
+     * order of their keys (areas with equal keys in the order they were invalidated).
+     * E.g. to draw the areas the display's scan line has just passed first */
+    uint32_t (*refr_order_cb)(struct _disp_drv_t * disp_drv, const lv_area_t * area);
+
     /** OPTIONAL: Called periodically while lvgl waits for operation to be completed.
      * For example flushing or GPU
      * User can execute very simple tasks here or yield the task */
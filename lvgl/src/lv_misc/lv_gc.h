@@ -44,6 +44,9 @@ extern "C" {
     f(void * , _lv_theme_mono_styles)                              \
     f(void * , _lv_theme_empty_styles)                             \
     f(uint8_t *, _lv_font_decompr_buf)                             \
+    f(lv_ll_t, _lv_font_glyph_cache_ll)                            \
+    f(lv_ll_t, _lv_font_cmap_pages_ll)                             \
+    f(lv_ll_t, _lv_font_kern_hash_ll)                              \
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
@@ -10,6 +10,7 @@
 #include "lv_txt.h"
 #include "lv_txt_ap.h"
 #include "lv_math.h"
+#include "lv_mem.h"
 #include "lv_log.h"
 #include "lv_debug.h"
 
@@ -18,6 +19,9 @@
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+/*Flags which have effect on the line breaks and line widths*/
+#define LINE_CACHE_FLAGS (LV_TXT_FLAG_RECOLOR | LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -389,6 +393,156 @@ lv_coord_t _lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t
     return width;
 }
 
+/**
+ * Initialize a line cache as invalid
+ * @param cache pointer to a line cache
+ */
+void _lv_txt_line_cache_init(lv_txt_line_cache_t * cache)
+{
+    _lv_memset_00(cache, sizeof(lv_txt_line_cache_t));
+}
+
+/**
+ * Invalidate a line cache and free its lines. Should be called if the text changes in place.
+ * @param cache pointer to a line cache
+ */
+void _lv_txt_line_cache_invalidate(lv_txt_line_cache_t * cache)
+{
+    lv_mem_free(cache->lines);
+    cache->lines = NULL;
+    cache->line_cnt = 0;
+}
+
+/**
+ * Check whether a line cache was built for a text with the given parameters
+ * @param cache pointer to a line cache
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max with of the text
+ * @param flag settings for the text from 'txt_flag_t' enum. The align flags are ignored.
+ * @return true: the lines in `cache` can be used for `txt`
+ */
+bool _lv_txt_line_cache_is_valid(const lv_txt_line_cache_t * cache, const char * txt, const lv_font_t * font,
+                                 lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag)
+{
+    flag &= LINE_CACHE_FLAGS;
+    /*The max. width is not used with these flags*/
+    if(flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    if(cache->lines == NULL) return false;
+    if(cache->txt != txt || cache->font != font) return false;
+    if(cache->letter_space != letter_space || cache->max_w != max_width) return false;
+    if(cache->flag != flag) return false;
+
+    return true;
+}
+
+/**
+ * Rebuild a line cache if it's not valid for the given text and parameters
+ * @param cache pointer to a line cache
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max with of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: `cache` is valid; false: out of memory, the cache is invalid
+ */
+bool _lv_txt_line_cache_update(lv_txt_line_cache_t * cache, const char * txt, const lv_font_t * font,
+                               lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag)
+{
+    if(_lv_txt_line_cache_is_valid(cache, txt, font, letter_space, max_width, flag)) return true;
+
+    _lv_txt_line_cache_invalidate(cache);
+    if(txt == NULL || font == NULL) return false;
+
+    flag &= LINE_CACHE_FLAGS;
+    if(flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    /*Grow the array while breaking the lines and shrink it to the final size at the end*/
+    uint32_t size = 8;
+    lv_txt_line_t * lines = lv_mem_alloc(size * sizeof(lv_txt_line_t));
+    if(lines == NULL) return false;
+
+    uint32_t line_cnt = 0;
+    uint32_t line_start = 0;
+    while(1) {
+        if(line_cnt + 1 > size) {
+            size *= 2;
+            lv_txt_line_t * new_lines = lv_mem_realloc(lines, size * sizeof(lv_txt_line_t));
+            if(new_lines == NULL) {
+                lv_mem_free(lines);
+                return false;
+            }
+            lines = new_lines;
+        }
+
+        lines[line_cnt].start = line_start;
+        if(txt[line_start] == '\0') {
+            lines[line_cnt].w = 0;
+            break;
+        }
+
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_width, flag);
+        lines[line_cnt].w = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+        line_start = line_end;
+        line_cnt++;
+    }
+
+    cache->lines = lv_mem_realloc(lines, (line_cnt + 1) * sizeof(lv_txt_line_t));
+    if(cache->lines == NULL) cache->lines = lines;   /*Shrinking failed, keep the larger array*/
+    cache->line_cnt = line_cnt;
+    cache->txt = txt;
+    cache->font = font;
+    cache->letter_space = letter_space;
+    cache->max_w = max_width;
+    cache->flag = flag;
+
+    return true;
+}
+
+/**
+ * Get the line containing a byte
+ * @param cache pointer to a valid line cache
+ * @param byte_id byte index in the text
+ * @return index of the line. (The last line if `byte_id` is beyond the text)
+ */
+uint32_t _lv_txt_line_cache_get_line(const lv_txt_line_cache_t * cache, uint32_t byte_id)
+{
+    if(cache->line_cnt == 0) return 0;
+
+    /*Binary search for the last line starting at or before `byte_id`*/
+    uint32_t first = 0;
+    uint32_t last = cache->line_cnt - 1;
+    while(first < last) {
+        uint32_t mid = first + (last - first + 1) / 2;
+        if(cache->lines[mid].start <= byte_id) first = mid;
+        else last = mid - 1;
+    }
+
+    return first;
+}
+
+/**
+ * Get the first line whose bottom is not above a `y` coordinate
+ * @param cache pointer to a valid line cache
+ * @param y y coordinate relative to the top of the first line
+ * @param line_height height of a line (the font's line height)
+ * @param line_space space between the lines
+ * @return index of the line or `cache->line_cnt` if `y` is below the last line
+ */
+uint32_t _lv_txt_line_cache_get_line_at(const lv_txt_line_cache_t * cache, lv_coord_t y, lv_coord_t line_height,
+                                        lv_coord_t line_space)
+{
+    if(y <= line_height) return 0;
+
+    int32_t step = line_height + line_space;
+    if(step <= 0) return cache->line_cnt;
+
+    uint32_t line = (y - line_height + step - 1) / step;
+    return LV_MATH_MIN(line, cache->line_cnt);
+}
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
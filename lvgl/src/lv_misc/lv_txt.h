@@ -56,6 +56,27 @@ enum {
 };
 typedef uint8_t lv_txt_cmd_state_t;
 
+/** Start and width of a line in a `lv_txt_line_cache_t`*/
+typedef struct {
+    uint32_t start;     /**< Byte index of the first character of the line*/
+    lv_coord_t w;       /**< Width of the line (as `_lv_txt_get_width` would give it)*/
+} lv_txt_line_t;
+
+/**
+ * Line break index of a text.
+ * Stores where every line starts and how wide it is, so a line can be found
+ * without breaking all the previous lines again.
+ * It is valid only for the text and the parameters it was built with.*/
+typedef struct {
+    lv_txt_line_t * lines;      /**< `line_cnt + 1` lines. The last one starts at the terminating `\0`. NULL if invalid*/
+    uint32_t line_cnt;          /**< Number of lines*/
+    const char * txt;           /**< The text the lines belong to*/
+    const lv_font_t * font;
+    lv_coord_t letter_space;
+    lv_coord_t max_w;
+    lv_txt_flag_t flag;
+} lv_txt_line_cache_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -101,6 +122,63 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coor
 lv_coord_t _lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                              lv_txt_flag_t flag);
 
+/**
+ * Initialize a line cache as invalid
+ * @param cache pointer to a line cache
+ */
+void _lv_txt_line_cache_init(lv_txt_line_cache_t * cache);
+
+/**
+ * Invalidate a line cache and free its lines. Should be called if the text changes in place.
+ * @param cache pointer to a line cache
+ */
+void _lv_txt_line_cache_invalidate(lv_txt_line_cache_t * cache);
+
+/**
+ * Check whether a line cache was built for a text with the given parameters
+ * @param cache pointer to a line cache
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max with of the text
+ * @param flag settings for the text from 'txt_flag_t' enum. The align flags are ignored.
+ * @return true: the lines in `cache` can be used for `txt`
+ */
+bool _lv_txt_line_cache_is_valid(const lv_txt_line_cache_t * cache, const char * txt, const lv_font_t * font,
+                                 lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag);
+
+/**
+ * Rebuild a line cache if it's not valid for the given text and parameters
+ * @param cache pointer to a line cache
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max with of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: `cache` is valid; false: out of memory, the cache is invalid
+ */
+bool _lv_txt_line_cache_update(lv_txt_line_cache_t * cache, const char * txt, const lv_font_t * font,
+                               lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag);
+
+/**
+ * Get the line containing a byte
+ * @param cache pointer to a valid line cache
+ * @param byte_id byte index in the text
+ * @return index of the line. (The last line if `byte_id` is beyond the text)
+ */
+uint32_t _lv_txt_line_cache_get_line(const lv_txt_line_cache_t * cache, uint32_t byte_id);
+
+/**
+ * Get the first line whose bottom is not above a `y` coordinate
+ * @param cache pointer to a valid line cache
+ * @param y y coordinate relative to the top of the first line
+ * @param line_height height of a line (the font's line height)
+ * @param line_space space between the lines
+ * @return index of the line or `cache->line_cnt` if `y` is below the last line
+ */
+uint32_t _lv_txt_line_cache_get_line_at(const lv_txt_line_cache_t * cache, lv_coord_t y, lv_coord_t line_height,
+                                        lv_coord_t line_space);
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
@@ -24,12 +24,38 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/*A dummy display which makes the `lv_draw_...` functions draw into the canvas' buffer*/
+typedef struct {
+    lv_disp_t disp;
+    lv_disp_buf_t disp_buf;
+    lv_disp_t * refr_ori;       /*The refreshing display to restore*/
+    lv_area_t clip;             /*The whole canvas*/
+    lv_area_t inv_area;         /*Bounding box of the drawn primitives*/
+    uint8_t started : 1;        /*1: `disp` is set as the refreshing display*/
+} canvas_draw_ctx_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_res_t lv_canvas_signal(lv_obj_t * canvas, lv_signal_t sign, void * param);
 static void set_set_px_cb(lv_disp_drv_t * disp_drv, lv_img_cf_t cf);
+static void blur(lv_obj_t * canvas, const lv_area_t * area, uint16_t r, uint8_t passes, lv_blur_dir_t dir);
+static void draw_ctx_init(canvas_draw_ctx_t * ctx, const lv_img_dsc_t * dsc);
+static void draw_ctx_start(canvas_draw_ctx_t * ctx, lv_img_dsc_t * dsc, const lv_color_t * color);
+static void draw_ctx_deinit(canvas_draw_ctx_t * ctx);
+static void draw_ctx_add_area(canvas_draw_ctx_t * ctx, const lv_area_t * area);
+static void draw_rect(canvas_draw_ctx_t * ctx, lv_img_dsc_t * dsc, const lv_area_t * coords,
+                      const lv_draw_rect_dsc_t * rect_dsc);
+static void draw_line(canvas_draw_ctx_t * ctx, lv_img_dsc_t * dsc, const lv_point_t * point1,
+                      const lv_point_t * point2, const lv_draw_line_dsc_t * line_dsc);
+static bool rect_is_plain(const lv_area_t * coords, const lv_draw_rect_dsc_t * rect_dsc);
+static bool line_get_area(const lv_point_t * point1, const lv_point_t * point2,
+                          const lv_draw_line_dsc_t * line_dsc, lv_area_t * area);
+static bool fill_direct(lv_img_dsc_t * dsc, const lv_area_t * area, lv_color_t color, lv_opa_t opa);
+static void fill_bits(uint8_t * row, int32_t x1, int32_t x2, uint8_t bpp, uint8_t v);
+static void get_rect_draw_area(const lv_area_t * coords, const lv_draw_rect_dsc_t * rect_dsc, lv_area_t * res);
+static void invalidate_area(lv_obj_t * canvas, const lv_area_t * area);
+static void inv_task_cb(lv_task_t * task);
 
 static void set_px_true_color_alpha(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x,
                                     lv_coord_t y,
@@ -96,6 +122,8 @@ lv_obj_t * lv_canvas_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->dsc.header.w           = 0;
     ext->dsc.data_size          = 0;
     ext->dsc.data               = NULL;
+    ext->inv_task               = NULL;
+    lv_area_set(&ext->inv_area, 0, 0, -1, -1);
 
     lv_img_set_src(new_canvas, &ext->dsc);
 
@@ -164,7 +192,44 @@ void lv_canvas_set_px(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_color_t
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_img_buf_set_px_color(&ext->dsc, x, y, c);
-    lv_obj_invalidate(canvas);
+
+    lv_area_t a;
+    lv_area_set(&a, x, y, x, y);
+    invalidate_area(canvas, &a);
+}
+
+/**
+ * Set the color of several pixels on the canvas.
+ * Only the bounding box of the pixels will be redrawn.
+ * @param canvas pointer to canvas object
+ * @param points coordinates of the pixels
+ * @param colors color of the pixels. `colors[i]` is used for `points[i]`
+ * @param px_cnt number of pixels
+ */
+void lv_canvas_set_px_array(lv_obj_t * canvas, const lv_point_t points[], const lv_color_t colors[], uint32_t px_cnt)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
+    LV_ASSERT_NULL(points);
+    LV_ASSERT_NULL(colors);
+
+    if(px_cnt == 0) return;
+
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    lv_area_t a;
+    lv_area_set(&a, points[0].x, points[0].y, points[0].x, points[0].y);
+
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        lv_img_buf_set_px_color(&ext->dsc, points[i].x, points[i].y, colors[i]);
+
+        if(points[i].x < a.x1) a.x1 = points[i].x;
+        if(points[i].x > a.x2) a.x2 = points[i].x;
+        if(points[i].y < a.y1) a.y1 = points[i].y;
+        if(points[i].y > a.y2) a.y2 = points[i].y;
+    }
+
+    invalidate_area(canvas, &a);
 }
 
 /**
@@ -184,7 +249,7 @@ void lv_canvas_set_palette(lv_obj_t * canvas, uint8_t id, lv_color_t c)
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_img_buf_set_palette(&ext->dsc, id, c);
-    lv_obj_invalidate(canvas);
+    invalidate_area(canvas, NULL);
 }
 
 /*=====================
@@ -226,6 +291,38 @@ lv_img_dsc_t * lv_canvas_get_img(lv_obj_t * canvas)
  * Other functions
  *====================*/
 
+/**
+ * Redraw an area of the canvas, e.g. after its buffer was modified directly.
+ * The areas invalidated before the next refresh are joined and redrawn together.
+ * @param canvas pointer to a canvas object
+ * @param area the changed area relative to the canvas' buffer. `NULL` to redraw the whole canvas.
+ */
+void lv_canvas_invalidate_area(lv_obj_t * canvas, const lv_area_t * area)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
+
+    invalidate_area(canvas, area);
+}
+
+/**
+ * Invalidate the areas marked on the canvases now instead of before the next refresh.
+ * Shouldn't be used directly because it is called in `lv_refr_now()`.
+ */
+void lv_canvas_inv_now(void)
+{
+    lv_task_t * task = lv_task_get_next(NULL);
+    while(task) {
+        if(task->task_cb == inv_task_cb && task->prio != LV_TASK_PRIO_OFF) {
+            inv_task_cb(task);
+            /*It turned itself off, which moved it to the end of the list, so start again*/
+            task = lv_task_get_next(NULL);
+        }
+        else {
+            task = lv_task_get_next(task);
+        }
+    }
+}
+
 /**
  * Copy a buffer to the canvas
  * @param canvas pointer to a canvas object
@@ -256,6 +353,10 @@ void lv_canvas_copy_buf(lv_obj_t * canvas, const void * to_copy, lv_coord_t x, l
         px += ext->dsc.header.w * px_size;
         to_copy8 += w * px_size;
     }
+
+    lv_area_t a;
+    lv_area_set(&a, x, y, x + w - 1, y + h - 1);
+    invalidate_area(canvas, &a);
 }
 
 /**
@@ -289,7 +390,6 @@ void lv_canvas_transform(lv_obj_t * canvas, lv_img_dsc_t * img, int16_t angle, u
 
     int32_t x;
     int32_t y;
-    bool ret;
 
     lv_img_transform_dsc_t dsc;
     dsc.cfg.angle = angle;
@@ -304,12 +404,17 @@ void lv_canvas_transform(lv_obj_t * canvas, lv_img_dsc_t * img, int16_t angle, u
     dsc.cfg.antialias = antialias;
     _lv_img_buf_transform_init(&dsc);
 
+    lv_color_t * line_c = _lv_mem_buf_get(dest_width * sizeof(lv_color_t));
+    lv_opa_t * line_a = _lv_mem_buf_get(dest_width);
+
     for(y = -offset_y; y < dest_height - offset_y; y++) {
-        for(x = -offset_x; x < dest_width - offset_x; x++) {
+        _lv_img_buf_transform_line(&dsc, -offset_x, y, dest_width, line_c, line_a);
 
-            ret = _lv_img_buf_transform(&dsc, x, y);
+        for(x = -offset_x; x < dest_width - offset_x; x++) {
+            if(line_a[x + offset_x] == LV_OPA_TRANSP) continue;
 
-            if(ret == false) continue;
+            dsc.res.color = line_c[x + offset_x];
+            dsc.res.opa = line_a[x + offset_x];
 
             if(x + offset_x >= 0 && x + offset_x < dest_width && y + offset_y >= 0 && y + offset_y < dest_height) {
                 /*If the image has no alpha channel just simple set the result color on the canvas*/
@@ -361,7 +466,10 @@ void lv_canvas_transform(lv_obj_t * canvas, lv_img_dsc_t * img, int16_t angle, u
         }
     }
 
-    lv_obj_invalidate(canvas);
+    _lv_mem_buf_release(line_a);
+    _lv_mem_buf_release(line_c);
+
+    invalidate_area(canvas, NULL);
 #else
     LV_UNUSED(canvas);
     LV_UNUSED(img);
@@ -386,128 +494,7 @@ void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
 {
     LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
 
-    if(r == 0) return;
-
-    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
-
-    lv_area_t a;
-    if(area) {
-        lv_area_copy(&a, area);
-        if(a.x1 < 0) a.x1 = 0;
-        if(a.y1 < 0) a.y1 = 0;
-        if(a.x2 > ext->dsc.header.w - 1) a.x2 = ext->dsc.header.w - 1;
-        if(a.y2 > ext->dsc.header.h - 1) a.y2 = ext->dsc.header.h - 1;
-    }
-    else {
-        a.x1 = 0;
-        a.y1 = 0;
-        a.x2 = ext->dsc.header.w - 1;
-        a.y2 = ext->dsc.header.h - 1;
-    }
-
-    lv_color_t color = lv_obj_get_style_image_recolor(canvas, LV_CANVAS_PART_MAIN);
-
-    uint16_t r_back = r / 2;
-    uint16_t r_front = r / 2;
-
-    if((r & 0x1) == 0) r_back--;
-
-    bool has_alpha = lv_img_cf_has_alpha(ext->dsc.header.cf);
-
-    lv_coord_t line_w = lv_img_buf_get_img_size(ext->dsc.header.w, 1, ext->dsc.header.cf);
-    uint8_t * line_buf = _lv_mem_buf_get(line_w);
-
-    lv_img_dsc_t line_img;
-    line_img.data = line_buf;
-    line_img.header.always_zero = 0;
-    line_img.header.w = ext->dsc.header.w;
-    line_img.header.h = 1;
-    line_img.header.cf = ext->dsc.header.cf;
-
-    lv_coord_t x;
-    lv_coord_t y;
-    lv_coord_t x_safe;
-
-    for(y = a.y1; y <= a.y2; y++) {
-        uint32_t asum = 0;
-        uint32_t rsum = 0;
-        uint32_t gsum = 0;
-        uint32_t bsum = 0;
-
-        lv_color_t c;
-        lv_opa_t opa = LV_OPA_TRANSP;
-        _lv_memcpy(line_buf, &ext->dsc.data[y * line_w], line_w);
-
-        for(x = a.x1 - r_back; x <= a.x1 + r_front; x++) {
-            x_safe = x < 0 ? 0 : x;
-            x_safe = x_safe > ext->dsc.header.w - 1 ? ext->dsc.header.w - 1 : x_safe;
-
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-
-        /*Just to indicate that the px is visible*/
-        if(has_alpha == false) asum = LV_OPA_COVER;
-
-        for(x = a.x1; x <= a.x2; x++) {
-
-            if(asum) {
-                c.ch.red = rsum / r;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-                uint8_t gtmp = gsum / r;
-                c.ch.green_h = gtmp >> 3;
-                c.ch.green_l = gtmp & 0x7;
-#else
-                c.ch.green = gsum / r;
-#endif
-                c.ch.blue = bsum / r;
-                if(has_alpha) opa = asum / r;
-
-                lv_img_buf_set_px_color(&ext->dsc, x, y, c);
-            }
-            if(has_alpha) lv_img_buf_set_px_alpha(&ext->dsc, x, y, opa);
-
-            x_safe = x - r_back;
-            x_safe = x_safe < 0 ? 0 : x_safe;
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum -= c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum -= (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum -= c.ch.green;
-#endif
-            bsum -= c.ch.blue;
-            if(has_alpha) asum -= opa;
-
-            x_safe = x + 1 + r_front;
-            x_safe = x_safe > ext->dsc.header.w - 1 ? ext->dsc.header.w - 1 : x_safe;
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, LV_COLOR_RED);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-    }
-    lv_obj_invalidate(canvas);
-
-    _lv_mem_buf_release(line_buf);
+    blur(canvas, area, r, 1, LV_BLUR_DIR_HOR);
 }
 
 /**
@@ -520,133 +507,21 @@ void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
 {
     LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
 
-    if(r == 0) return;
-
-    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
-
-    lv_area_t a;
-    if(area) {
-        lv_area_copy(&a, area);
-        if(a.x1 < 0) a.x1 = 0;
-        if(a.y1 < 0) a.y1 = 0;
-        if(a.x2 > ext->dsc.header.w - 1) a.x2 = ext->dsc.header.w - 1;
-        if(a.y2 > ext->dsc.header.h - 1) a.y2 = ext->dsc.header.h - 1;
-    }
-    else {
-        a.x1 = 0;
-        a.y1 = 0;
-        a.x2 = ext->dsc.header.w - 1;
-        a.y2 = ext->dsc.header.h - 1;
-    }
-
-    lv_color_t color = lv_obj_get_style_image_recolor(canvas, LV_CANVAS_PART_MAIN);
-
-    uint16_t r_back = r / 2;
-    uint16_t r_front = r / 2;
-
-    if((r & 0x1) == 0) r_back--;
-
-    bool has_alpha = lv_img_cf_has_alpha(ext->dsc.header.cf);
-    lv_coord_t col_w = lv_img_buf_get_img_size(1, ext->dsc.header.h, ext->dsc.header.cf);
-    uint8_t * col_buf = _lv_mem_buf_get(col_w);
-    lv_img_dsc_t line_img;
-
-    line_img.data = col_buf;
-    line_img.header.always_zero = 0;
-    line_img.header.w = 1;
-    line_img.header.h = ext->dsc.header.h;
-    line_img.header.cf = ext->dsc.header.cf;
-
-    lv_coord_t x;
-    lv_coord_t y;
-    lv_coord_t y_safe;
-
-    for(x = a.x1; x <= a.x2; x++) {
-        uint32_t asum = 0;
-        uint32_t rsum = 0;
-        uint32_t gsum = 0;
-        uint32_t bsum = 0;
-
-        lv_color_t c;
-        lv_opa_t opa = LV_OPA_COVER;
-
-        for(y = a.y1 - r_back; y <= a.y1 + r_front; y++) {
-            y_safe = y < 0 ? 0 : y;
-            y_safe = y_safe > ext->dsc.header.h - 1 ? ext->dsc.header.h - 1 : y_safe;
-
-            c = lv_img_buf_get_px_color(&ext->dsc, x, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&ext->dsc, x, y_safe);
-
-            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
-            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-
-        /*Just to indicate that the px is visible*/
-        if(has_alpha == false) asum = LV_OPA_COVER;
-
-        for(y = a.y1; y <= a.y2; y++) {
-            if(asum) {
-                c.ch.red = rsum / r;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-                uint8_t gtmp = gsum / r;
-                c.ch.green_h = gtmp >> 3;
-                c.ch.green_l = gtmp & 0x7;
-#else
-                c.ch.green = gsum / r;
-#endif
-                c.ch.blue = bsum / r;
-                if(has_alpha) opa = asum / r;
-
-                lv_img_buf_set_px_color(&ext->dsc, x, y, c);
-            }
-            if(has_alpha) lv_img_buf_set_px_alpha(&ext->dsc, x, y, opa);
-
-            y_safe = y - r_back;
-            y_safe = y_safe < 0 ? 0 : y_safe;
-            c = lv_img_buf_get_px_color(&line_img, 0, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, 0, y_safe);
-
-            rsum -= c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum -= (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum -= c.ch.green;
-#endif
-            bsum -= c.ch.blue;
-            if(has_alpha) asum -= opa;
-
-            y_safe = y + 1 + r_front;
-            y_safe = y_safe > ext->dsc.header.h - 1 ? ext->dsc.header.h - 1 : y_safe;
-
-            c = lv_img_buf_get_px_color(&ext->dsc, x, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&ext->dsc, x, y_safe);
-
-            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
-            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-    }
+    blur(canvas, area, r, 1, LV_BLUR_DIR_VER);
+}
 
-    lv_obj_invalidate(canvas);
+/**
+ * Apply a Gaussian-like blur on the canvas.
+ * It's approximated by repeating a horizontal and vertical box blur `LV_BLUR_GAUSS_PASSES` times.
+ * @param canvas pointer to a canvas object
+ * @param area the area to blur. If `NULL` the whole canvas will be blurred.
+ * @param r radius of the blur
+ */
+void lv_canvas_blur(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
 
-    _lv_mem_buf_release(col_buf);
+    blur(canvas, area, r, LV_BLUR_GAUSS_PASSES, LV_BLUR_DIR_BOTH);
 }
 
 /**
@@ -660,19 +535,55 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
     LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
 
     lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    lv_img_cf_t cf = dsc->header.cf;
+    uint8_t * buf_u8 = (uint8_t *)dsc->data;
+    uint32_t y;
 
-    if(dsc->header.cf == LV_IMG_CF_INDEXED_1BIT) {
+    if(cf == LV_IMG_CF_INDEXED_1BIT) {
         uint32_t row_byte_cnt = (dsc->header.w + 7) >> 3;
         /*+8 skip the palette*/
         _lv_memset((uint8_t *)dsc->data + 8, color.full ? 0xff : 0x00, row_byte_cnt * dsc->header.h);
     }
-    else if(dsc->header.cf == LV_IMG_CF_ALPHA_1BIT) {
+    else if(cf == LV_IMG_CF_ALPHA_1BIT) {
         uint32_t row_byte_cnt = (dsc->header.w + 7) >> 3;
         _lv_memset((uint8_t *)dsc->data, opa > LV_OPA_50 ? 0xff : 0x00, row_byte_cnt * dsc->header.h);
     }
+    else if(cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        lv_color_fill((lv_color_t *)dsc->data, color, (uint32_t)dsc->header.w * dsc->header.h);
+    }
+    else if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        uint8_t px[LV_IMG_PX_SIZE_ALPHA_BYTE];
+        _lv_memcpy_small(px, &color, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+        px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa;
+
+        uint32_t px_cnt = (uint32_t)dsc->header.w * dsc->header.h;
+        uint32_t i;
+        for(i = 0; i < px_cnt; i++) {
+            _lv_memcpy_small(buf_u8, px, LV_IMG_PX_SIZE_ALPHA_BYTE);
+            buf_u8 += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+    else if((cf >= LV_IMG_CF_INDEXED_2BIT && cf <= LV_IMG_CF_INDEXED_8BIT) ||
+            (cf >= LV_IMG_CF_ALPHA_2BIT && cf <= LV_IMG_CF_ALPHA_8BIT)) {
+        /*Indexed canvases store the palette index, alpha canvases only the opacity*/
+        uint8_t bpp = lv_img_cf_get_px_size(cf);
+        uint32_t stride = ((uint32_t)dsc->header.w * bpp + 7) >> 3;
+        uint8_t v;
+        if(cf <= LV_IMG_CF_INDEXED_8BIT) {
+            buf_u8 += sizeof(lv_color32_t) << bpp; /*Skip the palette*/
+            v = color.full;
+        }
+        else {
+            v = opa >> (8 - bpp);
+        }
+
+        for(y = 0; y < dsc->header.h; y++) {
+            fill_bits(buf_u8, 0, dsc->header.w - 1, bpp, v);
+            buf_u8 += stride;
+        }
+    }
     else {
         uint32_t x;
-        uint32_t y;
         for(y = 0; y < dsc->header.h; y++) {
             for(x = 0; x < dsc->header.w; x++) {
                 lv_img_buf_set_px_color(dsc, x, y, color);
@@ -681,7 +592,7 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
         }
     }
 
-    lv_obj_invalidate(canvas);
+    invalidate_area(canvas, NULL);
 }
 
 /**
@@ -705,53 +616,55 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         return;
     }
 
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
     lv_area_t coords;
     coords.x1 = x;
     coords.y1 = y;
     coords.x2 = x + w - 1;
     coords.y2 = y + h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
+    canvas_draw_ctx_t ctx;
+    draw_ctx_init(&ctx, dsc);
 
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
+    draw_rect(&ctx, dsc, &coords, rect_dsc);
 
-    lv_disp_drv_init(&disp.driver);
+    draw_ctx_deinit(&ctx);
 
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
+    invalidate_area(canvas, &ctx.inv_area);
+}
 
-    set_set_px_cb(&disp.driver, dsc->header.cf);
+/**
+ * Draw several rectangles with the same style on the canvas.
+ * The rectangles share the set up of the drawing, so it's faster than calling
+ * `lv_canvas_draw_rect()` for each of them.
+ * @param canvas pointer to a canvas object
+ * @param areas coordinates of the rectangles
+ * @param area_cnt number of elements in `areas`
+ * @param rect_dsc descriptor of the rectangles
+ */
+void lv_canvas_draw_rects(lv_obj_t * canvas, const lv_area_t areas[], uint32_t area_cnt,
+                          const lv_draw_rect_dsc_t * rect_dsc)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
+    LV_ASSERT_NULL(areas);
 
-#if LV_ANTIALIAS
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
 
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       rect_dsc->bg_color.full == ctransp.full) {
-        disp.driver.antialiasing = 0;
+    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
+        LV_LOG_WARN("lv_canvas_draw_rects: can't draw to LV_IMG_CF_INDEXED canvas");
+        return;
     }
-#endif
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    canvas_draw_ctx_t ctx;
+    draw_ctx_init(&ctx, dsc);
 
-    lv_draw_rect(&coords, &mask, rect_dsc);
+    uint32_t i;
+    for(i = 0; i < area_cnt; i++) {
+        draw_rect(&ctx, dsc, &areas[i], rect_dsc);
+    }
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    draw_ctx_deinit(&ctx);
 
-    lv_obj_invalidate(canvas);
+    invalidate_area(canvas, &ctx.inv_area);
 }
 
 /**
@@ -777,37 +690,15 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         return;
     }
 
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
     lv_area_t coords;
     coords.x1 = x;
     coords.y1 = y;
     coords.x2 = x + max_w - 1;
     coords.y2 = dsc->header.h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-    set_set_px_cb(&disp.driver, dsc->header.cf);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    canvas_draw_ctx_t ctx;
+    draw_ctx_init(&ctx, dsc);
+    draw_ctx_start(&ctx, dsc, NULL);
 
     lv_txt_flag_t flag;
     switch(align) {
@@ -827,11 +718,12 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
 
     label_draw_dsc->flag = flag;
 
-    lv_draw_label(&coords, &mask, label_draw_dsc, txt, NULL);
+    lv_draw_label(&coords, &ctx.clip, label_draw_dsc, txt, NULL);
+    draw_ctx_add_area(&ctx, &coords);
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    draw_ctx_deinit(&ctx);
 
-    lv_obj_invalidate(canvas);
+    invalidate_area(canvas, &ctx.inv_area);
 }
 
 /**
@@ -852,14 +744,6 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
         return;
     }
 
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
     lv_img_header_t header;
     lv_res_t res = lv_img_decoder_get_info(src, &header);
     if(res != LV_RES_OK) {
@@ -873,29 +757,26 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
     coords.x2 = x + header.w - 1;
     coords.y2 = y + header.h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
+    canvas_draw_ctx_t ctx;
+    draw_ctx_init(&ctx, dsc);
+    draw_ctx_start(&ctx, dsc, NULL);
 
-    set_set_px_cb(&disp.driver, dsc->header.cf);
+    lv_draw_img(&coords, &ctx.clip, src, img_draw_dsc);
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
-
-    lv_draw_img(&coords, &mask, src, img_draw_dsc);
+    /*Rotated or zoomed images can be larger*/
+    if(img_draw_dsc->angle || img_draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+        _lv_img_buf_get_transformed_area(&coords, header.w, header.h, img_draw_dsc->angle, img_draw_dsc->zoom,
+                                         &img_draw_dsc->pivot);
+        coords.x1 += x;
+        coords.y1 += y;
+        coords.x2 += x;
+        coords.y2 += y;
+    }
+    draw_ctx_add_area(&ctx, &coords);
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    draw_ctx_deinit(&ctx);
 
-    lv_obj_invalidate(canvas);
+    invalidate_area(canvas, &ctx.inv_area);
 }
 
 /**
@@ -916,49 +797,53 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t
         LV_LOG_WARN("lv_canvas_draw_line: can't draw to LV_IMG_CF_INDEXED canvas");
         return;
     }
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
+    canvas_draw_ctx_t ctx;
+    draw_ctx_init(&ctx, dsc);
 
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
+    uint32_t i;
+    for(i = 1; i < point_cnt; i++) {
+        draw_line(&ctx, dsc, &points[i - 1], &points[i], line_draw_dsc);
+    }
 
-    lv_disp_drv_init(&disp.driver);
+    draw_ctx_deinit(&ctx);
 
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
+    invalidate_area(canvas, &ctx.inv_area);
+}
 
-    set_set_px_cb(&disp.driver, dsc->header.cf);
+/**
+ * Draw several independent lines with the same style on the canvas.
+ * The lines share the set up of the drawing, so it's faster than calling
+ * `lv_canvas_draw_line()` for each of them.
+ * @param canvas pointer to a canvas object
+ * @param points end points of the lines. The i-th line goes from `points[2 * i]` to `points[2 * i + 1]`
+ * @param line_cnt number of lines (`points` has `2 * line_cnt` elements)
+ * @param line_draw_dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ */
+void lv_canvas_draw_lines(lv_obj_t * canvas, const lv_point_t points[], uint32_t line_cnt,
+                          const lv_draw_line_dsc_t * line_draw_dsc)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
+    LV_ASSERT_NULL(points);
 
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       line_draw_dsc->color.full == ctransp.full) {
-        disp.driver.antialiasing = 0;
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+
+    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
+        LV_LOG_WARN("lv_canvas_draw_lines: can't draw to LV_IMG_CF_INDEXED canvas");
+        return;
     }
-#endif
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    canvas_draw_ctx_t ctx;
+    draw_ctx_init(&ctx, dsc);
 
     uint32_t i;
-    for(i = 0; i < point_cnt - 1; i++) {
-        lv_draw_line(&points[i], &points[i + 1], &mask, line_draw_dsc);
+    for(i = 0; i < line_cnt; i++) {
+        draw_line(&ctx, dsc, &points[2 * i], &points[2 * i + 1], line_draw_dsc);
     }
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    draw_ctx_deinit(&ctx);
 
-    lv_obj_invalidate(canvas);
+    invalidate_area(canvas, &ctx.inv_area);
 }
 
 /**
@@ -980,46 +865,28 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32
         return;
     }
 
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
+    canvas_draw_ctx_t ctx;
+    draw_ctx_init(&ctx, dsc);
+    draw_ctx_start(&ctx, dsc, &poly_draw_dsc->bg_color);
 
-    set_set_px_cb(&disp.driver, dsc->header.cf);
+    lv_draw_polygon(points, point_cnt, &ctx.clip, poly_draw_dsc);
 
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       poly_draw_dsc->bg_color.full == ctransp.full) {
-        disp.driver.antialiasing = 0;
+    if(point_cnt > 0) {
+        lv_area_t coords;
+        lv_area_set(&coords, points[0].x, points[0].y, points[0].x, points[0].y);
+        uint32_t i;
+        for(i = 1; i < point_cnt; i++) {
+            lv_area_t p_area;
+            lv_area_set(&p_area, points[i].x, points[i].y, points[i].x, points[i].y);
+            _lv_area_join(&coords, &coords, &p_area);
+        }
+        get_rect_draw_area(&coords, poly_draw_dsc, &coords);
+        draw_ctx_add_area(&ctx, &coords);
     }
-#endif
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
-
-    lv_draw_polygon(points, point_cnt, &mask, poly_draw_dsc);
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    draw_ctx_deinit(&ctx);
 
-    lv_obj_invalidate(canvas);
+    invalidate_area(canvas, &ctx.inv_area);
 }
 
 /**
@@ -1044,46 +911,19 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
         return;
     }
 
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-    set_set_px_cb(&disp.driver, dsc->header.cf);
-
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       arc_draw_dsc->color.full == ctransp.full) {
-        disp.driver.antialiasing = 0;
-    }
-#endif
+    canvas_draw_ctx_t ctx;
+    draw_ctx_init(&ctx, dsc);
+    draw_ctx_start(&ctx, dsc, &arc_draw_dsc->color);
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    lv_draw_arc(x, y, r,  start_angle, end_angle, &ctx.clip, arc_draw_dsc);
 
-    lv_draw_arc(x, y, r,  start_angle, end_angle, &mask, arc_draw_dsc);
+    lv_area_t coords;
+    lv_area_set(&coords, x - r, y - r, x + r - 1, y + r - 1);
+    draw_ctx_add_area(&ctx, &coords);
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    draw_ctx_deinit(&ctx);
 
-    lv_obj_invalidate(canvas);
+    invalidate_area(canvas, &ctx.inv_area);
 }
 
 /**********************
@@ -1107,12 +947,535 @@ static lv_res_t lv_canvas_signal(lv_obj_t * canvas, lv_signal_t sign, void * par
     if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
 
     if(sign == LV_SIGNAL_CLEANUP) {
-        /*Nothing to cleanup. (No dynamically allocated memory in 'ext')*/
+        lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+        if(ext->inv_task) {
+            lv_task_del(ext->inv_task);
+            ext->inv_task = NULL;
+        }
     }
 
     return res;
 }
 
+/**
+ * Blur an area of the canvas and invalidate it
+ * @param canvas pointer to a canvas object
+ * @param area the area to blur. If `NULL` the whole canvas will be blurred.
+ * @param r radius of the blur
+ * @param passes number of times to repeat the box blur
+ * @param dir `LV_BLUR_DIR_HOR/VER/BOTH`
+ */
+static void blur(lv_obj_t * canvas, const lv_area_t * area, uint16_t r, uint8_t passes, lv_blur_dir_t dir)
+{
+    if(r == 0) return;
+
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    lv_area_t a;
+    if(area) {
+        lv_area_copy(&a, area);
+        if(a.x1 < 0) a.x1 = 0;
+        if(a.y1 < 0) a.y1 = 0;
+        if(a.x2 > ext->dsc.header.w - 1) a.x2 = ext->dsc.header.w - 1;
+        if(a.y2 > ext->dsc.header.h - 1) a.y2 = ext->dsc.header.h - 1;
+    }
+    else {
+        a.x1 = 0;
+        a.y1 = 0;
+        a.x2 = ext->dsc.header.w - 1;
+        a.y2 = ext->dsc.header.h - 1;
+    }
+
+    if(a.x1 > a.x2 || a.y1 > a.y2) return;
+
+    lv_color_t color = lv_obj_get_style_image_recolor(canvas, LV_CANVAS_PART_MAIN);
+    _lv_blur_img(&ext->dsc, &a, r, passes, dir, color);
+
+    invalidate_area(canvas, &a);
+}
+
+/**
+ * Initialize a drawing context of the canvas. The dummy display is not created yet.
+ * @param ctx pointer to a drawing context to initialize
+ * @param dsc image descriptor of the canvas
+ */
+static void draw_ctx_init(canvas_draw_ctx_t * ctx, const lv_img_dsc_t * dsc)
+{
+    ctx->clip.x1 = 0;
+    ctx->clip.y1 = 0;
+    ctx->clip.x2 = dsc->header.w - 1;
+    ctx->clip.y2 = dsc->header.h - 1;
+    lv_area_set(&ctx->inv_area, LV_COORD_MAX, LV_COORD_MAX, LV_COORD_MIN, LV_COORD_MIN);
+    ctx->started = 0;
+}
+
+/**
+ * Create a dummy display to fool the `lv_draw_...` functions.
+ * They will think they draw to a real screen but draw to the canvas' buffer instead.
+ * Does nothing if the dummy display of `ctx` is already active.
+ * @param ctx pointer to an initialized drawing context
+ * @param dsc image descriptor of the canvas
+ * @param color the color to draw with or `NULL` to always keep anti-aliasing
+ */
+static void draw_ctx_start(canvas_draw_ctx_t * ctx, lv_img_dsc_t * dsc, const lv_color_t * color)
+{
+    if(ctx->started) return;
+
+    _lv_memset_00(&ctx->disp, sizeof(lv_disp_t));
+
+    lv_disp_buf_init(&ctx->disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
+    lv_area_copy(&ctx->disp_buf.area, &ctx->clip);
+
+    lv_disp_drv_init(&ctx->disp.driver);
+
+    ctx->disp.driver.buffer  = &ctx->disp_buf;
+    ctx->disp.driver.hor_res = dsc->header.w;
+    ctx->disp.driver.ver_res = dsc->header.h;
+
+    set_set_px_cb(&ctx->disp.driver, dsc->header.cf);
+
+#if LV_ANTIALIAS
+    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
+    lv_color_t ctransp = LV_COLOR_TRANSP;
+    if(color && dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
+       color->full == ctransp.full) {
+        ctx->disp.driver.antialiasing = 0;
+    }
+#else
+    (void) color; /*Unused*/
+#endif
+
+    ctx->refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&ctx->disp);
+    ctx->started = 1;
+}
+
+/**
+ * Restore the original refreshing display if the dummy display of `ctx` was started
+ * @param ctx pointer to a drawing context
+ */
+static void draw_ctx_deinit(canvas_draw_ctx_t * ctx)
+{
+    if(ctx->started == 0) return;
+
+    _lv_refr_set_disp_refreshing(ctx->refr_ori);
+    ctx->started = 0;
+}
+
+/**
+ * Add an area to the area to invalidate after drawing
+ * @param ctx pointer to an initialized drawing context
+ * @param area the area where something was drawn
+ */
+static void draw_ctx_add_area(canvas_draw_ctx_t * ctx, const lv_area_t * area)
+{
+    _lv_area_join(&ctx->inv_area, &ctx->inv_area, area);
+}
+
+/**
+ * Draw a rectangle. Plain rectangles are filled directly, the others go through `lv_draw_rect()`.
+ * @param ctx pointer to an initialized drawing context
+ * @param dsc image descriptor of the canvas
+ * @param coords coordinates of the rectangle
+ * @param rect_dsc descriptor of the rectangle
+ */
+static void draw_rect(canvas_draw_ctx_t * ctx, lv_img_dsc_t * dsc, const lv_area_t * coords,
+                      const lv_draw_rect_dsc_t * rect_dsc)
+{
+    lv_area_t draw_area;
+    get_rect_draw_area(coords, rect_dsc, &draw_area);
+    draw_ctx_add_area(ctx, &draw_area);
+
+    if(rect_is_plain(coords, rect_dsc)) {
+        /*Only the background is visible*/
+        if(rect_dsc->bg_opa <= LV_OPA_MIN) return;
+        lv_opa_t opa = rect_dsc->bg_opa > LV_OPA_MAX ? LV_OPA_COVER : rect_dsc->bg_opa;
+        if(fill_direct(dsc, coords, rect_dsc->bg_color, opa)) return;
+    }
+
+    draw_ctx_start(ctx, dsc, &rect_dsc->bg_color);
+    lv_draw_rect(coords, &ctx->clip, rect_dsc);
+}
+
+/**
+ * Draw a line. Horizontal and vertical lines are filled directly, the others go through `lv_draw_line()`.
+ * @param ctx pointer to an initialized drawing context
+ * @param dsc image descriptor of the canvas
+ * @param point1 first point of the line
+ * @param point2 second point of the line
+ * @param line_dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ */
+static void draw_line(canvas_draw_ctx_t * ctx, lv_img_dsc_t * dsc, const lv_point_t * point1,
+                      const lv_point_t * point2, const lv_draw_line_dsc_t * line_dsc)
+{
+    if(line_dsc->width == 0) return;
+    if(line_dsc->opa <= LV_OPA_MIN) return;
+    if(point1->x == point2->x && point1->y == point2->y) return;
+
+    /*`lv_draw_line()` doesn't draw out of this area*/
+    lv_area_t area;
+    area.x1 = LV_MATH_MIN(point1->x, point2->x) - line_dsc->width / 2;
+    area.x2 = LV_MATH_MAX(point1->x, point2->x) + line_dsc->width / 2;
+    area.y1 = LV_MATH_MIN(point1->y, point2->y) - line_dsc->width / 2;
+    area.y2 = LV_MATH_MAX(point1->y, point2->y) + line_dsc->width / 2;
+    draw_ctx_add_area(ctx, &area);
+
+    if(line_get_area(point1, point2, line_dsc, &area)) {
+        if(fill_direct(dsc, &area, line_dsc->color, line_dsc->opa)) return;
+    }
+
+    draw_ctx_start(ctx, dsc, &line_dsc->color);
+    lv_draw_line(point1, point2, &ctx->clip, line_dsc);
+}
+
+/**
+ * Tell whether a rectangle is a simple filled area, i.e. it has no radius, gradient, border, etc.
+ * @param coords coordinates of the rectangle
+ * @param rect_dsc descriptor of the rectangle
+ * @return true: only the background needs to be filled; false: `lv_draw_rect()` is required
+ */
+static bool rect_is_plain(const lv_area_t * coords, const lv_draw_rect_dsc_t * rect_dsc)
+{
+    if(rect_dsc->bg_blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(rect_dsc->bg_grad_dir != LV_GRAD_DIR_NONE &&
+       rect_dsc->bg_color.full != rect_dsc->bg_grad_color.full) return false;
+
+    /*The radius is limited to the half of the shorter side the same way as `lv_draw_rect()` does*/
+    int32_t short_side = LV_MATH_MIN(lv_area_get_width(coords), lv_area_get_height(coords));
+    if(LV_MATH_MIN(rect_dsc->radius, short_side >> 1) != 0) return false;
+
+    if(rect_dsc->border_width != 0 && rect_dsc->border_opa > LV_OPA_MIN &&
+       rect_dsc->border_side != LV_BORDER_SIDE_NONE && rect_dsc->border_post == 0) return false;
+    if(rect_dsc->outline_width != 0 && rect_dsc->outline_opa > LV_OPA_MIN) return false;
+    if(rect_dsc->shadow_width != 0 && rect_dsc->shadow_opa > LV_OPA_MIN) return false;
+    if(rect_dsc->pattern_image != NULL && rect_dsc->pattern_opa > LV_OPA_MIN) return false;
+    if(rect_dsc->value_str != NULL && rect_dsc->value_opa > LV_OPA_MIN) return false;
+
+    return true;
+}
+
+/**
+ * Get the area covered by a horizontal or vertical line.
+ * Uses the same rounding as `lv_draw_line()`.
+ * @param point1 first point of the line
+ * @param point2 second point of the line
+ * @param line_dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ * @param area store the result area here
+ * @return true: the line is a simple filled area; false: `lv_draw_line()` is required
+ */
+static bool line_get_area(const lv_point_t * point1, const lv_point_t * point2,
+                          const lv_draw_line_dsc_t * line_dsc, lv_area_t * area)
+{
+    if(line_dsc->width < 0) return false;
+    if(line_dsc->dash_gap && line_dsc->dash_width) return false;
+    if(line_dsc->round_start || line_dsc->round_end) return false;
+    if(line_dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+
+    int32_t w = line_dsc->width - 1;
+    int32_t w_half0 = w >> 1;
+    int32_t w_half1 = w_half0 + (w & 0x1); /*Compensate rounding error*/
+
+    if(point1->y == point2->y) {
+        area->x1 = LV_MATH_MIN(point1->x, point2->x);
+        area->x2 = LV_MATH_MAX(point1->x, point2->x) - 1;
+        area->y1 = point1->y - w_half1;
+        area->y2 = point1->y + w_half0;
+    }
+    else if(point1->x == point2->x) {
+        area->x1 = point1->x - w_half1;
+        area->x2 = point1->x + w_half0;
+        area->y1 = LV_MATH_MIN(point1->y, point2->y);
+        area->y2 = LV_MATH_MAX(point1->y, point2->y) - 1;
+    }
+    else {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Fill an area of the canvas' buffer with a color without any masks.
+ * The result is the same as `_lv_blend_fill()` would give with the dummy display.
+ * @param dsc image descriptor of the canvas
+ * @param area the area to fill. Will be clipped to the canvas.
+ * @param color fill color
+ * @param opa opacity of the fill
+ * @return true: the area is filled; false: the color format is not supported, use the dummy display
+ */
+static bool fill_direct(lv_img_dsc_t * dsc, const lv_area_t * area, lv_color_t color, lv_opa_t opa)
+{
+    lv_img_cf_t cf = dsc->header.cf;
+    bool true_color = cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+    bool alpha_only = cf >= LV_IMG_CF_ALPHA_1BIT && cf <= LV_IMG_CF_ALPHA_8BIT;
+
+    if(!true_color && !alpha_only && cf != LV_IMG_CF_TRUE_COLOR_ALPHA) return false;
+#if LV_COLOR_SCREEN_TRANSP
+    /*The dummy display mixes with alpha on "screen transparent" builds*/
+    if(true_color && opa <= LV_OPA_MAX) return false;
+#endif
+
+    lv_area_t draw_area;
+    draw_area.x1 = 0;
+    draw_area.y1 = 0;
+    draw_area.x2 = dsc->header.w - 1;
+    draw_area.y2 = dsc->header.h - 1;
+    if(_lv_area_intersect(&draw_area, &draw_area, area) == false) return true;
+
+    /*`_lv_blend_fill()` skips these and the `set_px_cb`s even `LV_OPA_MIN`*/
+    if(opa < LV_OPA_MIN) return true;
+    if(!true_color && opa <= LV_OPA_MIN) return true;
+
+    uint8_t * buf_u8 = (uint8_t *)dsc->data;
+    int32_t draw_area_w = lv_area_get_width(&draw_area);
+    int32_t x;
+    int32_t y;
+
+    if(true_color) {
+        lv_color_t * buf_first = (lv_color_t *)dsc->data + (int32_t)dsc->header.w * draw_area.y1 + draw_area.x1;
+        if(opa > LV_OPA_MAX) {
+            for(y = draw_area.y1; y <= draw_area.y2; y++) {
+                lv_color_fill(buf_first, color, draw_area_w);
+                buf_first += dsc->header.w;
+            }
+        }
+        else {
+            uint16_t color_premult[3];
+            lv_color_premult(color, opa, color_premult);
+            lv_opa_t opa_inv = 255 - opa;
+
+            /*Buffer the result color to avoid recalculating the same color*/
+            lv_color_t last_dest_color = buf_first[0];
+            lv_color_t last_res_color = lv_color_mix_premult(color_premult, last_dest_color, opa_inv);
+            for(y = draw_area.y1; y <= draw_area.y2; y++) {
+                for(x = 0; x < draw_area_w; x++) {
+                    if(last_dest_color.full != buf_first[x].full) {
+                        last_dest_color = buf_first[x];
+                        last_res_color = lv_color_mix_premult(color_premult, last_dest_color, opa_inv);
+                    }
+                    buf_first[x] = last_res_color;
+                }
+                buf_first += dsc->header.w;
+            }
+        }
+    }
+    else if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        uint32_t stride = (uint32_t)dsc->header.w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        uint8_t * buf_first = buf_u8 + stride * draw_area.y1 + draw_area.x1 * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+        /*An opaque color simply overwrites the pixels*/
+        if(opa >= LV_OPA_MAX) {
+            uint8_t px[LV_IMG_PX_SIZE_ALPHA_BYTE];
+            _lv_memcpy_small(px, &color, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+            px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa;
+
+            for(y = draw_area.y1; y <= draw_area.y2; y++) {
+                uint8_t * px_buf = buf_first;
+                for(x = 0; x < draw_area_w; x++) {
+                    _lv_memcpy_small(px_buf, px, LV_IMG_PX_SIZE_ALPHA_BYTE);
+                    px_buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+                }
+                buf_first += stride;
+            }
+        }
+        else {
+            for(y = draw_area.y1; y <= draw_area.y2; y++) {
+                uint8_t * px_buf = buf_first;
+                for(x = 0; x < draw_area_w; x++) {
+                    lv_color_t bg_color;
+                    _lv_memcpy_small(&bg_color, px_buf, sizeof(lv_color_t));
+#if LV_COLOR_SIZE == 32
+                    bg_color.ch.alpha = 0xFF;
+#endif
+                    lv_color_t res_color;
+                    lv_opa_t res_opa;
+                    lv_color_mix_with_alpha(bg_color, px_buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1], color, opa,
+                                            &res_color, &res_opa);
+
+                    _lv_memcpy_small(px_buf, &res_color, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+                    px_buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = res_opa;
+                    px_buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+                }
+                buf_first += stride;
+            }
+        }
+    }
+    else {
+        /*Alpha only canvases store the brightness of the color*/
+        uint8_t br = lv_color_brightness(color);
+        uint8_t bpp = lv_img_cf_get_px_size(cf);
+        uint32_t stride = ((uint32_t)dsc->header.w * bpp + 7) >> 3;
+        uint8_t * buf_first = buf_u8 + stride * draw_area.y1;
+
+        if(opa >= LV_OPA_MAX) {
+            for(y = draw_area.y1; y <= draw_area.y2; y++) {
+                fill_bits(buf_first, draw_area.x1, draw_area.x2, bpp, br >> (8 - bpp));
+                buf_first += stride;
+            }
+        }
+        else if(bpp == 8) {
+            lv_opa_t opa_inv = 255 - opa;
+            for(y = draw_area.y1; y <= draw_area.y2; y++) {
+                for(x = draw_area.x1; x <= draw_area.x2; x++) {
+                    buf_first[x] = (uint16_t)((uint16_t)br * opa + (buf_first[x] * opa_inv)) >> 8;
+                }
+                buf_first += stride;
+            }
+        }
+        else {
+            lv_img_dsc_t d;
+            d.data = dsc->data;
+            d.header.always_zero = 0;
+            d.header.w = dsc->header.w;
+            d.header.h = dsc->header.h;
+            d.header.cf = cf;
+            for(y = draw_area.y1; y <= draw_area.y2; y++) {
+                for(x = draw_area.x1; x <= draw_area.x2; x++) {
+                    set_px_alpha_generic(&d, x, y, color, opa);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Set the pixels of a row with 1, 2, 4 or 8 bit per pixel to the same value
+ * @param row pointer to the first byte of the row
+ * @param x1 first pixel to set
+ * @param x2 last pixel to set
+ * @param bpp bit per pixel: 1, 2, 4 or 8
+ * @param v the value to set (`0 .. 2^bpp - 1`)
+ */
+static void fill_bits(uint8_t * row, int32_t x1, int32_t x2, uint8_t bpp, uint8_t v)
+{
+    uint8_t px_per_byte = 8 / bpp;
+    uint8_t px_mask = (1 << bpp) - 1;
+    v &= px_mask;
+
+    int32_t x = x1;
+
+    /*Set the pixels one by one until a byte boundary*/
+    while(x <= x2 && (x % px_per_byte) != 0) {
+        uint8_t shift = 8 - bpp - (x % px_per_byte) * bpp;
+        row[x / px_per_byte] = (row[x / px_per_byte] & ~(px_mask << shift)) | (v << shift);
+        x++;
+    }
+
+    /*Set the whole bytes at once*/
+    int32_t byte_cnt = (x2 - x + 1) / px_per_byte;
+    if(byte_cnt > 0) {
+        uint8_t byte_v = v;
+        uint8_t i;
+        for(i = bpp; i < 8; i += bpp) byte_v = (byte_v << bpp) | v;
+
+        _lv_memset(&row[x / px_per_byte], byte_v, byte_cnt);
+        x += byte_cnt * px_per_byte;
+    }
+
+    /*Set the remaining pixels*/
+    while(x <= x2) {
+        uint8_t shift = 8 - bpp - (x % px_per_byte) * bpp;
+        row[x / px_per_byte] = (row[x / px_per_byte] & ~(px_mask << shift)) | (v << shift);
+        x++;
+    }
+}
+
+/**
+ * Get the area a rectangle draws to including its shadow and outline.
+ * It's the same what `lv_obj_get_draw_rect_ext_pad_size()` uses for objects.
+ * @param coords coordinates of the rectangle
+ * @param rect_dsc descriptor of the rectangle
+ * @param res store the result area here. Can be the same as `coords`.
+ */
+static void get_rect_draw_area(const lv_area_t * coords, const lv_draw_rect_dsc_t * rect_dsc, lv_area_t * res)
+{
+    /*The value text can be anywhere*/
+    if(rect_dsc->value_str && rect_dsc->value_opa > LV_OPA_MIN) {
+        lv_area_set(res, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MAX, LV_COORD_MAX);
+        return;
+    }
+
+    lv_coord_t s = 0;
+    if(rect_dsc->shadow_width && rect_dsc->shadow_opa > LV_OPA_MIN) {
+        lv_coord_t sh_width = rect_dsc->shadow_width / 2 + 1;   /*The blur adds only half width*/
+        sh_width += rect_dsc->shadow_spread;
+        sh_width += LV_MATH_MAX(LV_MATH_ABS(rect_dsc->shadow_ofs_x), LV_MATH_ABS(rect_dsc->shadow_ofs_y));
+        s = LV_MATH_MAX(s, sh_width);
+    }
+
+    if(rect_dsc->outline_width && rect_dsc->outline_opa > LV_OPA_MIN) {
+        s = LV_MATH_MAX(s, rect_dsc->outline_pad + rect_dsc->outline_width);
+    }
+
+    lv_area_set(res, coords->x1 - s, coords->y1 - s, coords->x2 + s, coords->y2 + s);
+}
+
+/**
+ * Mark an area of the canvas' buffer to redraw.
+ * The areas marked until the next refresh are joined and invalidated together
+ * (or by `lv_canvas_inv_now()` if the refresh is forced with `lv_refr_now()`).
+ * @param canvas pointer to a canvas object
+ * @param area the area relative to the buffer, `NULL` to mark the whole buffer
+ */
+static void invalidate_area(lv_obj_t * canvas, const lv_area_t * area)
+{
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+    if(ext->dsc.header.w == 0 || ext->dsc.header.h == 0) return;
+
+    lv_area_t a;
+    lv_area_set(&a, 0, 0, ext->dsc.header.w - 1, ext->dsc.header.h - 1);
+    if(area && _lv_area_intersect(&a, &a, area) == false) return;
+
+    /*Already marked since the last refresh*/
+    if(ext->inv_task && ext->inv_task->prio != LV_TASK_PRIO_OFF) {
+        _lv_area_join(&ext->inv_area, &ext->inv_area, &a);
+        return;
+    }
+
+    /*The task is kept when it's not needed. (Deleting it would end the current round of the task handler)*/
+    if(ext->inv_task == NULL) {
+        ext->inv_task = lv_task_create(inv_task_cb, 0, LV_TASK_PRIO_OFF, canvas);
+        if(ext->inv_task == NULL) {
+            lv_obj_invalidate(canvas);
+            return;
+        }
+    }
+
+    lv_area_copy(&ext->inv_area, &a);
+    lv_task_set_prio(ext->inv_task, LV_TASK_PRIO_HIGHEST);
+}
+
+/**
+ * Invalidate the marked area of a canvas on the screen. Called once before the refresh.
+ * @param task pointer to the task. Its `user_data` is the canvas.
+ */
+static void inv_task_cb(lv_task_t * task)
+{
+    lv_obj_t * canvas = task->user_data;
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    lv_task_set_prio(task, LV_TASK_PRIO_OFF);   /*Nothing to do until the next change*/
+
+    /*Pixels of the buffer are mapped 1:1 to the screen only without transformations and tiling*/
+    lv_img_ext_t * img_ext = &ext->img;
+    int32_t zoom = (lv_obj_get_style_transform_zoom(canvas, LV_CANVAS_PART_MAIN) * img_ext->zoom) >> 8;
+    int32_t angle = lv_obj_get_style_transform_angle(canvas, LV_CANVAS_PART_MAIN) + img_ext->angle;
+    if(zoom != LV_IMG_ZOOM_NONE || angle != 0 || img_ext->offset.x != 0 || img_ext->offset.y != 0 ||
+       lv_obj_get_width(canvas) != ext->dsc.header.w || lv_obj_get_height(canvas) != ext->dsc.header.h) {
+        lv_obj_invalidate(canvas);
+        return;
+    }
+
+    lv_area_t a;
+    a.x1 = ext->inv_area.x1 + canvas->coords.x1;
+    a.y1 = ext->inv_area.y1 + canvas->coords.y1;
+    a.x2 = ext->inv_area.x2 + canvas->coords.x1;
+    a.y2 = ext->inv_area.y2 + canvas->coords.y1;
+    lv_obj_invalidate_area(canvas, &a);
+}
+
 static void set_set_px_cb(lv_disp_drv_t * disp_drv, lv_img_cf_t cf)
 {
     switch(cf) {
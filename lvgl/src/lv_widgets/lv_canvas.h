@@ -33,6 +33,8 @@ typedef struct {
     lv_img_ext_t img; /*Ext. of ancestor*/
     /*New data for this type */
     lv_img_dsc_t dsc;
+    lv_area_t inv_area;     /*Area of the buffer to invalidate, relative to the buffer*/
+    lv_task_t * inv_task;   /*Invalidates `inv_area` before the next refresh. Its priority is OFF when it's not needed*/
 } lv_canvas_ext_t;
 
 /*Canvas part*/
@@ -80,6 +82,16 @@ void lv_canvas_set_buffer(lv_obj_t * canvas, void * buf, lv_coord_t w, lv_coord_
  */
 void lv_canvas_set_px(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_color_t c);
 
+/**
+ * Set the color of several pixels on the canvas.
+ * Only the bounding box of the pixels will be redrawn.
+ * @param canvas pointer to canvas object
+ * @param points coordinates of the pixels
+ * @param colors color of the pixels. `colors[i]` is used for `points[i]`
+ * @param px_cnt number of pixels
+ */
+void lv_canvas_set_px_array(lv_obj_t * canvas, const lv_point_t points[], const lv_color_t colors[], uint32_t px_cnt);
+
 /**
  * Set the palette color of a canvas with index format. Valid only for `LV_IMG_CF_INDEXED1/2/4/8`
  * @param canvas pointer to canvas object
@@ -116,6 +128,20 @@ lv_img_dsc_t * lv_canvas_get_img(lv_obj_t * canvas);
  * Other functions
  *====================*/
 
+/**
+ * Redraw an area of the canvas, e.g. after its buffer was modified directly.
+ * The areas invalidated before the next refresh are joined and redrawn together.
+ * @param canvas pointer to a canvas object
+ * @param area the changed area relative to the canvas' buffer. `NULL` to redraw the whole canvas.
+ */
+void lv_canvas_invalidate_area(lv_obj_t * canvas, const lv_area_t * area);
+
+/**
+ * Invalidate the areas marked on the canvases now instead of before the next refresh.
+ * Shouldn't be used directly because it is called in `lv_refr_now()`.
+ */
+void lv_canvas_inv_now(void);
+
 /**
  * Copy a buffer to the canvas
  * @param canvas pointer to a canvas object
@@ -164,6 +190,15 @@ void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
  */
 void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
 
+/**
+ * Apply a Gaussian-like blur on the canvas.
+ * It's approximated by repeating a horizontal and vertical box blur `LV_BLUR_GAUSS_PASSES` times.
+ * @param canvas pointer to a canvas object
+ * @param area the area to blur. If `NULL` the whole canvas will be blurred.
+ * @param r radius of the blur
+ */
+void lv_canvas_blur(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
+
 /**
  * Fill the canvas with color
  * @param canvas pointer to a canvas
@@ -184,6 +219,18 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa);
 void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h,
                          const lv_draw_rect_dsc_t * rect_dsc);
 
+/**
+ * Draw several rectangles with the same style on the canvas.
+ * The rectangles share the set up of the drawing, so it's faster than calling
+ * `lv_canvas_draw_rect()` for each of them.
+ * @param canvas pointer to a canvas object
+ * @param areas coordinates of the rectangles
+ * @param area_cnt number of elements in `areas`
+ * @param rect_dsc descriptor of the rectangles
+ */
+void lv_canvas_draw_rects(lv_obj_t * canvas, const lv_area_t areas[], uint32_t area_cnt,
+                          const lv_draw_rect_dsc_t * rect_dsc);
+
 /**
  * Draw a text on the canvas.
  * @param canvas pointer to a canvas object
@@ -219,6 +266,18 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
 void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t point_cnt,
                          const lv_draw_line_dsc_t * line_draw_dsc);
 
+/**
+ * Draw several independent lines with the same style on the canvas.
+ * The lines share the set up of the drawing, so it's faster than calling
+ * `lv_canvas_draw_line()` for each of them.
+ * @param canvas pointer to a canvas object
+ * @param points end points of the lines. The i-th line goes from `points[2 * i]` to `points[2 * i + 1]`
+ * @param line_cnt number of lines (`points` has `2 * line_cnt` elements)
+ * @param line_draw_dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ */
+void lv_canvas_draw_lines(lv_obj_t * canvas, const lv_point_t points[], uint32_t line_cnt,
+                          const lv_draw_line_dsc_t * line_draw_dsc);
+
 /**
  * Draw a polygon on the canvas
  * @param canvas pointer to a canvas object
@@ -30,6 +30,9 @@
 #define LV_CHART_LABEL_ITERATOR_FORWARD 1
 #define LV_CHART_LABEL_ITERATOR_REVERSE 0
 
+/*Draw the min/max of the points instead of every point if there are at least this many points per pixel*/
+#define LV_CHART_DEC_PPC_MIN 2
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -49,12 +52,28 @@ static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param
 static lv_style_list_t * lv_chart_get_style(lv_obj_t * chart, uint8_t part);
 
 static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * mask);
+static void draw_div_lines(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area,
+                           lv_style_int_t border_width);
 static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
+static void draw_series_line_dec(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * series_area,
+                                 const lv_area_t * series_mask, const lv_draw_line_dsc_t * line_dsc,
+                                 const lv_draw_rect_dsc_t * area_dsc, lv_draw_mask_fade_param_t * mask_fade_p);
 static void draw_series_column(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
+static void draw_series_scroll(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
 static void draw_cursors(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
 static void draw_axes(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * mask);
 static void invalidate_lines(lv_obj_t * chart, uint16_t i);
 static void invalidate_columns(lv_obj_t * chart, uint16_t i);
+static void invalidate_series(lv_obj_t * chart);
+static lv_coord_t get_line_x(lv_obj_t * chart, lv_coord_t w, uint16_t i);
+static bool scroll_buf_usable(lv_obj_t * chart, const lv_area_t * series_area);
+static bool scroll_buf_prepare(lv_obj_t * chart, const lv_area_t * series_area, lv_area_t * old_area);
+static void scroll_buf_copy(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * area, bool save);
+static lv_coord_t scroll_buf_get_margin(lv_obj_t * chart);
+static bool dec_update(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t w);
+static void dec_update_point(lv_obj_t * chart, lv_chart_series_t * ser, uint16_t id);
+static void dec_get_min_max(const lv_coord_t * points, uint16_t first, uint16_t last, lv_coord_t * min,
+                            lv_coord_t * max);
 static void get_next_axis_label(lv_chart_label_iterator_t * iterator, char * buf);
 static inline bool is_tick_with_label(uint8_t tick_num, lv_chart_axis_cfg_t * axis);
 static lv_chart_label_iterator_t create_axis_label_iter(const char * list, uint8_t iterator_dir);
@@ -111,6 +130,12 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->point_cnt             = LV_CHART_PNUM_DEF;
     ext->type                  = LV_CHART_TYPE_LINE;
     ext->update_mode           = LV_CHART_UPDATE_MODE_SHIFT;
+    ext->scroll_buf            = NULL;
+    ext->scroll_buf_size       = 0;
+    ext->scroll_head           = 0;
+    ext->scroll_strip          = 0;
+    ext->scroll_rows           = 0;
+    lv_area_set(&ext->scroll_area, 0, 0, -1, -1);
     _lv_memset_00(&ext->x_axis, sizeof(ext->x_axis));
     _lv_memset_00(&ext->y_axis, sizeof(ext->y_axis));
     _lv_memset_00(&ext->secondary_y_axis, sizeof(ext->secondary_y_axis));
@@ -194,6 +219,10 @@ lv_chart_series_t * lv_chart_add_series(lv_obj_t * chart, lv_color_t color)
     }
 
     ser->start_point = 0;
+    ser->scroll_start = 0;
+    ser->dec_buf = NULL;
+    ser->dec_bin_cnt = 0;
+    ser->dec_ppc = 0;
     ser->ext_buf_assigned = false;
     ser->hidden = 0;
     ser->y_axis = LV_CHART_AXIS_PRIMARY_Y;
@@ -221,6 +250,7 @@ void lv_chart_remove_series(lv_obj_t * chart, lv_chart_series_t * series)
     if(chart == NULL || series == NULL) return;
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
     if(!series->ext_buf_assigned && series->points) lv_mem_free(series->points);
+    if(series->dec_buf) lv_mem_free(series->dec_buf);
 
     _lv_ll_remove(&ext->series_ll, series);
     lv_mem_free(series);
@@ -272,6 +302,7 @@ void lv_chart_clear_series(lv_obj_t * chart, lv_chart_series_t * series)
     }
 
     series->start_point = 0;
+    series->dec_ppc = 0;
 }
 
 /**
@@ -472,11 +503,21 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y)
     if(ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT) {
         ser->points[ser->start_point] =
             y; /*This was the place of the former left most value, after shifting it is the rightmost*/
+        dec_update_point(chart, ser, ser->start_point);
         ser->start_point = (ser->start_point + 1) % ext->point_cnt;
-        lv_chart_refresh(chart);
+        lv_obj_invalidate(chart);
+    }
+    else if(ext->update_mode == LV_CHART_UPDATE_MODE_SCROLL) {
+        ser->points[ser->start_point] = y;
+        dec_update_point(chart, ser, ser->start_point);
+        ser->start_point = (ser->start_point + 1) % ext->point_cnt;
+
+        /*Keep the scroll buffer. The design function will see how much the series were shifted*/
+        invalidate_series(chart);
     }
     else if(ext->update_mode == LV_CHART_UPDATE_MODE_CIRCULAR) {
         ser->points[ser->start_point] = y;
+        dec_update_point(chart, ser, ser->start_point);
 
         if(ext->type & LV_CHART_TYPE_LINE) invalidate_lines(chart, ser->start_point);
         if(ext->type & LV_CHART_TYPE_COLUMN) invalidate_columns(chart, ser->start_point);
@@ -498,7 +539,30 @@ void lv_chart_set_update_mode(lv_obj_t * chart, lv_chart_update_mode_t update_mo
     if(ext->update_mode == update_mode) return;
 
     ext->update_mode = update_mode;
-    lv_obj_invalidate(chart);
+    lv_chart_refresh(chart);
+}
+
+/**
+ * Set a buffer to keep the drawn series area in `LV_CHART_UPDATE_MODE_SCROLL`.
+ * With the buffer `lv_chart_set_next` draws only the new part of the lines and copies the rest
+ * shifted to the left from the buffer.
+ * It's used only with `LV_CHART_TYPE_LINE` and requires a background under the series area
+ * which looks the same in every column (e.g. no horizontal gradient or rounded corners).
+ * The division lines and the border of the series background are drawn above the lines.
+ * Call `lv_chart_refresh` if the data is modified other than with `lv_chart_set_next`.
+ * @param chart pointer to a chart object
+ * @param buf a buffer with `LV_CHART_SCROLL_BUF_SIZE(w, h)` size where `w` and `h` is the size of
+ *            the series area. `NULL` to not use a buffer.
+ * @param buf_size size of `buf` in bytes. If the series area doesn't fit the buffer is not used.
+ */
+void lv_chart_set_scroll_buffer(lv_obj_t * chart, lv_color_t * buf, uint32_t buf_size)
+{
+    LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    ext->scroll_buf = buf;
+    ext->scroll_buf_size = buf ? buf_size : 0;
+    lv_chart_refresh(chart);
 }
 
 /**
@@ -628,6 +692,7 @@ void lv_chart_set_x_start_point(lv_obj_t * chart, lv_chart_series_t * ser, uint1
     if(ext == NULL) return;
     if(id >= ext->point_cnt) return;
     ser->start_point = id;
+    lv_chart_refresh(chart);    /*Draw the series again instead of shifting the scroll buffer*/
 }
 
 /**
@@ -649,6 +714,12 @@ void lv_chart_set_ext_array(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_
     ser->ext_buf_assigned = true;
     ser->points = array;
     ext->point_cnt = point_cnt;
+
+    /*The point count of every series has changed*/
+    lv_chart_series_t * ser_i;
+    _LV_LL_READ(ext->series_ll, ser_i) {
+        ser_i->dec_ppc = 0;
+    }
 }
 
 /**
@@ -668,6 +739,7 @@ void lv_chart_set_point_id(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t
     if(ext == NULL) return;
     if(id >= ext->point_cnt) return;
     ser->points[id] = value;
+    dec_update_point(chart, ser, id);
 }
 
 /**
@@ -814,6 +886,12 @@ uint16_t lv_chart_get_nearest_index_from_coord(lv_obj_t * chart, lv_coord_t x)
 
     if(x < 0) return 0;
     if(x > w) return ext->point_cnt - 1;
+    if(ext->type == LV_CHART_TYPE_LINE && ext->update_mode == LV_CHART_UPDATE_MODE_SCROLL &&
+       ext->point_cnt >= 2 && w >= ext->point_cnt - 1) {
+        lv_coord_t pitch = w / (ext->point_cnt - 1);
+        int32_t back = (w - x + pitch / 2) / pitch;     /*Number of points from the right*/
+        return back >= ext->point_cnt ? 0 : ext->point_cnt - 1 - back;
+    }
     if(ext->type == LV_CHART_TYPE_LINE) return (x * (ext->point_cnt - 1) + w / 2) / w;
     if(ext->type == LV_CHART_TYPE_COLUMN) return (x * ext->point_cnt) / w;
 
@@ -847,7 +925,7 @@ lv_coord_t lv_chart_get_x_from_index(lv_obj_t * chart, lv_chart_series_t * ser,
     lv_coord_t x = 0;
 
     if(ext->type & LV_CHART_TYPE_LINE) {
-        x = (w * id) / (ext->point_cnt - 1);
+        x = get_line_x(chart, w, id);
     }
     else if(ext->type & LV_CHART_TYPE_COLUMN) {
         lv_coord_t col_w = w / ((_lv_ll_get_len(&ext->series_ll) + 1) * ext->point_cnt); /* Suppose + 1 series as separator*/
@@ -925,6 +1003,15 @@ void lv_chart_refresh(lv_obj_t * chart)
 {
     LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
 
+    /*The content of the scroll buffer and the min/max values might be outdated*/
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    ext->scroll_rows = 0;
+
+    lv_chart_series_t * ser;
+    _LV_LL_READ(ext->series_ll, ser) {
+        ser->dec_ppc = 0;
+    }
+
     lv_obj_invalidate(chart);
 }
 
@@ -957,12 +1044,18 @@ static lv_design_res_t lv_chart_design(lv_obj_t * chart, const lv_area_t * clip_
         lv_area_t series_area;
         lv_chart_get_series_area(chart, &series_area);
 
-        draw_series_bg(chart, &series_area, clip_area);
-        draw_axes(chart, &series_area, clip_area);
+        if(scroll_buf_usable(chart, &series_area)) {
+            draw_series_scroll(chart, &series_area, clip_area);
+            draw_axes(chart, &series_area, clip_area);
+        }
+        else {
+            draw_series_bg(chart, &series_area, clip_area);
+            draw_axes(chart, &series_area, clip_area);
 
-        lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
-        if(ext->type & LV_CHART_TYPE_LINE) draw_series_line(chart, &series_area, clip_area);
-        if(ext->type & LV_CHART_TYPE_COLUMN) draw_series_column(chart, &series_area, clip_area);
+            lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+            if(ext->type & LV_CHART_TYPE_LINE) draw_series_line(chart, &series_area, clip_area);
+            if(ext->type & LV_CHART_TYPE_COLUMN) draw_series_column(chart, &series_area, clip_area);
+        }
         draw_cursors(chart, &series_area, clip_area);
 
     }
@@ -998,6 +1091,7 @@ static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param
             ser = _lv_ll_get_head(&ext->series_ll);
 
             if(!ser->ext_buf_assigned) lv_mem_free(ser->points);
+            if(ser->dec_buf) lv_mem_free(ser->dec_buf);
 
             _lv_ll_remove(&ext->series_ll, ser);
             lv_mem_free(ser);
@@ -1008,6 +1102,9 @@ static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param
         lv_obj_clean_style_list(chart, LV_CHART_PART_CURSOR);
         lv_obj_clean_style_list(chart, LV_CHART_PART_SERIES_BG);
     }
+    else if(sign == LV_SIGNAL_STYLE_CHG) {
+        ext->scroll_rows = 0;
+    }
 
     return res;
 }
@@ -1058,6 +1155,19 @@ static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, cons
     lv_obj_init_draw_rect_dsc(chart, LV_CHART_PART_SERIES_BG, &bg_dsc);
     lv_draw_rect(series_area, clip_area, &bg_dsc);
 
+    draw_div_lines(chart, series_area, clip_area, bg_dsc.border_width);
+}
+
+/**
+ * Draw the division lines of the series area
+ * @param chart pointer to chart object
+ * @param series_area the series area
+ * @param clip_area mask, inherited from the design function
+ * @param border_width border width of the series background. The side lines are not drawn if there is border.
+ */
+static void draw_div_lines(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area,
+                           lv_style_int_t border_width)
+{
     lv_chart_ext_t * ext     = lv_obj_get_ext_attr(chart);
 
     uint8_t div_i;
@@ -1076,7 +1186,7 @@ static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, cons
 
     if(ext->hdiv_cnt != 0) {
         /*Draw side lines if no border*/
-        if(bg_dsc.border_width != 0) {
+        if(border_width != 0) {
             div_i_start = 1;
             div_i_end   = ext->hdiv_cnt;
         }
@@ -1097,7 +1207,7 @@ static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, cons
 
     if(ext->vdiv_cnt != 0) {
         /*Draw side lines if no border*/
-        if(bg_dsc.border_width != 0) {
+        if(border_width != 0) {
             div_i_start = 1;
             div_i_end   = ext->vdiv_cnt;
         }
@@ -1123,8 +1233,16 @@ static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, cons
  */
 static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area)
 {
+    lv_coord_t point_radius = lv_obj_get_style_size(chart, LV_CHART_PART_SERIES);
+
+    /*The points can hang out of the series area*/
     lv_area_t com_area;
-    if(_lv_area_intersect(&com_area, series_area, clip_area) == false) return;
+    lv_area_copy(&com_area, series_area);
+    com_area.x1 -= point_radius;
+    com_area.y1 -= point_radius;
+    com_area.x2 += point_radius;
+    com_area.y2 += point_radius;
+    if(_lv_area_intersect(&com_area, &com_area, clip_area) == false) return;
 
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
 
@@ -1139,7 +1257,6 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
 
     lv_area_t series_mask;
     bool mask_ret = _lv_area_intersect(&series_mask, series_area, clip_area);
-    if(mask_ret == false) return;
 
     lv_draw_line_dsc_t line_dsc;
     lv_draw_line_dsc_init(&line_dsc);
@@ -1167,8 +1284,6 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
     point_dsc.bg_opa = line_dsc.opa;
     point_dsc.radius = LV_RADIUS_CIRCLE;
 
-    lv_coord_t point_radius = lv_obj_get_style_size(chart, LV_CHART_PART_SERIES);
-
     /*Do not bother with line ending is the point will over it*/
     if(point_radius > line_dsc.width / 2) line_dsc.raw_end = 1;
 
@@ -1180,7 +1295,14 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
         area_dsc.bg_color = ser->color;
         area_dsc.bg_grad_color = ser->color;
 
-        lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+        /*With much more points than pixels draw only the min/max of the points in each column*/
+        if(dec_update(chart, ser, w)) {
+            draw_series_line_dec(chart, ser, series_area, mask_ret ? &series_mask : NULL, &line_dsc,
+                                 has_area ? &area_dsc : NULL, has_fade ? &mask_fade_p : NULL);
+            continue;
+        }
+
+        lv_coord_t start_point = ext->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
 
         p1.x = 0 + x_ofs;
         p2.x = 0 + x_ofs;
@@ -1195,7 +1317,7 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
             p1.x = p2.x;
             p1.y = p2.y;
 
-            p2.x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
+            p2.x = get_line_x(chart, w, i) + x_ofs;
 
             p_act = (start_point + i) % ext->point_cnt;
 
@@ -1204,7 +1326,8 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
             p2.y  = h - y_tmp + y_ofs;
 
             /*Don't draw the first point. A second point is also required to draw the line*/
-            if(i != 0 && ser->points[p_prev] != LV_CHART_POINT_DEF && ser->points[p_act] != LV_CHART_POINT_DEF) {
+            if(i != 0 && mask_ret && ser->points[p_prev] != LV_CHART_POINT_DEF &&
+               ser->points[p_act] != LV_CHART_POINT_DEF) {
                 lv_draw_line(&p1, &p2, &series_mask, &line_dsc);
 
                 lv_coord_t y_top = LV_MATH_MIN(p1.y, p2.y);
@@ -1269,6 +1392,99 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
     }
 }
 
+/**
+ * Draw a data line using the min/max values of the points in each pixel column.
+ * The points are not drawn as they would cover each other.
+ * @param chart pointer to chart object
+ * @param ser the series to draw. Its `dec_buf` needs to be up to date.
+ * @param series_area the series area
+ * @param series_mask the series area on the clip area. `NULL` if they have no common part.
+ * @param line_dsc line descriptor with the series' color
+ * @param area_dsc descriptor to draw the area under the line or `NULL`
+ * @param mask_fade_p parameter of the fade mask to use when drawing the area or `NULL`
+ */
+static void draw_series_line_dec(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * series_area,
+                                 const lv_area_t * series_mask, const lv_draw_line_dsc_t * line_dsc,
+                                 const lv_draw_rect_dsc_t * area_dsc, lv_draw_mask_fade_param_t * mask_fade_p)
+{
+    if(series_mask == NULL) return;
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+
+    lv_coord_t w     = lv_area_get_width(series_area);
+    lv_coord_t h     = lv_area_get_height(series_area);
+    lv_coord_t x_ofs = series_area->x1;
+    lv_coord_t y_ofs = series_area->y1;
+    int32_t ymin = ext->ymin[ser->y_axis];
+    int32_t yrange = ext->ymax[ser->y_axis] - ext->ymin[ser->y_axis];
+    uint16_t point_cnt = ext->point_cnt;
+    uint16_t ppc = ser->dec_ppc;
+
+    lv_point_t p1;
+    lv_point_t p2;
+    lv_point_t p_last;
+    bool last_valid = false;
+
+    /*Go through the points in the order of drawing. A min/max pair is split if `start_point` is in it.*/
+    uint16_t p_act = ext->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
+    uint16_t i = 0;
+    while(i < point_cnt) {
+        uint16_t bin = p_act / ppc;
+        uint16_t bin_last = LV_MATH_MIN((uint32_t)(bin + 1) * ppc, point_cnt) - 1;
+        uint16_t len = LV_MATH_MIN(bin_last - p_act + 1, point_cnt - i);
+        uint16_t p_end = p_act + len - 1;
+
+        lv_coord_t v_min;
+        lv_coord_t v_max;
+        if(p_act == bin * ppc && p_end == bin_last) {
+            v_min = ser->dec_buf[bin * 2];
+            v_max = ser->dec_buf[bin * 2 + 1];
+        }
+        else {
+            dec_get_min_max(ser->points, p_act, p_end, &v_min, &v_max);
+        }
+
+        lv_coord_t x = get_line_x(chart, w, i) + x_ofs;
+        lv_coord_t v_first = ser->points[p_act];
+        lv_coord_t v_end = ser->points[p_end];
+
+        /*Connect the previous column to this one*/
+        if(last_valid && v_first != LV_CHART_POINT_DEF) {
+            p2.x = x;
+            p2.y = h - ((int32_t)(v_first - ymin) * h) / yrange + y_ofs;
+            lv_draw_line(&p_last, &p2, series_mask, line_dsc);
+        }
+
+        if(v_min != LV_CHART_POINT_DEF) {
+            p1.x = x;
+            p1.y = h - ((int32_t)(v_max - ymin) * h) / yrange + y_ofs;
+            p2.x = x;
+            p2.y = h - ((int32_t)(v_min - ymin) * h) / yrange + y_ofs;
+            if(p1.y != p2.y) lv_draw_line(&p1, &p2, series_mask, line_dsc);
+
+            if(area_dsc && p1.y <= series_mask->y2) {
+                lv_area_t a;
+                a.x1 = x;
+                a.x2 = i + len < point_cnt ? get_line_x(chart, w, i + len) + x_ofs - 1 : x;
+                a.y1 = p1.y;
+                a.y2 = series_area->y2;
+
+                int16_t mask_fade_id = LV_MASK_ID_INV;
+                if(mask_fade_p) mask_fade_id = lv_draw_mask_add(mask_fade_p, NULL);
+                lv_draw_rect(&a, series_mask, area_dsc);
+                lv_draw_mask_remove_id(mask_fade_id);
+            }
+        }
+
+        last_valid = v_end != LV_CHART_POINT_DEF ? true : false;
+        p_last.x = x;
+        p_last.y = h - ((int32_t)(v_end - ymin) * h) / yrange + y_ofs;
+
+        i += len;
+        p_act = p_end + 1 < point_cnt ? p_end + 1 : 0;
+    }
+}
+
 /**
  * Draw the data lines as columns on a chart
  * @param chart pointer to chart object
@@ -1312,7 +1528,7 @@ static void draw_series_column(lv_obj_t * chart, const lv_area_t * series_area,
         /*Draw the current point of all data line*/
         _LV_LL_READ_BACK(ext->series_ll, ser) {
             if(ser->hidden) continue;
-            lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+            lv_coord_t start_point = ext->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
 
             col_a.x1 = x_act;
             col_a.x2 = col_a.x1 + col_w - col_space;
@@ -1335,6 +1551,81 @@ static void draw_series_column(lv_obj_t * chart, const lv_area_t * series_area,
     }
 }
 
+/**
+ * Draw the series area in `LV_CHART_UPDATE_MODE_SCROLL` using the scroll buffer.
+ * The parts which are not in the scroll buffer are drawn normally and saved to the buffer,
+ * the rest is copied from the buffer.
+ * @param chart pointer to chart object
+ * @param series_area the series area
+ * @param clip_area the object will be drawn only in this area
+ */
+static void draw_series_scroll(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area)
+{
+    /*Get the area which can be copied from the scroll buffer and the parts to draw around it*/
+    lv_area_t old_area;
+    lv_area_t hole;
+    lv_area_t parts[4];
+    uint8_t part_cnt = 0;
+    bool has_old = scroll_buf_prepare(chart, series_area, &old_area);
+    if(has_old) has_old = _lv_area_intersect(&hole, &old_area, clip_area);
+
+    if(has_old) {
+        if(hole.y1 > clip_area->y1) {
+            lv_area_set(&parts[part_cnt], clip_area->x1, clip_area->y1, clip_area->x2, hole.y1 - 1);
+            part_cnt++;
+        }
+        if(hole.y2 < clip_area->y2) {
+            lv_area_set(&parts[part_cnt], clip_area->x1, hole.y2 + 1, clip_area->x2, clip_area->y2);
+            part_cnt++;
+        }
+        if(hole.x1 > clip_area->x1) {
+            lv_area_set(&parts[part_cnt], clip_area->x1, hole.y1, hole.x1 - 1, hole.y2);
+            part_cnt++;
+        }
+        if(hole.x2 < clip_area->x2) {
+            lv_area_set(&parts[part_cnt], hole.x2 + 1, hole.y1, clip_area->x2, hole.y2);
+            part_cnt++;
+        }
+    }
+    else {
+        lv_area_copy(&parts[0], clip_area);
+        part_cnt = 1;
+    }
+
+    lv_draw_rect_dsc_t bg_dsc;
+    lv_draw_rect_dsc_init(&bg_dsc);
+    lv_obj_init_draw_rect_dsc(chart, LV_CHART_PART_SERIES_BG, &bg_dsc);
+    lv_style_int_t border_width = bg_dsc.border_width;
+    bg_dsc.border_width = 0;
+
+    /*Draw the new parts and save them to the scroll buffer*/
+    uint8_t i;
+    for(i = 0; i < part_cnt; i++) {
+        lv_draw_rect(series_area, &parts[i], &bg_dsc);
+        draw_series_line(chart, series_area, &parts[i]);
+
+        lv_area_t save_area;
+        if(_lv_area_intersect(&save_area, series_area, &parts[i])) {
+            scroll_buf_copy(chart, series_area, &save_area, true);
+        }
+    }
+
+    if(has_old) scroll_buf_copy(chart, series_area, &hole, false);
+
+    /*The border and the division lines are not saved because they don't scroll*/
+    if(border_width) {
+        bg_dsc.border_width = border_width;
+        bg_dsc.bg_opa = LV_OPA_TRANSP;
+        bg_dsc.shadow_opa = LV_OPA_TRANSP;
+        bg_dsc.outline_opa = LV_OPA_TRANSP;
+        bg_dsc.pattern_opa = LV_OPA_TRANSP;
+        bg_dsc.value_opa = LV_OPA_TRANSP;
+        lv_draw_rect(series_area, clip_area, &bg_dsc);
+    }
+
+    draw_div_lines(chart, series_area, clip_area, border_width);
+}
+
 /**
  * Draw the cursors as lines on a chart
  * @param chart pointer to chart object
@@ -1816,14 +2107,14 @@ static void invalidate_lines(lv_obj_t * chart, uint16_t i)
     coords.y2 += line_width + point_radius;
 
     if(i < ext->point_cnt - 1) {
-        coords.x1 = ((w * i) / (ext->point_cnt - 1)) + x_ofs - line_width - point_radius;
-        coords.x2 = ((w * (i + 1)) / (ext->point_cnt - 1)) + x_ofs + line_width + point_radius;
+        coords.x1 = get_line_x(chart, w, i) + x_ofs - line_width - point_radius;
+        coords.x2 = get_line_x(chart, w, i + 1) + x_ofs + line_width + point_radius;
         lv_obj_invalidate_area(chart, &coords);
     }
 
     if(i > 0) {
-        coords.x1 = ((w * (i - 1)) / (ext->point_cnt - 1)) + x_ofs - line_width - point_radius;
-        coords.x2 = ((w * i) / (ext->point_cnt - 1)) + x_ofs + line_width + point_radius;
+        coords.x1 = get_line_x(chart, w, i - 1) + x_ofs - line_width - point_radius;
+        coords.x2 = get_line_x(chart, w, i) + x_ofs + line_width + point_radius;
         lv_obj_invalidate_area(chart, &coords);
     }
 }
@@ -1856,4 +2147,294 @@ static void invalidate_columns(lv_obj_t * chart, uint16_t i)
     _lv_inv_area(lv_obj_get_disp(chart), &col_a);
 }
 
+/**
+ * Invalidate the series area with the overhanging parts of the lines and points
+ * @param chart pointer to chart object
+ */
+static void invalidate_series(lv_obj_t * chart)
+{
+    lv_style_int_t line_width = lv_obj_get_style_line_width(chart, LV_CHART_PART_SERIES);
+    lv_style_int_t point_radius = lv_obj_get_style_size(chart, LV_CHART_PART_SERIES);
+
+    lv_area_t coords;
+    lv_chart_get_series_area(chart, &coords);
+    coords.x1 -= line_width + point_radius;
+    coords.y1 -= line_width + point_radius;
+    coords.x2 += line_width + point_radius;
+    coords.y2 += line_width + point_radius;
+    lv_obj_invalidate_area(chart, &coords);
+}
+
+/**
+ * Get the x coordinate of a point of a line chart relative to the series area
+ * @param chart pointer to chart object
+ * @param w width of the series area
+ * @param i index of the point (0: left most)
+ * @return the x coordinate
+ */
+static lv_coord_t get_line_x(lv_obj_t * chart, lv_coord_t w, uint16_t i)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+
+    /*In scroll mode the points have to be the same distance from each other to shift the drawn lines*/
+    if(ext->update_mode == LV_CHART_UPDATE_MODE_SCROLL) {
+        lv_coord_t pitch = w / (ext->point_cnt - 1);
+        if(pitch > 0) return w - (ext->point_cnt - 1 - i) * pitch;
+    }
+
+    return (w * i) / (ext->point_cnt - 1);
+}
+
+/**
+ * Tell whether the series area can be drawn with the scroll buffer
+ * @param chart pointer to chart object
+ * @param series_area the series area
+ * @return true: the scroll buffer can be used
+ */
+static bool scroll_buf_usable(lv_obj_t * chart, const lv_area_t * series_area)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->update_mode != LV_CHART_UPDATE_MODE_SCROLL) return false;
+    if(ext->scroll_buf == NULL) return false;
+    if(ext->type != LV_CHART_TYPE_LINE) return false;
+    if(ext->point_cnt < 2) return false;
+
+    lv_coord_t w = lv_area_get_width(series_area);
+    lv_coord_t h = lv_area_get_height(series_area);
+    if(w <= 0 || h <= 0) return false;
+    if(w / (ext->point_cnt - 1) == 0) return false;
+    if(LV_CHART_SCROLL_BUF_SIZE(w, h) > ext->scroll_buf_size) return false;
+
+    /*The pixels are copied directly from/to the display buffer*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp == NULL || disp->driver.set_px_cb) return false;
+
+    return true;
+}
+
+/**
+ * Shift the scroll buffer according to the shift of the series since the last drawing.
+ * If the series were not shifted the same way or the chart has changed the buffer is reset.
+ * @param chart pointer to chart object
+ * @param series_area the series area
+ * @param old_area store the part of the series area which can be copied from the scroll buffer here
+ * @return true: `old_area` is valid; false: the whole series area needs to be drawn
+ */
+static bool scroll_buf_prepare(lv_obj_t * chart, const lv_area_t * series_area, lv_area_t * old_area)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    lv_coord_t w = lv_area_get_width(series_area);
+    lv_coord_t h = lv_area_get_height(series_area);
+    lv_coord_t pitch = w / (ext->point_cnt - 1);
+    lv_coord_t margin = scroll_buf_get_margin(chart);
+
+    /*Get how many points the visible series were shifted since they were saved*/
+    bool shift_same = true;
+    bool first = true;
+    int32_t shift = 0;
+    lv_chart_series_t * ser;
+    _LV_LL_READ(ext->series_ll, ser) {
+        if(ser->hidden) continue;
+        int32_t ser_shift = ((int32_t)ser->start_point - ser->scroll_start + ext->point_cnt) % ext->point_cnt;
+        if(first) {
+            shift = ser_shift;
+            first = false;
+        }
+        else if(ser_shift != shift) {
+            shift_same = false;
+        }
+    }
+
+    bool reset = false;
+    if(series_area->x1 != ext->scroll_area.x1 || series_area->y1 != ext->scroll_area.y1 ||
+       series_area->x2 != ext->scroll_area.x2 || series_area->y2 != ext->scroll_area.y2) {
+        reset = true;
+    }
+    else if(shift_same == false || shift < 0) {
+        reset = true;
+    }
+    else if(shift > 0) {
+        lv_coord_t shift_px = shift * pitch;
+        if(ext->scroll_rows < h || shift_px + margin >= w) {
+            reset = true;
+        }
+        else {
+            /*The left most column of the buffer is shifted out and the right side needs to be drawn*/
+            ext->scroll_head = (ext->scroll_head + shift_px) % w;
+            ext->scroll_strip = shift_px + margin;
+        }
+    }
+
+    if(reset || shift != 0) {
+        _LV_LL_READ(ext->series_ll, ser) {
+            ser->scroll_start = ser->start_point;
+        }
+    }
+
+    if(reset) {
+        lv_area_copy(&ext->scroll_area, series_area);
+        ext->scroll_head = 0;
+        ext->scroll_strip = w;
+        ext->scroll_rows = 0;
+    }
+
+    if(ext->scroll_rows < h) return false;
+
+    /*The left side also needs to be drawn where the first line disappeared*/
+    lv_coord_t left = w - (ext->point_cnt - 1) * pitch + margin;
+
+    old_area->x1 = series_area->x1 + left;
+    old_area->x2 = series_area->x2 - ext->scroll_strip;
+    old_area->y1 = series_area->y1;
+    old_area->y2 = series_area->y2;
+
+    return old_area->x1 <= old_area->x2 ? true : false;
+}
+
+/**
+ * Copy pixels between the display buffer and the scroll buffer
+ * @param chart pointer to chart object
+ * @param series_area the series area
+ * @param area the area to copy. Has to be on the series area and on the display buffer.
+ * @param save true: copy from the display buffer to the scroll buffer; false: copy from the scroll buffer
+ */
+static void scroll_buf_copy(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * area, bool save)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    if(disp->driver.gpu_wait_cb) disp->driver.gpu_wait_cb(&disp->driver);
+
+    lv_coord_t w = lv_area_get_width(series_area);
+    lv_coord_t vdb_w = lv_area_get_width(&vdb->area);
+    lv_coord_t len = lv_area_get_width(area);
+    lv_coord_t col = (ext->scroll_head + area->x1 - series_area->x1) % w;
+
+    /*The columns of the ring might wrap around*/
+    lv_coord_t len1 = LV_MATH_MIN(len, w - col);
+    lv_coord_t len2 = len - len1;
+
+    lv_color_t * disp_buf = vdb->buf_act;
+    disp_buf += (int32_t)(area->y1 - vdb->area.y1) * vdb_w + (area->x1 - vdb->area.x1);
+    lv_color_t * scroll_buf = ext->scroll_buf + (int32_t)(area->y1 - series_area->y1) * w;
+
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        if(save) {
+            _lv_memcpy(scroll_buf + col, disp_buf, len1 * sizeof(lv_color_t));
+            if(len2) _lv_memcpy(scroll_buf, disp_buf + len1, len2 * sizeof(lv_color_t));
+        }
+        else {
+            _lv_memcpy(disp_buf, scroll_buf + col, len1 * sizeof(lv_color_t));
+            if(len2) _lv_memcpy(disp_buf + len1, scroll_buf, len2 * sizeof(lv_color_t));
+        }
+        disp_buf += vdb_w;
+        scroll_buf += w;
+    }
+
+    /*Count the saved rows while the whole series area is being filled from the top*/
+    if(save && area->x1 == series_area->x1 && area->x2 == series_area->x2) {
+        lv_coord_t row_first = area->y1 - series_area->y1;
+        lv_coord_t row_last = area->y2 - series_area->y1;
+        if(row_first <= ext->scroll_rows && row_last >= ext->scroll_rows) ext->scroll_rows = row_last + 1;
+    }
+}
+
+/**
+ * Get the number of columns around the lines' ends which can be different
+ * if the lines are drawn in an other position
+ * @param chart pointer to chart object
+ * @return the width of the margin
+ */
+static lv_coord_t scroll_buf_get_margin(lv_obj_t * chart)
+{
+    lv_style_int_t line_width = lv_obj_get_style_line_width(chart, LV_CHART_PART_SERIES);
+    lv_style_int_t point_radius = lv_obj_get_style_size(chart, LV_CHART_PART_SERIES);
+
+    /*+1 for anti-aliasing*/
+    return line_width + point_radius + 1;
+}
+
+/**
+ * Update the min/max values of a series if there are enough points to draw them instead of the points
+ * @param chart pointer to chart object
+ * @param ser pointer to a series
+ * @param w width of the series area
+ * @return true: `ser->dec_buf` is up to date and can be drawn; false: draw every point
+ */
+static bool dec_update(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t w)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(w <= 0 || ext->point_cnt < 2) return false;
+
+    uint16_t ppc = (ext->point_cnt - 1) / w;
+    if(ppc < LV_CHART_DEC_PPC_MIN) return false;
+
+    uint16_t bin_cnt = (ext->point_cnt + ppc - 1) / ppc;
+    if(ser->dec_buf == NULL || ser->dec_bin_cnt != bin_cnt) {
+        if(ser->dec_buf) lv_mem_free(ser->dec_buf);
+        ser->dec_buf = lv_mem_alloc(bin_cnt * 2 * sizeof(lv_coord_t));
+        ser->dec_bin_cnt = ser->dec_buf ? bin_cnt : 0;
+        ser->dec_ppc = 0;
+        if(ser->dec_buf == NULL) return false;
+    }
+
+    if(ser->dec_ppc != ppc) {
+        uint16_t bin;
+        for(bin = 0; bin < bin_cnt; bin++) {
+            uint16_t first = bin * ppc;
+            uint16_t last = LV_MATH_MIN(first + ppc, ext->point_cnt) - 1;
+            dec_get_min_max(ser->points, first, last, &ser->dec_buf[bin * 2], &ser->dec_buf[bin * 2 + 1]);
+        }
+        ser->dec_ppc = ppc;
+    }
+
+    return true;
+}
+
+/**
+ * Update the min/max values which contain a point after it was changed
+ * @param chart pointer to chart object
+ * @param ser pointer to a series
+ * @param id index of the changed point
+ */
+static void dec_update_point(lv_obj_t * chart, lv_chart_series_t * ser, uint16_t id)
+{
+    if(ser->dec_ppc == 0) return;
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    uint16_t bin = id / ser->dec_ppc;
+    if(bin >= ser->dec_bin_cnt) return;
+
+    uint16_t first = bin * ser->dec_ppc;
+    uint16_t last = LV_MATH_MIN(first + ser->dec_ppc, ext->point_cnt) - 1;
+    dec_get_min_max(ser->points, first, last, &ser->dec_buf[bin * 2], &ser->dec_buf[bin * 2 + 1]);
+}
+
+/**
+ * Get the min and max of points. `LV_CHART_POINT_DEF` points are skipped.
+ * @param points array of points
+ * @param first index of the first point
+ * @param last index of the last point
+ * @param min store the minimum here (`LV_CHART_POINT_DEF` if all points are `LV_CHART_POINT_DEF`)
+ * @param max store the maximum here (`LV_CHART_POINT_DEF` if all points are `LV_CHART_POINT_DEF`)
+ */
+static void dec_get_min_max(const lv_coord_t * points, uint16_t first, uint16_t last, lv_coord_t * min,
+                            lv_coord_t * max)
+{
+    lv_coord_t v_min = LV_COORD_MAX;
+    lv_coord_t v_max = LV_CHART_POINT_DEF;
+    uint16_t i;
+    for(i = first; i <= last; i++) {
+        lv_coord_t v = points[i];
+        if(v == LV_CHART_POINT_DEF) continue;
+        if(v < v_min) v_min = v;
+        if(v > v_max) v_max = v;
+    }
+
+    *min = v_max == LV_CHART_POINT_DEF ? LV_CHART_POINT_DEF : v_min;
+    *max = v_max;
+}
+
 #endif
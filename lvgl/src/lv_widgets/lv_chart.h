@@ -30,6 +30,9 @@ extern "C" {
 /**Automatically calculate the tick length*/
 #define LV_CHART_TICK_LENGTH_AUTO 255
 
+/**Size of the buffer for `lv_chart_set_scroll_buffer` in bytes. `w` and `h` are the size of the series area*/
+#define LV_CHART_SCROLL_BUF_SIZE(w, h) ((uint32_t)(w) * (h) * sizeof(lv_color_t))
+
 LV_EXPORT_CONST_INT(LV_CHART_POINT_DEF);
 LV_EXPORT_CONST_INT(LV_CHART_TICK_LENGTH_AUTO);
 
@@ -49,6 +52,8 @@ typedef uint8_t lv_chart_type_t;
 enum {
     LV_CHART_UPDATE_MODE_SHIFT,     /**< Shift old data to the left and add the new one o the right*/
     LV_CHART_UPDATE_MODE_CIRCULAR,  /**< Add the new data in a circular way*/
+    LV_CHART_UPDATE_MODE_SCROLL,    /**< Like `SHIFT` but the points are placed evenly from the right and
+                                         with a scroll buffer only the new part of the lines is drawn*/
 };
 typedef uint8_t lv_chart_update_mode_t;
 
@@ -72,6 +77,10 @@ typedef struct {
     lv_coord_t * points;
     lv_color_t color;
     uint16_t start_point;
+    uint16_t scroll_start;  /*`start_point` when the series was saved to the scroll buffer*/
+    lv_coord_t * dec_buf;   /*Min. and max. values of every `dec_ppc` points to draw many points faster*/
+    uint16_t dec_bin_cnt;   /*Number of min/max pairs in `dec_buf`*/
+    uint16_t dec_ppc;       /*Number of points in a min/max pair. 0: `dec_buf` needs to be updated*/
     uint8_t ext_buf_assigned : 1;
     uint8_t hidden : 1;
     lv_chart_axis_t y_axis  : 1;
@@ -117,7 +126,13 @@ typedef struct {
     lv_chart_axis_cfg_t y_axis;
     lv_chart_axis_cfg_t x_axis;
     lv_chart_axis_cfg_t secondary_y_axis;
-    uint8_t update_mode : 1;
+    lv_color_t * scroll_buf;    /*The drawn series area in `LV_CHART_UPDATE_MODE_SCROLL` as a ring of columns*/
+    uint32_t scroll_buf_size;   /*Size of `scroll_buf` in bytes*/
+    lv_area_t scroll_area;      /*The series area when `scroll_buf` was filled*/
+    lv_coord_t scroll_head;     /*Column of `scroll_buf` on the left side of the series area*/
+    lv_coord_t scroll_strip;    /*Number of columns on the right which are drawn instead of copied from `scroll_buf`*/
+    lv_coord_t scroll_rows;     /*Number of rows saved to `scroll_buf` from the top of the series area*/
+    uint8_t update_mode : 2;
 } lv_chart_ext_t;
 
 /*Parts of the chart*/
@@ -250,6 +265,21 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y);
  */
 void lv_chart_set_update_mode(lv_obj_t * chart, lv_chart_update_mode_t update_mode);
 
+/**
+ * Set a buffer to keep the drawn series area in `LV_CHART_UPDATE_MODE_SCROLL`.
+ * With the buffer `lv_chart_set_next` draws only the new part of the lines and copies the rest
+ * shifted to the left from the buffer.
+ * It's used only with `LV_CHART_TYPE_LINE` and requires a background under the series area
+ * which looks the same in every column (e.g. no horizontal gradient or rounded corners).
+ * The division lines and the border of the series background are drawn above the lines.
+ * Call `lv_chart_refresh` if the data is modified other than with `lv_chart_set_next`.
+ * @param chart pointer to a chart object
+ * @param buf a buffer with `LV_CHART_SCROLL_BUF_SIZE(w, h)` size where `w` and `h` is the size of
+ *            the series area. `NULL` to not use a buffer.
+ * @param buf_size size of `buf` in bytes. If the series area doesn't fit the buffer is not used.
+ */
+void lv_chart_set_scroll_buffer(lv_obj_t * chart, lv_color_t * buf, uint32_t buf_size);
+
 /**
  * Set the length of the tick marks on the x axis
  * @param chart pointer to the chart
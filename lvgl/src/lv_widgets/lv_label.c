@@ -53,6 +53,8 @@ static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
 static void get_txt_coords(const lv_obj_t * label, lv_area_t * area);
+static const lv_txt_line_cache_t * get_line_cache(const lv_obj_t * label, const lv_font_t * font,
+                                                  lv_coord_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag);
 
 /**********************
  *  STATIC VARIABLES
@@ -112,6 +114,10 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    _lv_txt_line_cache_init(&ext->line_cache);
+#endif
+
 #if LV_LABEL_TEXT_SEL
     ext->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     ext->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -568,14 +574,24 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
 
-    /*Search the line of the index letter */;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+    uint32_t line_i = 0;
+    const lv_txt_line_cache_t * lines = get_line_cache(label, font, letter_space, max_w, flag);
+    if(lines) {
+        line_i = _lv_txt_line_cache_get_line(lines, byte_id);
+        line_start = lines->lines[line_i].start;
+        new_line_start = lines->lines[line_i + 1].start;
+        y = line_i * (letter_height + line_space);
+    }
+    else {
+        /*Search the line of the index letter */;
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -583,6 +599,7 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
         if((txt[byte_id - 1] == '\n' || txt[byte_id - 1] == '\r') && txt[byte_id] == '\0') {
             y += letter_height + line_space;
             line_start = byte_id;
+            line_i++;
         }
     }
 
@@ -617,13 +634,15 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
 
     if(align == LV_LABEL_ALIGN_CENTER) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
+        if(lines) line_w = lines->lines[line_i].w;
+        else line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
 
     }
     else if(align == LV_LABEL_ALIGN_RIGHT) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
+        if(lines) line_w = lines->lines[line_i].w;
+        else line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
 
         x += lv_area_get_width(&txt_coords) - line_w;
     }
@@ -675,22 +694,42 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
     if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
     if(align == LV_LABEL_ALIGN_RIGHT) flag |= LV_TXT_FLAG_RIGHT;
 
-    /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
-
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
-            /* Include the NULL terminator in the last line */
-            uint32_t tmp = new_line_start;
-            uint32_t letter;
-            letter = _lv_txt_encoded_prev(txt, &tmp);
-            if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
+    uint32_t line_i = 0;
+    bool line_found = false;
+    const lv_txt_line_cache_t * lines = get_line_cache(label, font, letter_space, max_w, flag);
+    if(lines) {
+        line_i = _lv_txt_line_cache_get_line_at(lines, pos.y, letter_height, line_space);
+        line_start = lines->lines[line_i].start;
+        if(line_i < lines->line_cnt) {
+            new_line_start = lines->lines[line_i + 1].start;
+            line_found = true;
+        }
+        else {
+            new_line_start = line_start;
+        }
+    }
+    else {
+        /*Search the line of the index letter */;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+
+            if(pos.y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                line_found = true;
+                break;
+            }
+            y += letter_height + line_space;
+
+            line_start = new_line_start;
         }
-        y += letter_height + line_space;
+    }
 
-        line_start = new_line_start;
+    if(line_found) {
+        /* Include the NULL terminator in the last line */
+        uint32_t tmp = new_line_start;
+        uint32_t letter;
+        letter = _lv_txt_encoded_prev(txt, &tmp);
+        if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
     }
 
 #if LV_USE_BIDI
@@ -706,12 +745,14 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
     lv_coord_t x = 0;
     if(align == LV_LABEL_ALIGN_CENTER) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
+        if(lines) line_w = lines->lines[line_i].w;
+        else line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
     }
     else if(align == LV_LABEL_ALIGN_RIGHT) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
+        if(lines) line_w = lines->lines[line_i].w;
+        else line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) - line_w;
     }
 
@@ -836,14 +877,24 @@ bool lv_label_is_char_under_pos(const lv_obj_t * label, lv_point_t * pos)
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
     if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
 
-    /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+    uint32_t line_i = 0;
+    const lv_txt_line_cache_t * lines = get_line_cache(label, font, letter_space, max_w, flag);
+    if(lines) {
+        line_i = _lv_txt_line_cache_get_line_at(lines, pos->y, letter_height, line_space);
+        line_start = lines->lines[line_i].start;
+        if(line_i < lines->line_cnt) new_line_start = lines->lines[line_i + 1].start;
+        else new_line_start = line_start;
+    }
+    else {
+        /*Search the line of the index letter */;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
@@ -851,12 +902,14 @@ bool lv_label_is_char_under_pos(const lv_obj_t * label, lv_point_t * pos)
     lv_coord_t last_x = 0;
     if(align == LV_LABEL_ALIGN_CENTER) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
+        if(lines) line_w = lines->lines[line_i].w;
+        else line_w = _lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
     }
     else if(align == LV_LABEL_ALIGN_RIGHT) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
+        if(lines) line_w = lines->lines[line_i].w;
+        else line_w = _lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) - line_w;
     }
 
@@ -998,6 +1051,9 @@ void lv_label_refr_text(lv_obj_t * label)
 #if LV_LABEL_LONG_TXT_HINT
     ext->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
+#if LV_LABEL_LINE_CACHE
+    _lv_txt_line_cache_invalidate(&ext->line_cache); /*The text, font, width or long mode might have changed*/
+#endif
 
     lv_area_t txt_coords;
     get_txt_coords(label, &txt_coords);
@@ -1243,6 +1299,9 @@ void lv_label_refr_text(lv_obj_t * label)
                 }
                 ext->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 ext->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+#if LV_LABEL_LINE_CACHE
+                _lv_txt_line_cache_invalidate(&ext->line_cache); /*The text was truncated in place*/
+#endif
             }
         }
     }
@@ -1344,6 +1403,9 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         lv_draw_label_hint_t * hint = NULL;
 #endif
 
+        label_draw_dsc.line_cache = get_line_cache(label, label_draw_dsc.font, label_draw_dsc.letter_space,
+                                                   lv_area_get_width(&txt_coords), label_draw_dsc.flag);
+
         lv_draw_label(&txt_coords, &txt_clip, &label_draw_dsc, ext->text, hint);
 
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) {
@@ -1403,6 +1465,9 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
             ext->text = NULL;
         }
         lv_label_dot_tmp_free(label);
+#if LV_LABEL_LINE_CACHE
+        _lv_txt_line_cache_invalidate(&ext->line_cache);
+#endif
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         /*Revert dots for proper refresh*/
@@ -1442,6 +1507,9 @@ static void lv_label_revert_dots(lv_obj_t * label)
     }
     ext->text[byte_i + i] = dot_tmp[i];
     lv_label_dot_tmp_free(label);
+#if LV_LABEL_LINE_CACHE
+    _lv_txt_line_cache_invalidate(&ext->line_cache);
+#endif
 
     ext->dot_end = LV_LABEL_DOT_END_INV;
 }
@@ -1538,4 +1606,37 @@ static void get_txt_coords(const lv_obj_t * label, lv_area_t * area)
     area->y2 -= bottom;
 }
 
+/**
+ * Get the line breaks of the label's text. Rebuild them if the text or the parameters have changed.
+ * @param label pointer to a label object
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w width of the text area
+ * @param flag text flags
+ * @return pointer to the label's line cache or NULL if it's disabled, the text is too short or out of memory
+ */
+static const lv_txt_line_cache_t * get_line_cache(const lv_obj_t * label, const lv_font_t * font,
+                                                  lv_coord_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    if(ext->text == NULL) return NULL;
+
+    if(!_lv_txt_line_cache_is_valid(&ext->line_cache, ext->text, font, letter_space, max_w, flag)) {
+        /*Short texts are broken to lines quickly anyway*/
+        if(strlen(ext->text) < LV_LABEL_LINE_CACHE) return NULL;
+        if(!_lv_txt_line_cache_update(&ext->line_cache, ext->text, font, letter_space, max_w, flag)) return NULL;
+    }
+
+    return &ext->line_cache;
+#else
+    (void)label;        /*Unused*/
+    (void)font;         /*Unused*/
+    (void)letter_space; /*Unused*/
+    (void)max_w;        /*Unused*/
+    (void)flag;         /*Unused*/
+    return NULL;
+#endif
+}
+
 #endif
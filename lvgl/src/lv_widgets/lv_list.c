@@ -22,6 +22,8 @@
 
 #define LV_LIST_LAYOUT_DEF LV_LAYOUT_COLUMN_MID
 
+#define LV_LIST_ROW_NONE 0xFFFF
+
 #if LV_USE_ANIMATION == 0
     #undef LV_LIST_DEF_ANIM_TIME
     #define LV_LIST_DEF_ANIM_TIME 0
@@ -40,6 +42,13 @@ static lv_style_list_t * lv_list_get_style(lv_obj_t * list, uint8_t part);
 static bool lv_list_is_list_btn(lv_obj_t * list_btn);
 static bool lv_list_is_list_img(lv_obj_t * list_btn);
 static bool lv_list_is_list_label(lv_obj_t * list_btn);
+static lv_res_t lv_list_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void * param);
+static void scrl_set_y(const lv_obj_t * list, lv_coord_t new_y);
+static void virt_pool_create(lv_obj_t * list);
+static void virt_pool_del(lv_obj_t * list);
+static void virt_refr(lv_obj_t * list);
+static void virt_focus_row(lv_obj_t * list, uint16_t row);
+static uint16_t virt_get_btn_row(const lv_obj_t * list, const lv_obj_t * btn);
 
 /**********************
  *  STATIC VARIABLES
@@ -50,6 +59,7 @@ static bool lv_list_is_list_label(lv_obj_t * list_btn);
 static lv_signal_cb_t label_signal;
 static lv_signal_cb_t ancestor_page_signal;
 static lv_signal_cb_t ancestor_btn_signal;
+static lv_signal_cb_t ancestor_scrl_signal;
 
 /**********************
  *      MACROS
@@ -87,8 +97,17 @@ lv_obj_t * lv_list_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->last_sel_btn = NULL;
 #endif
     ext->act_sel_btn = NULL;
+    ext->row_cb = NULL;
+    ext->virt_btn = NULL;
+    ext->virt_btn_cnt = 0;
+    ext->row_cnt = 0;
+    ext->sel_row = LV_LIST_ROW_NONE;
+    ext->row_h = 0;
+
+    if(ancestor_scrl_signal == NULL) ancestor_scrl_signal = lv_obj_get_signal_cb(lv_page_get_scrollable(list));
 
     lv_obj_set_signal_cb(list, lv_list_signal);
+    lv_obj_set_signal_cb(lv_page_get_scrollable(list), lv_list_scrl_signal);
 
     /*Init the new list object*/
     if(copy == NULL) {
@@ -102,15 +121,21 @@ lv_obj_t * lv_list_create(lv_obj_t * par, const lv_obj_t * copy)
 
     }
     else {
-        lv_obj_t * copy_btn = lv_list_get_next_btn(copy, NULL);
-        while(copy_btn) {
-            const void * img_src = NULL;
+        lv_list_ext_t * copy_ext = lv_obj_get_ext_attr(copy);
+        if(copy_ext->row_cb) {
+            lv_list_set_row_cb(list, copy_ext->row_cb, copy_ext->row_cnt);
+        }
+        else {
+            lv_obj_t * copy_btn = lv_list_get_next_btn(copy, NULL);
+            while(copy_btn) {
+                const void * img_src = NULL;
 #if LV_USE_IMG
-            lv_obj_t * copy_img = lv_list_get_btn_img(copy_btn);
-            if(copy_img) img_src = lv_img_get_src(copy_img);
+                lv_obj_t * copy_img = lv_list_get_btn_img(copy_btn);
+                if(copy_img) img_src = lv_img_get_src(copy_img);
 #endif
-            lv_list_add_btn(list, img_src, lv_list_get_btn_text(copy_btn));
-            copy_btn = lv_list_get_next_btn(copy, copy_btn);
+                lv_list_add_btn(list, img_src, lv_list_get_btn_text(copy_btn));
+                copy_btn = lv_list_get_next_btn(copy, copy_btn);
+            }
         }
 
         /*Refresh the style with new signal function*/
@@ -124,13 +149,25 @@ lv_obj_t * lv_list_create(lv_obj_t * par, const lv_obj_t * copy)
 
 /**
  * Delete all children of the scrl object, without deleting scrl child.
+ * A virtual list becomes a normal list.
  * @param list pointer to an object
  */
 void lv_list_clean(lv_obj_t * list)
 {
     LV_ASSERT_OBJ(list, LV_OBJX_NAME);
 
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
     lv_obj_t * scrl = lv_page_get_scrollable(list);
+
+    if(ext->row_cb) {
+        virt_pool_del(list);
+        ext->row_cb  = NULL;
+        ext->row_cnt = 0;
+        ext->sel_row = LV_LIST_ROW_NONE;
+        lv_page_set_scrollable_fit2(list, LV_FIT_PARENT, LV_FIT_TIGHT);
+        lv_page_set_scrl_layout(list, LV_LIST_LAYOUT_DEF);
+    }
+
     lv_obj_clean(scrl);
 }
 
@@ -148,6 +185,12 @@ lv_obj_t * lv_list_add_btn(lv_obj_t * list, const void * img_src, const char * t
 {
     LV_ASSERT_OBJ(list, LV_OBJX_NAME);
 
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cb) {
+        LV_LOG_WARN("lv_list_add_btn: can't be used in a virtual list");
+        return NULL;
+    }
+
     lv_obj_t * last_btn = lv_list_get_prev_btn(list, NULL);
 
     /*The coordinates may changed due to autofit so revert them at the end*/
@@ -248,6 +291,11 @@ bool lv_list_remove(const lv_obj_t * list, uint16_t index)
     LV_ASSERT_OBJ(list, LV_OBJX_NAME);
 
     lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cb) {
+        LV_LOG_WARN("lv_list_remove: can't be used in a virtual list");
+        return false;
+    }
+
     uint16_t count = 0;
     lv_obj_t * e   = lv_list_get_next_btn(list, NULL);
     while(e != NULL) {
@@ -293,6 +341,9 @@ void lv_list_focus_btn(lv_obj_t * list, lv_obj_t * btn)
      * It will be restored when the list is focused again.*/
     if(btn) ext->last_sel_btn = btn;
 #endif
+    /*In a virtual list the row is selected as the button will show other rows later*/
+    if(ext->row_cb) ext->sel_row = btn ? virt_get_btn_row(list, btn) : LV_LIST_ROW_NONE;
+
     /*Focus the new button*/
     ext->act_sel_btn = btn;
 
@@ -302,6 +353,52 @@ void lv_list_focus_btn(lv_obj_t * list, lv_obj_t * btn)
     }
 }
 
+/**
+ * Make the list virtual: create buttons only for the visible rows and fill them from a callback.
+ * @param list pointer to a list object
+ * @param cb callback to fill a button with the content of a row or `NULL` to make the list normal again
+ * @param row_cnt number of rows
+ */
+void lv_list_set_row_cb(lv_obj_t * list, lv_list_row_cb_t cb, uint16_t row_cnt)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+
+    lv_list_clean(list);
+    if(cb == NULL) return;
+
+    ext->row_cb  = cb;
+    ext->row_cnt = row_cnt;
+    virt_pool_create(list);
+}
+
+/**
+ * Set the number of rows of a virtual list. The visible rows are filled again.
+ * @param list pointer to a list object
+ * @param row_cnt number of rows
+ */
+void lv_list_set_row_cnt(lv_obj_t * list, uint16_t row_cnt)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cb == NULL) {
+        LV_LOG_WARN("lv_list_set_row_cnt: not a virtual list");
+        return;
+    }
+
+    ext->row_cnt = row_cnt;
+    if(ext->sel_row != LV_LIST_ROW_NONE && ext->sel_row >= row_cnt) ext->sel_row = LV_LIST_ROW_NONE;
+
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        ext->virt_btn[i].row = LV_LIST_ROW_NONE;
+    }
+
+    virt_refr(list);
+}
+
 /**
  * Set layout of a list
  * @param list pointer to a list object
@@ -475,6 +572,12 @@ int32_t lv_list_get_btn_index(const lv_obj_t * list, const lv_obj_t * btn)
     }
     LV_ASSERT_OBJ(list, LV_OBJX_NAME);
 
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cb) {
+        uint16_t row = virt_get_btn_row(list, btn);
+        return row == LV_LIST_ROW_NONE ? -1 : row;
+    }
+
     lv_obj_t * e = lv_list_get_next_btn(list, NULL);
     while(e != NULL) {
         if(e == btn) {
@@ -495,6 +598,9 @@ uint16_t lv_list_get_size(const lv_obj_t * list)
 {
     LV_ASSERT_OBJ(list, LV_OBJX_NAME);
 
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cb) return ext->row_cnt;
+
     uint16_t size = 0;
     lv_obj_t * btn = lv_list_get_next_btn(list, NULL);
     while(btn) {
@@ -545,7 +651,19 @@ void lv_list_up(const lv_obj_t * list)
 
     /*Search the first list element which 'y' coordinate is below the parent
      * and position the list to show this element on the bottom*/
-    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cb) {
+        /*Calculate it from the rows as the rows below the list have no button*/
+        lv_obj_t * scrl = lv_page_get_scrollable(list);
+        lv_style_int_t top = lv_obj_get_style_pad_top(list, LV_LIST_PART_SCROLLABLE);
+        lv_coord_t pitch = ext->row_h + lv_obj_get_style_pad_inner(list, LV_LIST_PART_SCROLLABLE);
+        lv_coord_t y = list->coords.y2 - scrl->coords.y1 - top - ext->row_h + 1;
+        if(y < 0) return;
+        int32_t row = y / pitch + 1;
+        if(row < ext->row_cnt) scrl_set_y(list, lv_obj_get_height(list) - (top + row * (int32_t)pitch + ext->row_h));
+        return;
+    }
+
     lv_obj_t * e;
     lv_obj_t * e_prev = NULL;
 
@@ -554,20 +672,7 @@ void lv_list_up(const lv_obj_t * list)
         if(e->coords.y2 <= list->coords.y2) {
             if(e_prev != NULL) {
                 lv_coord_t new_y = lv_obj_get_height(list) - (lv_obj_get_y(e_prev) + lv_obj_get_height(e_prev));
-                if(lv_list_get_anim_time(list) == 0) {
-                    lv_obj_set_y(scrl, new_y);
-                }
-                else {
-#if LV_USE_ANIMATION
-                    lv_anim_t a;
-                    lv_anim_init(&a);
-                    lv_anim_set_var(&a, scrl);
-                    lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_set_y);
-                    lv_anim_set_values(&a, lv_obj_get_y(scrl), new_y);
-                    lv_anim_set_time(&a, LV_LIST_DEF_ANIM_TIME);
-                    lv_anim_start(&a);
-#endif
-                }
+                scrl_set_y(list, new_y);
             }
             break;
         }
@@ -586,26 +691,27 @@ void lv_list_down(const lv_obj_t * list)
 
     /*Search the first list element which 'y' coordinate is above the parent
      * and position the list to show this element on the top*/
-    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cb) {
+        /*Calculate it from the rows as the rows above the list have no button*/
+        lv_obj_t * scrl = lv_page_get_scrollable(list);
+        lv_style_int_t top = lv_obj_get_style_pad_top(list, LV_LIST_PART_SCROLLABLE);
+        lv_coord_t pitch = ext->row_h + lv_obj_get_style_pad_inner(list, LV_LIST_PART_SCROLLABLE);
+        lv_coord_t y = list->coords.y1 - scrl->coords.y1 - top;
+        if(y <= 0) return;
+        int32_t row = (y - 1) / pitch;
+        if(row >= ext->row_cnt) row = ext->row_cnt - 1;
+        if(row < 0) return;
+        scrl_set_y(list, -(top + row * (int32_t)pitch));
+        return;
+    }
+
     lv_obj_t * e;
     e = lv_list_get_prev_btn(list, NULL);
     while(e != NULL) {
         if(e->coords.y1 < list->coords.y1) {
             lv_coord_t new_y = -lv_obj_get_y(e);
-            if(lv_list_get_anim_time(list) == 0) {
-                lv_obj_set_y(scrl, new_y);
-            }
-            else {
-#if LV_USE_ANIMATION
-                lv_anim_t a;
-                lv_anim_init(&a);
-                lv_anim_set_var(&a, scrl);
-                lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_set_y);
-                lv_anim_set_values(&a, lv_obj_get_y(scrl), new_y);
-                lv_anim_set_time(&a, LV_LIST_DEF_ANIM_TIME);
-                lv_anim_start(&a);
-#endif
-            }
+            scrl_set_y(list, new_y);
             break;
         }
         e = lv_list_get_prev_btn(list, e);
@@ -715,6 +821,7 @@ static lv_res_t lv_list_signal(lv_obj_t * list, lv_signal_t sign, void * param)
             lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
             /* Select the last used button, or use the first no last button */
             if(ext->last_sel_btn) lv_list_focus_btn(list, ext->last_sel_btn);
+            else if(ext->row_cb) virt_focus_row(list, 0);
             else lv_list_focus_btn(list, lv_list_get_next_btn(list, NULL));
         }
         if(indev_type == LV_INDEV_TYPE_ENCODER && lv_group_get_editing(g) == false) {
@@ -742,7 +849,16 @@ static lv_res_t lv_list_signal(lv_obj_t * list, lv_signal_t sign, void * param)
     else if(sign == LV_SIGNAL_CONTROL) {
 #if LV_USE_GROUP
         char c = *((char *)param);
-        if(c == LV_KEY_RIGHT || c == LV_KEY_DOWN) {
+        lv_list_ext_t * list_ext = lv_obj_get_ext_attr(list);
+        if(list_ext->row_cb && (c == LV_KEY_RIGHT || c == LV_KEY_DOWN || c == LV_KEY_LEFT || c == LV_KEY_UP)) {
+            /*Step to the next/previous row of a virtual list even if it has no button yet*/
+            uint16_t row = list_ext->sel_row;
+            if(row == LV_LIST_ROW_NONE) row = 0;
+            else if(c == LV_KEY_RIGHT || c == LV_KEY_DOWN) row++;
+            else if(row > 0) row--;
+            virt_focus_row(list, row);
+        }
+        else if(c == LV_KEY_RIGHT || c == LV_KEY_DOWN) {
             lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
             /*If there is a valid selected button the make the previous selected*/
             if(ext->act_sel_btn) {
@@ -777,6 +893,25 @@ static lv_res_t lv_list_signal(lv_obj_t * list, lv_signal_t sign, void * param)
         }
 #endif
     }
+    else if(sign == LV_SIGNAL_COORD_CHG) {
+        /*A virtual list needs buttons for the rows visible with the new height*/
+        lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+        if(ext->row_cb && lv_obj_get_height(list) != lv_area_get_height(param)) {
+            virt_pool_create(list);
+        }
+    }
+    else if(sign == LV_SIGNAL_STYLE_CHG) {
+        /*The height of the rows might have changed*/
+        lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+        if(ext->row_cb) virt_pool_create(list);
+    }
+    else if(sign == LV_SIGNAL_CLEANUP) {
+        /*The buttons are already deleted*/
+        lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+        lv_mem_free(ext->virt_btn);
+        ext->virt_btn = NULL;
+        ext->virt_btn_cnt = 0;
+    }
     return res;
 }
 
@@ -825,13 +960,18 @@ static lv_res_t lv_list_btn_signal(lv_obj_t * btn, lv_signal_t sign, void * para
         }
     }
     else if(sign == LV_SIGNAL_CLEANUP) {
-#if LV_USE_GROUP
         lv_obj_t * list = lv_obj_get_parent(lv_obj_get_parent(btn));
         lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+#if LV_USE_GROUP
         lv_obj_t * sel  = lv_list_get_btn_selected(list);
         if(sel == btn) lv_list_focus_btn(list, lv_list_get_next_btn(list, btn));
         if(ext->last_sel_btn == btn) ext->last_sel_btn = NULL;
 #endif
+        /*Don't use the button in a virtual list anymore*/
+        uint16_t i;
+        for(i = 0; i < ext->virt_btn_cnt; i++) {
+            if(ext->virt_btn[i].btn == btn) ext->virt_btn[i].btn = NULL;
+        }
     }
     else if(sign == LV_SIGNAL_FOCUS) {
 #if LV_USE_GROUP
@@ -929,4 +1069,245 @@ static bool lv_list_is_list_img(lv_obj_t * list_img)
     return false;
 }
 
+/**
+ * Signal function of the list's scrollable part
+ * @param scrl pointer to the scrollable part of a list
+ * @param sign a signal type from lv_signal_t enum
+ * @param param pointer to a signal specific variable
+ * @return LV_RES_OK: the object is not deleted in the function; LV_RES_INV: the object is deleted
+ */
+static lv_res_t lv_list_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void * param)
+{
+    lv_res_t res;
+
+    /* Include the ancient signal function */
+    res = ancestor_scrl_signal(scrl, sign, param);
+    if(res != LV_RES_OK) return res;
+
+    if(sign == LV_SIGNAL_COORD_CHG) {
+        /*Move the buttons of a virtual list to the rows scrolled in*/
+        virt_refr(lv_obj_get_parent(scrl));
+    }
+
+    return res;
+}
+
+/**
+ * Scroll the list's scrollable to a given y coordinate with the list's animation time
+ * @param list pointer to a list object
+ * @param new_y the new y coordinate of the scrollable
+ */
+static void scrl_set_y(const lv_obj_t * list, lv_coord_t new_y)
+{
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    if(lv_list_get_anim_time(list) == 0) {
+        lv_obj_set_y(scrl, new_y);
+    }
+    else {
+#if LV_USE_ANIMATION
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, scrl);
+        lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_set_y);
+        lv_anim_set_values(&a, lv_obj_get_y(scrl), new_y);
+        lv_anim_set_time(&a, LV_LIST_DEF_ANIM_TIME);
+        lv_anim_start(&a);
+#endif
+    }
+}
+
+/**
+ * (Re)create the buttons of a virtual list: as many as can be visible at once plus one for the partially visible rows
+ * @param list pointer to a virtual list
+ */
+static void virt_pool_create(lv_obj_t * list)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    lv_list_row_cb_t row_cb = ext->row_cb;
+    uint16_t sel_row = ext->sel_row;
+    lv_coord_t scrl_y = lv_obj_get_y(scrl);
+
+    virt_pool_del(list);
+
+    /*Don't fill the buttons while they are created*/
+    ext->row_cb = NULL;
+
+    /*Create the first button with the normal layout to get the height of the rows*/
+    lv_page_set_scrollable_fit2(list, LV_FIT_PARENT, LV_FIT_TIGHT);
+    lv_page_set_scrl_layout(list, LV_LIST_LAYOUT_DEF);
+
+    lv_obj_t * btn = lv_list_add_btn(list, NULL, "");
+    if(btn == NULL) return;
+    ext->row_h = lv_obj_get_height(btn);
+
+    lv_coord_t pitch = ext->row_h + lv_obj_get_style_pad_inner(list, LV_LIST_PART_SCROLLABLE);
+    uint16_t cnt = lv_obj_get_height(list) / pitch + 2;
+
+    ext->virt_btn = lv_mem_alloc(cnt * sizeof(lv_list_virt_btn_t));
+    LV_ASSERT_MEM(ext->virt_btn);
+    if(ext->virt_btn == NULL) {
+        lv_obj_del(btn);
+        return;
+    }
+    _lv_memset_00(ext->virt_btn, cnt * sizeof(lv_list_virt_btn_t));
+    ext->virt_btn_cnt = cnt;
+
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        if(i > 0) btn = lv_list_add_btn(list, NULL, "");
+        if(btn == NULL) break;
+
+        ext->virt_btn[i].btn = btn;
+        ext->virt_btn[i].row = LV_LIST_ROW_NONE;
+    }
+
+    /*The buttons will be positioned to their rows.
+     *Hide them only now because a tight fit can't handle hidden children only.*/
+    lv_page_set_scrl_layout(list, LV_LAYOUT_OFF);
+    lv_page_set_scrollable_fit2(list, LV_FIT_PARENT, LV_FIT_NONE);
+    for(i = 0; i < cnt; i++) {
+        if(ext->virt_btn[i].btn) lv_obj_set_hidden(ext->virt_btn[i].btn, true);
+    }
+
+    ext->row_cb = row_cb;
+    ext->sel_row = sel_row;
+    virt_refr(list);
+
+    /*Keep the scroll position*/
+    lv_obj_set_y(scrl, scrl_y);
+}
+
+/**
+ * Delete the buttons of a virtual list
+ * @param list pointer to a virtual list
+ */
+static void virt_pool_del(lv_obj_t * list)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->virt_btn == NULL) return;
+
+    ext->act_sel_btn = NULL;
+#if LV_USE_GROUP
+    ext->last_sel_btn = NULL;
+#endif
+
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        if(ext->virt_btn[i].btn) lv_obj_del(ext->virt_btn[i].btn);
+    }
+
+    lv_mem_free(ext->virt_btn);
+    ext->virt_btn = NULL;
+    ext->virt_btn_cnt = 0;
+}
+
+/**
+ * Set the height of a virtual list's scrollable and move the buttons to the visible rows.
+ * Only the buttons whose row has changed are filled again.
+ * @param list pointer to a list object
+ */
+static void virt_refr(lv_obj_t * list)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cb == NULL || ext->virt_btn_cnt == 0) return;
+
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    lv_style_int_t top = lv_obj_get_style_pad_top(list, LV_LIST_PART_SCROLLABLE);
+    lv_style_int_t bottom = lv_obj_get_style_pad_bottom(list, LV_LIST_PART_SCROLLABLE);
+    lv_style_int_t inner = lv_obj_get_style_pad_inner(list, LV_LIST_PART_SCROLLABLE);
+    lv_coord_t pitch = ext->row_h + inner;
+
+    int32_t h = top + bottom;
+    if(ext->row_cnt > 0) h += (int32_t)ext->row_cnt * pitch - inner;
+    if(h > LV_COORD_MAX) h = LV_COORD_MAX;
+    if(lv_obj_get_height(scrl) != h) lv_obj_set_height(scrl, h);
+
+    /*The first row visible in the list*/
+    lv_coord_t y = list->coords.y1 - scrl->coords.y1 - top;
+    uint32_t first = y > 0 ? y / pitch : 0;
+
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        uint32_t row = first + i;
+        lv_list_virt_btn_t * v = &ext->virt_btn[row % ext->virt_btn_cnt];
+        if(v->btn == NULL) continue;
+
+        /*Rows past the end or below the (clamped) height of the scrollable have no button*/
+        int32_t btn_y = top + (int32_t)row * pitch;
+        if(row >= ext->row_cnt || btn_y > LV_COORD_MAX - ext->row_h) {
+            v->row = LV_LIST_ROW_NONE;
+            if(lv_obj_get_hidden(v->btn) == false) lv_obj_set_hidden(v->btn, true);
+            continue;
+        }
+
+        if(v->row == row) continue;
+
+        v->row = row;
+        lv_obj_set_y(v->btn, btn_y);
+        lv_obj_set_hidden(v->btn, false);
+
+        /*The selection belongs to the row, not to the button*/
+        if(row == ext->sel_row) {
+            lv_obj_add_state(v->btn, LV_STATE_FOCUSED);
+            ext->act_sel_btn = v->btn;
+        }
+        else {
+            lv_obj_clear_state(v->btn, LV_STATE_FOCUSED);
+            if(ext->act_sel_btn == v->btn) ext->act_sel_btn = NULL;
+        }
+#if LV_USE_GROUP
+        if(ext->last_sel_btn == v->btn && row != ext->sel_row) ext->last_sel_btn = NULL;
+#endif
+
+        ext->row_cb(list, v->btn, row);
+    }
+}
+
+/**
+ * Scroll a row of a virtual list into the list and select it
+ * @param list pointer to a virtual list
+ * @param row the row to select. Limited to the last row.
+ */
+static void virt_focus_row(lv_obj_t * list, uint16_t row)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cnt == 0 || ext->virt_btn_cnt == 0) return;
+    if(row >= ext->row_cnt) row = ext->row_cnt - 1;
+
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    lv_style_int_t top = lv_obj_get_style_pad_top(list, LV_LIST_PART_SCROLLABLE);
+    lv_coord_t pitch = ext->row_h + lv_obj_get_style_pad_inner(list, LV_LIST_PART_SCROLLABLE);
+    int32_t row_y = top + (int32_t)row * pitch + lv_obj_get_y(scrl);
+
+    /*Scroll the row into the list so that a button shows it*/
+    if(row_y < 0) {
+        lv_obj_set_y(scrl, lv_obj_get_y(scrl) - row_y);
+    }
+    else if(row_y + ext->row_h > lv_obj_get_height(list)) {
+        lv_obj_set_y(scrl, lv_obj_get_y(scrl) - (row_y + ext->row_h - lv_obj_get_height(list)));
+    }
+
+    lv_list_virt_btn_t * v = &ext->virt_btn[row % ext->virt_btn_cnt];
+    if(v->btn && v->row == row) lv_list_focus_btn(list, v->btn);
+}
+
+/**
+ * Get the row shown by a button of a virtual list
+ * @param list pointer to a virtual list
+ * @param btn pointer to a button of the list
+ * @return the row of the button or `LV_LIST_ROW_NONE` if it's not a visible button of the list
+ */
+static uint16_t virt_get_btn_row(const lv_obj_t * list, const lv_obj_t * btn)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        if(ext->virt_btn[i].btn == btn) return ext->virt_btn[i].row;
+    }
+
+    return LV_LIST_ROW_NONE;
+}
+
 #endif
@@ -43,6 +43,20 @@ extern "C" {
 /**********************
  *      TYPEDEFS
  **********************/
+
+/**
+ * Fill a button of a virtual list with the content of a row (see `lv_list_set_row_cb()`).
+ * The buttons are reused for other rows while scrolling so every row should set the same properties.
+ * E.g. `lv_label_set_text(lv_list_get_btn_label(btn), my_items[row])`
+ */
+typedef void (*lv_list_row_cb_t)(lv_obj_t * list, lv_obj_t * btn, uint16_t row);
+
+/*A button of a virtual list and the row it shows*/
+typedef struct {
+    lv_obj_t * btn;
+    uint16_t row;
+} lv_list_virt_btn_t;
+
 /*Data of list*/
 typedef struct {
     lv_page_ext_t page; /*Ext. of ancestor*/
@@ -52,6 +66,12 @@ typedef struct {
     lv_obj_t * last_sel_btn;     /* The last selected button. It will be reverted when the list is focused again */
 #endif
     lv_obj_t * act_sel_btn; /* The button is currently being selected*/
+    lv_list_row_cb_t row_cb;        /*Fills the buttons of a virtual list. NULL: not virtual*/
+    lv_list_virt_btn_t * virt_btn;  /*Buttons for the visible rows. Row `r` is shown by `virt_btn[r % virt_btn_cnt]`*/
+    uint16_t virt_btn_cnt;
+    uint16_t row_cnt;               /*Number of rows in a virtual list*/
+    uint16_t sel_row;               /*The selected row of a virtual list*/
+    lv_coord_t row_h;               /*Height of a row in a virtual list*/
 } lv_list_ext_t;
 
 /** List styles. */
@@ -117,6 +137,26 @@ bool lv_list_remove(const lv_obj_t * list, uint16_t index);
  */
 void lv_list_focus_btn(lv_obj_t * list, lv_obj_t * btn);
 
+/**
+ * Make the list virtual: create buttons only for the visible rows and fill them from a callback.
+ * While scrolling the buttons of the rows leaving the list are moved to the rows becoming visible
+ * so scrolling costs are proportional to the visible rows, not to `row_cnt`.
+ * All rows have the height of the first button. The existing buttons of the list are deleted
+ * and `lv_list_add_btn/remove()` can't be used while the list is virtual.
+ * @param list pointer to a list object
+ * @param cb callback to fill a button with the content of a row or `NULL` to make the list normal again
+ * @param row_cnt number of rows
+ */
+void lv_list_set_row_cb(lv_obj_t * list, lv_list_row_cb_t cb, uint16_t row_cnt);
+
+/**
+ * Set the number of rows of a virtual list. The visible rows are filled again
+ * so it can be used to refresh the list when its content has changed.
+ * @param list pointer to a list object
+ * @param row_cnt number of rows
+ */
+void lv_list_set_row_cnt(lv_obj_t * list, uint16_t row_cnt);
+
 /**
  * Set the scroll bar mode of a list
  * @param list pointer to a list object
@@ -209,14 +249,15 @@ lv_obj_t * lv_list_get_next_btn(const lv_obj_t * list, lv_obj_t * prev_btn);
  * Get the index of the button in the list
  * @param list pointer to a list object. If NULL, assumes btn is part of a list.
  * @param btn pointer to a list element (button)
- * @return the index of the button in the list, or -1 of the button not in this list
+ * @return the index of the button in the list, or -1 of the button not in this list.
+ *         In a virtual list the row shown by the button.
  */
 int32_t lv_list_get_btn_index(const lv_obj_t * list, const lv_obj_t * btn);
 
 /**
  * Get the number of buttons in the list
  * @param list pointer to a list object
- * @return the number of buttons in the list
+ * @return the number of buttons in the list or the number of rows in a virtual list
  */
 uint16_t lv_list_get_size(const lv_obj_t * list);
 
@@ -41,6 +41,10 @@ static void refr_height(lv_obj_t * roller);
 static void refr_width(lv_obj_t * roller);
 static lv_res_t release_handler(lv_obj_t * roller);
 static void inf_normalize(void * roller_scrl);
+static const lv_txt_line_cache_t * inf_get_options(lv_obj_t * roller);
+static void inf_refr_label_size(lv_obj_t * roller);
+static void inf_draw_options(lv_obj_t * roller, const lv_area_t * clip_area, const lv_draw_label_dsc_t * dsc,
+                             lv_coord_t ofs_y);
 static lv_obj_t * get_label(const lv_obj_t * roller);
 #if LV_USE_ANIMATION
     static void scroll_anim_ready_cb(lv_anim_t * a);
@@ -93,6 +97,7 @@ lv_obj_t * lv_roller_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->sel_opt_id = 0;
     ext->sel_opt_id_ori = 0;
     ext->auto_fit = 1;
+    _lv_txt_line_cache_init(&ext->inf_opts);
     lv_style_list_init(&ext->style_sel);
 
     /*The signal and design functions are not copied so set them here*/
@@ -122,7 +127,8 @@ lv_obj_t * lv_roller_create(lv_obj_t * par, const lv_obj_t * copy)
     }
     /*Copy an existing roller*/
     else {
-        lv_label_create(roller, get_label(copy));
+        lv_obj_t * label = lv_label_create(roller, get_label(copy));
+        lv_obj_set_design_cb(label, lv_roller_label_design);
 
         lv_roller_ext_t * copy_ext = lv_obj_get_ext_attr(copy);
         ext->mode = copy_ext->mode;
@@ -171,23 +177,20 @@ void lv_roller_set_options(lv_obj_t * roller, const char * options, lv_roller_mo
     }
     ext->option_cnt++; /*Last option has no `\n`*/
 
+    _lv_txt_line_cache_invalidate(&ext->inf_opts);
+
     if(mode == LV_ROLLER_MODE_NORMAL) {
         ext->mode = LV_ROLLER_MODE_NORMAL;
+        lv_label_set_long_mode(label, LV_LABEL_LONG_EXPAND);
         lv_label_set_text(label, options);
     }
     else {
         ext->mode = LV_ROLLER_MODE_INFINITE;
 
-        size_t opt_len = strlen(options) + 1; /*+1 to add '\n' after option lists*/
-        char * opt_extra = _lv_mem_buf_get(opt_len * LV_ROLLER_INF_PAGES);
-        uint8_t i;
-        for(i = 0; i < LV_ROLLER_INF_PAGES; i++) {
-            strcpy(&opt_extra[opt_len * i], options);
-            opt_extra[opt_len * (i + 1) - 1] = '\n';
-        }
-        opt_extra[opt_len * LV_ROLLER_INF_PAGES - 1] = '\0';
-        lv_label_set_text(label, opt_extra);
-        _lv_mem_buf_release(opt_extra);
+        /* Store the options only once. The label is sized as if the options were repeated
+         * `LV_ROLLER_INF_PAGES` times and only the visible rows are drawn (see `refr_height`)*/
+        lv_label_set_long_mode(label, LV_LABEL_LONG_CROP);
+        lv_label_set_text(label, options);
 
         ext->sel_opt_id     = ((LV_ROLLER_INF_PAGES / 2) + 0) * ext->option_cnt;
 
@@ -220,6 +223,10 @@ void lv_roller_set_align(lv_obj_t * roller, lv_label_align_t align)
  * Set the selected option
  * @param roller pointer to a roller object
  * @param sel_opt id of the selected option (0 ... number of option - 1);
+ *                In `LV_ROLLER_MODE_INFINITE` it's taken modulo the number of options and the option
+ *                is selected on the copy of the options which is currently visible.
+ *                (Before, the ID was shifted by `LV_ROLLER_INF_PAGES` per page, not by the number
+ *                of options, so an other option could be selected.)
  * @param anim_en LV_ANIM_ON: set with animation; LV_ANOM_OFF set immediately
  */
 void lv_roller_set_selected(lv_obj_t * roller, uint16_t sel_opt, lv_anim_enable_t anim)
@@ -238,17 +245,9 @@ void lv_roller_set_selected(lv_obj_t * roller, uint16_t sel_opt, lv_anim_enable_
 
     /*In infinite mode interpret the new ID relative to the currently visible "page"*/
     if(ext->mode == LV_ROLLER_MODE_INFINITE) {
-        int32_t sel_opt_signed = sel_opt;
-        uint16_t page = ext->sel_opt_id / LV_ROLLER_INF_PAGES;
-
-        /* `sel_opt` should be less than the number of options set by the user.
-         * If it's more then probably it's a reference from not the first page
-         * so normalize `sel_opt` */
-        if(page != 0) {
-            sel_opt_signed -= page * LV_ROLLER_INF_PAGES;
-        }
-
-        sel_opt = page * LV_ROLLER_INF_PAGES + sel_opt_signed;
+        uint16_t real_id_cnt = ext->option_cnt / LV_ROLLER_INF_PAGES;
+        uint16_t page = ext->sel_opt_id / real_id_cnt;
+        sel_opt = page * real_id_cnt + sel_opt % real_id_cnt;
     }
 
     ext->sel_opt_id     = sel_opt < ext->option_cnt ? sel_opt : ext->option_cnt - 1;
@@ -320,14 +319,14 @@ void lv_roller_get_selected_str(const lv_obj_t * roller, char * buf, uint32_t bu
 {
     LV_ASSERT_OBJ(roller, LV_OBJX_NAME);
 
-    lv_roller_ext_t * ext = lv_obj_get_ext_attr(roller);
     lv_obj_t * label = get_label(roller);
     uint32_t i;
     uint16_t line        = 0;
+    uint16_t sel_opt_id  = lv_roller_get_selected(roller);
     const char * opt_txt = lv_label_get_text(label);
     size_t txt_len     = strlen(opt_txt);
 
-    for(i = 0; i < txt_len && line != ext->sel_opt_id; i++) {
+    for(i = 0; i < txt_len && line != sel_opt_id; i++) {
         if(opt_txt[i] == '\n') line++;
     }
 
@@ -457,7 +456,18 @@ static lv_design_res_t lv_roller_design(lv_obj_t * roller, const lv_area_t * cli
         lv_area_t mask_sel;
         bool area_ok;
         area_ok = _lv_area_intersect(&mask_sel, clip_area, &rect_area);
-        if(area_ok) {
+        lv_roller_ext_t * ext = lv_obj_get_ext_attr(roller);
+        if(area_ok && ext->mode == LV_ROLLER_MODE_INFINITE) {
+            lv_label_align_t label_align = lv_roller_get_align(roller);
+            if(LV_LABEL_ALIGN_CENTER == label_align) label_dsc.flag |= LV_TXT_FLAG_CENTER;
+            else if(LV_LABEL_ALIGN_RIGHT == label_align) label_dsc.flag |= LV_TXT_FLAG_RIGHT;
+
+            /*Draw the selected rows directly. Center them to the rows of the normal font*/
+            const lv_font_t * normal_label_font = lv_obj_get_style_text_font(roller, LV_ROLLER_PART_BG);
+            lv_coord_t corr = (label_dsc.font->line_height - normal_label_font->line_height) / 2;
+            inf_draw_options(roller, &mask_sel, &label_dsc, corr);
+        }
+        else if(area_ok) {
             lv_obj_t * label = get_label(roller);
             lv_label_align_t label_align = lv_roller_get_align(roller);
 
@@ -540,13 +550,25 @@ static lv_design_res_t lv_roller_label_design(lv_obj_t * label, const lv_area_t
         rect_area.x1 = roller_coords.x1;
         rect_area.x2 = roller_coords.x2;
 
+        /*In infinite mode the label has the options only once so draw the visible rows one by one*/
+        lv_roller_ext_t * ext = lv_obj_get_ext_attr(roller);
+        lv_draw_label_dsc_t label_dsc;
+        if(ext->mode == LV_ROLLER_MODE_INFINITE) {
+            lv_draw_label_dsc_init(&label_dsc);
+            lv_obj_init_draw_label_dsc(label, LV_LABEL_PART_MAIN, &label_dsc);
+            lv_label_align_t label_align = lv_label_get_align(label);
+            if(label_align == LV_LABEL_ALIGN_CENTER) label_dsc.flag |= LV_TXT_FLAG_CENTER;
+            else if(label_align == LV_LABEL_ALIGN_RIGHT) label_dsc.flag |= LV_TXT_FLAG_RIGHT;
+        }
+
         lv_area_t clip2;
         clip2.x1 = label->coords.x1;
         clip2.y1 = label->coords.y1;
         clip2.x2 = label->coords.x2;
         clip2.y2 = rect_area.y1;
         if(_lv_area_intersect(&clip2, clip_area, &clip2)) {
-            ancestor_label_design(label, &clip2, mode);
+            if(ext->mode == LV_ROLLER_MODE_INFINITE) inf_draw_options(roller, &clip2, &label_dsc, 0);
+            else ancestor_label_design(label, &clip2, mode);
         }
 
         clip2.x1 = label->coords.x1;
@@ -554,7 +576,8 @@ static lv_design_res_t lv_roller_label_design(lv_obj_t * label, const lv_area_t
         clip2.x2 = label->coords.x2;
         clip2.y2 = label->coords.y2;
         if(_lv_area_intersect(&clip2, clip_area, &clip2)) {
-            ancestor_label_design(label, &clip2, mode);
+            if(ext->mode == LV_ROLLER_MODE_INFINITE) inf_draw_options(roller, &clip2, &label_dsc, 0);
+            else ancestor_label_design(label, &clip2, mode);
         }
     }
 
@@ -649,25 +672,25 @@ static lv_res_t lv_roller_signal(lv_obj_t * roller, lv_signal_t sign, void * par
     else if(sign == LV_SIGNAL_CONTROL) {
 #if LV_USE_GROUP
         char c = *((char *)param);
+        /* Step the ID directly (not with `lv_roller_set_selected`) because in infinite mode
+         * it's an ID on the whole scrollable range, not on the visible "page"*/
         if(c == LV_KEY_RIGHT || c == LV_KEY_DOWN) {
             if(ext->sel_opt_id + 1 < ext->option_cnt) {
-                uint16_t ori_id = ext->sel_opt_id_ori; /*lv_roller_set_selected will overwrite this*/
-                lv_roller_set_selected(roller, ext->sel_opt_id + 1, true);
-                ext->sel_opt_id_ori = ori_id;
+                ext->sel_opt_id++;
+                refr_position(roller, LV_ANIM_ON);
             }
         }
         else if(c == LV_KEY_LEFT || c == LV_KEY_UP) {
             if(ext->sel_opt_id > 0) {
-                uint16_t ori_id = ext->sel_opt_id_ori; /*lv_roller_set_selected will overwrite this*/
-
-                lv_roller_set_selected(roller, ext->sel_opt_id - 1, true);
-                ext->sel_opt_id_ori = ori_id;
+                ext->sel_opt_id--;
+                refr_position(roller, LV_ANIM_ON);
             }
         }
 #endif
     }
     else if(sign == LV_SIGNAL_CLEANUP) {
         lv_obj_clean_style_list(roller, LV_ROLLER_PART_SELECTED);
+        _lv_txt_line_cache_invalidate(&ext->inf_opts);
     }
     return res;
 }
@@ -902,7 +925,25 @@ static lv_res_t release_handler(lv_obj_t * roller)
     lv_obj_t * label = get_label(roller);
     if(label == NULL) return LV_RES_OK;
 
-    if(lv_indev_get_type(indev) == LV_INDEV_TYPE_POINTER || lv_indev_get_type(indev) == LV_INDEV_TYPE_BUTTON) {
+    if((lv_indev_get_type(indev) == LV_INDEV_TYPE_POINTER || lv_indev_get_type(indev) == LV_INDEV_TYPE_BUTTON) &&
+       ext->mode == LV_ROLLER_MODE_INFINITE) {
+        /*The label has the options only once so find the clicked row by its position*/
+        lv_point_t p;
+        lv_indev_get_point(indev, &p);
+        p.y -= label->coords.y1 + lv_obj_get_style_pad_top(label, LV_LABEL_PART_MAIN);
+
+        const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+        lv_style_int_t line_space = lv_obj_get_style_text_line_space(label, LV_LABEL_PART_MAIN);
+        lv_coord_t font_h = lv_font_get_line_height(font);
+        int32_t row = 0;
+        if(p.y > font_h && font_h + line_space > 0) row = (p.y - font_h + font_h + line_space - 1) / (font_h + line_space);
+        if(row >= ext->option_cnt) row = ext->option_cnt - 1;
+
+        ext->sel_opt_id     = row;
+        ext->sel_opt_id_ori = row;
+        refr_position(roller, LV_ANIM_ON);
+    }
+    else if(lv_indev_get_type(indev) == LV_INDEV_TYPE_POINTER || lv_indev_get_type(indev) == LV_INDEV_TYPE_BUTTON) {
         /*Search the clicked option (For KEYPAD and ENCODER the new value should be already set)*/
         uint16_t new_opt  = 0;
         lv_point_t p;
@@ -980,6 +1021,9 @@ static void refr_height(lv_obj_t * roller)
     lv_obj_t * label = get_label(roller);
     if(label == NULL) return;
 
+    lv_roller_ext_t * ext = lv_obj_get_ext_attr(roller);
+    if(ext->mode == LV_ROLLER_MODE_INFINITE) inf_refr_label_size(roller);
+
     lv_obj_set_height(lv_page_get_scrollable(roller), lv_obj_get_height(label) + lv_obj_get_height(roller));
 
 #if LV_USE_ANIMATION
@@ -1020,6 +1064,109 @@ static void inf_normalize(void * scrl)
     }
 }
 
+/**
+ * Get the start of every option in infinite mode
+ * @param roller pointer to a roller object
+ * @return the line cache of the label's text (one line is one option) or NULL if out of memory
+ */
+static const lv_txt_line_cache_t * inf_get_options(lv_obj_t * roller)
+{
+    lv_roller_ext_t * ext = lv_obj_get_ext_attr(roller);
+    lv_obj_t * label = get_label(roller);
+
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_style_int_t letter_space = lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN);
+
+    /*Break the lines only at `\n`-s*/
+    if(_lv_txt_line_cache_update(&ext->inf_opts, lv_label_get_text(label), font, letter_space, LV_COORD_MAX,
+                                 LV_TXT_FLAG_EXPAND) == false) {
+        return NULL;
+    }
+
+    return &ext->inf_opts;
+}
+
+/**
+ * Size the label in infinite mode as if the options were repeated `LV_ROLLER_INF_PAGES` times
+ * @param roller pointer to a roller object
+ */
+static void inf_refr_label_size(lv_obj_t * roller)
+{
+    lv_roller_ext_t * ext = lv_obj_get_ext_attr(roller);
+    lv_obj_t * label = get_label(roller);
+
+    const lv_txt_line_cache_t * opts = inf_get_options(roller);
+    if(opts == NULL) return;
+
+    lv_coord_t w = 0;
+    uint32_t i;
+    for(i = 0; i < opts->line_cnt; i++) {
+        w = LV_MATH_MAX(w, opts->lines[i].w);
+    }
+
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_style_int_t line_space = lv_obj_get_style_text_line_space(label, LV_LABEL_PART_MAIN);
+    lv_coord_t h = ext->option_cnt * (lv_font_get_line_height(font) + line_space) - line_space;
+
+    w += lv_obj_get_style_pad_left(label, LV_LABEL_PART_MAIN) + lv_obj_get_style_pad_right(label, LV_LABEL_PART_MAIN);
+    h += lv_obj_get_style_pad_top(label, LV_LABEL_PART_MAIN) + lv_obj_get_style_pad_bottom(label, LV_LABEL_PART_MAIN);
+    lv_obj_set_size(label, w, h);
+}
+
+/**
+ * Draw the rows of an infinite roller which are on the clip area.
+ * The `row`th row shows the `row % option count`th option.
+ * @param roller pointer to a roller object
+ * @param clip_area draw only the rows on this area
+ * @param dsc draw descriptor of the text
+ * @param ofs_y move the rows up by this value
+ */
+static void inf_draw_options(lv_obj_t * roller, const lv_area_t * clip_area, const lv_draw_label_dsc_t * dsc,
+                             lv_coord_t ofs_y)
+{
+    lv_roller_ext_t * ext = lv_obj_get_ext_attr(roller);
+    lv_obj_t * label = get_label(roller);
+
+    const lv_txt_line_cache_t * opts = inf_get_options(roller);
+    if(opts == NULL) return;
+
+    /*The rows follow each other like the lines of the label*/
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_style_int_t line_space = lv_obj_get_style_text_line_space(label, LV_LABEL_PART_MAIN);
+    lv_coord_t row_h = lv_font_get_line_height(font) + line_space;
+    if(row_h <= 0) return;
+
+    lv_area_t txt_coords;
+    lv_obj_get_coords(label, &txt_coords);
+    txt_coords.x1 += lv_obj_get_style_pad_left(label, LV_LABEL_PART_MAIN);
+    txt_coords.x2 -= lv_obj_get_style_pad_right(label, LV_LABEL_PART_MAIN);
+    txt_coords.y1 += lv_obj_get_style_pad_top(label, LV_LABEL_PART_MAIN) - ofs_y;
+
+    /*Start one row earlier because a larger font can reach into the next row*/
+    int32_t row = 0;
+    if(clip_area->y1 > txt_coords.y1) row = (clip_area->y1 - txt_coords.y1) / row_h - 1;
+    if(row < 0) row = 0;
+
+    const char * txt = lv_label_get_text(label);
+    uint16_t real_id_cnt = ext->option_cnt / LV_ROLLER_INF_PAGES;
+    for(; row < ext->option_cnt; row++) {
+        lv_area_t row_area;
+        row_area.x1 = txt_coords.x1;
+        row_area.x2 = txt_coords.x2;
+        row_area.y1 = txt_coords.y1 + row * row_h;
+        row_area.y2 = row_area.y1 + lv_font_get_line_height(dsc->font) + dsc->line_space - 1;
+        if(row_area.y1 > clip_area->y2) break;
+
+        uint32_t opt = row % real_id_cnt;
+        if(opt >= opts->line_cnt) continue;     /*Empty option after a closing `\n`*/
+
+        /*Clip to the row to draw only one option*/
+        lv_area_t row_clip;
+        if(_lv_area_intersect(&row_clip, clip_area, &row_area) == false) continue;
+        lv_draw_label(&row_area, &row_clip, dsc, &txt[opts->lines[opt].start], NULL);
+    }
+}
+
 static lv_obj_t * get_label(const lv_obj_t * roller)
 {
     lv_obj_t * scrl = lv_page_get_scrollable(roller);
@@ -51,6 +51,7 @@ typedef struct {
     uint16_t option_cnt;          /*Number of options*/
     uint16_t sel_opt_id;          /*Index of the current option*/
     uint16_t sel_opt_id_ori;      /*Store the original index on focus*/
+    lv_txt_line_cache_t inf_opts; /*Start of the options in infinite mode*/
     lv_roller_mode_t mode : 1;
     uint8_t auto_fit : 1;         /*1: Automatically set the width*/
 } lv_roller_ext_t;
@@ -97,6 +98,10 @@ void lv_roller_set_align(lv_obj_t * roller, lv_label_align_t align);
  * Set the selected option
  * @param roller pointer to a roller object
  * @param sel_opt id of the selected option (0 ... number of option - 1);
+ *                In `LV_ROLLER_MODE_INFINITE` it's taken modulo the number of options and the option
+ *                is selected on the copy of the options which is currently visible.
+ *                (Before, the ID was shifted by `LV_ROLLER_INF_PAGES` per page, not by the number
+ *                of options, so an other option could be selected.)
  * @param anim LV_ANIM_ON: set with animation; LV_ANIM_OFF set immediately
  */
 void lv_roller_set_selected(lv_obj_t * roller, uint16_t sel_opt, lv_anim_enable_t anim);
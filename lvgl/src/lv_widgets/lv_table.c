@@ -36,7 +36,11 @@ static lv_style_list_t * lv_table_get_style(lv_obj_t * table, uint8_t part);
 static lv_coord_t get_row_height(lv_obj_t * table, uint16_t row_id, const lv_font_t ** font,
                                  lv_style_int_t * letter_space, lv_style_int_t * line_space,
                                  lv_style_int_t * cell_left, lv_style_int_t * cell_right, lv_style_int_t * cell_top, lv_style_int_t * cell_bottom);
-static void refr_size(lv_obj_t * table);
+static void refr_size(lv_obj_t * table, uint16_t start_row);
+static uint16_t get_row_at(lv_obj_t * table, lv_coord_t y, lv_coord_t * row_y);
+static char ** get_row_cells(lv_obj_t * table, uint16_t row, char ** buf);
+static const char * get_cb_cell(lv_obj_t * table, uint16_t row, uint16_t col, lv_table_cell_format_t * format);
+static void free_cell_data(lv_obj_t * table);
 
 /**********************
  *  STATIC VARIABLES
@@ -83,6 +87,11 @@ lv_obj_t * lv_table_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->col_cnt       = 0;
     ext->row_cnt       = 0;
     ext->row_h         = NULL;
+    ext->cell_cb       = NULL;
+    ext->cell_buf      = NULL;
+    ext->cell_buf_size = 0;
+    ext->row_ofs_id    = 0;
+    ext->row_ofs_y     = 0;
     ext->cell_types    = 1;
 
     uint16_t i;
@@ -108,6 +117,7 @@ lv_obj_t * lv_table_create(lv_obj_t * par, const lv_obj_t * copy)
         for(i = 0; i < LV_TABLE_CELL_STYLE_CNT; i++) {
             lv_style_list_copy(&ext->cell_style[i], &copy_ext->cell_style[i]);
         }
+        if(copy_ext->cell_cb) lv_table_set_cell_cb(table, copy_ext->cell_cb);
         lv_table_set_row_cnt(table, copy_ext->row_cnt);
         lv_table_set_col_cnt(table, copy_ext->col_cnt);
 
@@ -142,6 +152,10 @@ void lv_table_set_cell_value(lv_obj_t * table, uint16_t row, uint16_t col, const
         LV_LOG_WARN("lv_table_set_cell_value: invalid column");
         return;
     }
+    if(ext->cell_cb) {
+        LV_LOG_WARN("lv_table_set_cell_value: the cells are given by a callback");
+        return;
+    }
 
     /*Auto expand*/
     if(row >= ext->row_cnt) {
@@ -188,7 +202,7 @@ void lv_table_set_cell_value(lv_obj_t * table, uint16_t row, uint16_t col, const
 #endif
 
     ext->cell_data[cell][0] = format.format_byte;
-    refr_size(table);
+    refr_size(table, row);
 }
 
 /**
@@ -208,6 +222,10 @@ void lv_table_set_cell_value_fmt(lv_obj_t * table, uint16_t row, uint16_t col, c
         LV_LOG_WARN("lv_table_set_cell_value: invalid column");
         return;
     }
+    if(ext->cell_cb) {
+        LV_LOG_WARN("lv_table_set_cell_value: the cells are given by a callback");
+        return;
+    }
 
     /*Auto expand*/
     if(row >= ext->row_cnt) {
@@ -283,7 +301,7 @@ void lv_table_set_cell_value_fmt(lv_obj_t * table, uint16_t row, uint16_t col, c
     va_end(ap2);
 
     ext->cell_data[cell][0] = format.format_byte;
-    refr_size(table);
+    refr_size(table, row);
 }
 
 /**
@@ -309,7 +327,7 @@ void lv_table_set_row_cnt(lv_obj_t * table, uint16_t row_cnt)
         ext->row_h = NULL;
     }
 
-    if(ext->row_cnt > 0 && ext->col_cnt > 0) {
+    if(ext->row_cnt > 0 && ext->col_cnt > 0 && ext->cell_cb == NULL) {
         ext->cell_data = lv_mem_realloc(ext->cell_data, ext->row_cnt * ext->col_cnt * sizeof(char *));
         LV_ASSERT_MEM(ext->cell_data);
         if(ext->cell_data == NULL) return;
@@ -326,7 +344,8 @@ void lv_table_set_row_cnt(lv_obj_t * table, uint16_t row_cnt)
         ext->cell_data = NULL;
     }
 
-    refr_size(table);
+    /*Only the new rows need to be measured*/
+    refr_size(table, old_row_cnt);
 }
 
 /**
@@ -347,7 +366,7 @@ void lv_table_set_col_cnt(lv_obj_t * table, uint16_t col_cnt)
     uint16_t old_col_cnt = ext->col_cnt;
     ext->col_cnt         = col_cnt;
 
-    if(ext->row_cnt > 0 && ext->col_cnt > 0) {
+    if(ext->row_cnt > 0 && ext->col_cnt > 0 && ext->cell_cb == NULL) {
         ext->cell_data = lv_mem_realloc(ext->cell_data, ext->row_cnt * ext->col_cnt * sizeof(char *));
         LV_ASSERT_MEM(ext->cell_data);
         if(ext->cell_data == NULL) return;
@@ -364,7 +383,7 @@ void lv_table_set_col_cnt(lv_obj_t * table, uint16_t col_cnt)
         lv_mem_free(ext->cell_data);
         ext->cell_data = NULL;
     }
-    refr_size(table);
+    refr_size(table, 0);
 }
 
 /**
@@ -384,7 +403,7 @@ void lv_table_set_col_width(lv_obj_t * table, uint16_t col_id, lv_coord_t w)
 
     lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
     ext->col_w[col_id]   = w;
-    refr_size(table);
+    refr_size(table, 0);
 }
 
 /**
@@ -403,6 +422,10 @@ void lv_table_set_cell_align(lv_obj_t * table, uint16_t row, uint16_t col, lv_la
         LV_LOG_WARN("lv_table_set_cell_align: invalid column");
         return;
     }
+    if(ext->cell_cb) {
+        LV_LOG_WARN("lv_table_set_cell_align: the cells are given by a callback");
+        return;
+    }
 
     /*Auto expand*/
     if(row >= ext->row_cnt) {
@@ -441,6 +464,10 @@ void lv_table_set_cell_type(lv_obj_t * table, uint16_t row, uint16_t col, uint8_
         LV_LOG_WARN("lv_table_set_cell_type: invalid column");
         return;
     }
+    if(ext->cell_cb) {
+        LV_LOG_WARN("lv_table_set_cell_type: the cells are given by a callback");
+        return;
+    }
 
     /*Auto expand*/
     if(row >= ext->row_cnt) {
@@ -487,6 +514,10 @@ void lv_table_set_cell_crop(lv_obj_t * table, uint16_t row, uint16_t col, bool c
         LV_LOG_WARN("lv_table_set_cell_crop: invalid column");
         return;
     }
+    if(ext->cell_cb) {
+        LV_LOG_WARN("lv_table_set_cell_crop: the cells are given by a callback");
+        return;
+    }
 
     /*Auto expand*/
     if(row >= ext->row_cnt) {
@@ -526,6 +557,10 @@ void lv_table_set_cell_merge_right(lv_obj_t * table, uint16_t row, uint16_t col,
         LV_LOG_WARN("lv_table_set_cell_merge_right: invalid column");
         return;
     }
+    if(ext->cell_cb) {
+        LV_LOG_WARN("lv_table_set_cell_merge_right: the cells are given by a callback");
+        return;
+    }
 
     /*Auto expand*/
     if(row >= ext->row_cnt) {
@@ -547,7 +582,50 @@ void lv_table_set_cell_merge_right(lv_obj_t * table, uint16_t row, uint16_t col,
     format.format_byte      = ext->cell_data[cell][0];
     format.s.right_merge    = en ? 1 : 0;
     ext->cell_data[cell][0] = format.format_byte;
-    refr_size(table);
+    refr_size(table, row);
+}
+
+/**
+ * Get the cells from a callback instead of storing them in the table.
+ * @param table pointer to a Table object
+ * @param cb callback to get the cells or `NULL` to store the cells in the table again (the cells will be empty)
+ */
+void lv_table_set_cell_cb(lv_obj_t * table, lv_table_cell_cb_t cb)
+{
+    LV_ASSERT_OBJ(table, LV_OBJX_NAME);
+
+    lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+
+    free_cell_data(table);
+    lv_mem_free(ext->cell_buf);
+    ext->cell_buf      = NULL;
+    ext->cell_buf_size = 0;
+    ext->cell_cb       = cb;
+
+    if(cb) {
+        /*Any cell type can be returned by the callback*/
+        ext->cell_types = (1 << LV_TABLE_CELL_STYLE_CNT) - 1;
+    }
+    else if(ext->row_cnt > 0 && ext->col_cnt > 0) {
+        ext->cell_data = lv_mem_alloc(ext->row_cnt * ext->col_cnt * sizeof(char *));
+        LV_ASSERT_MEM(ext->cell_data);
+        if(ext->cell_data == NULL) return;
+        _lv_memset_00(ext->cell_data, ext->row_cnt * ext->col_cnt * sizeof(char *));
+    }
+
+    refr_size(table, 0);
+}
+
+/**
+ * Measure the rows again from a given row and redraw the table.
+ * @param table pointer to a Table object
+ * @param start_row the first changed row. The rows after it are measured too.
+ */
+void lv_table_refresh_rows(lv_obj_t * table, uint16_t start_row)
+{
+    LV_ASSERT_OBJ(table, LV_OBJX_NAME);
+
+    refr_size(table, start_row);
 }
 
 /*=====================
@@ -570,6 +648,13 @@ const char * lv_table_get_cell_value(lv_obj_t * table, uint16_t row, uint16_t co
         LV_LOG_WARN("lv_table_set_cell_value: invalid row or column");
         return "";
     }
+
+    if(ext->cell_cb) {
+        lv_table_cell_format_t format;
+        const char * txt = get_cb_cell(table, row, col, &format);
+        return txt ? txt : "";
+    }
+
     uint32_t cell = row * ext->col_cnt + col;
 
     if(ext->cell_data[cell] == NULL) return "";
@@ -639,6 +724,13 @@ lv_label_align_t lv_table_get_cell_align(lv_obj_t * table, uint16_t row, uint16_
         LV_LOG_WARN("lv_table_set_cell_align: invalid row or column");
         return LV_LABEL_ALIGN_LEFT; /*Just return with something*/
     }
+
+    if(ext->cell_cb) {
+        lv_table_cell_format_t format;
+        get_cb_cell(table, row, col, &format);
+        return format.s.align;
+    }
+
     uint32_t cell = row * ext->col_cnt + col;
 
     if(ext->cell_data[cell] == NULL)
@@ -666,6 +758,13 @@ lv_label_align_t lv_table_get_cell_type(lv_obj_t * table, uint16_t row, uint16_t
         LV_LOG_WARN("lv_table_get_cell_type: invalid row or column");
         return 1; /*Just return with something*/
     }
+
+    if(ext->cell_cb) {
+        lv_table_cell_format_t format;
+        get_cb_cell(table, row, col, &format);
+        return format.s.type + 1;
+    }
+
     uint32_t cell = row * ext->col_cnt + col;
 
     if(ext->cell_data[cell] == NULL)
@@ -693,6 +792,13 @@ lv_label_align_t lv_table_get_cell_crop(lv_obj_t * table, uint16_t row, uint16_t
         LV_LOG_WARN("lv_table_get_cell_crop: invalid row or column");
         return false; /*Just return with something*/
     }
+
+    if(ext->cell_cb) {
+        lv_table_cell_format_t format;
+        get_cb_cell(table, row, col, &format);
+        return format.s.crop;
+    }
+
     uint32_t cell = row * ext->col_cnt + col;
 
     if(ext->cell_data[cell] == NULL)
@@ -721,6 +827,12 @@ bool lv_table_get_cell_merge_right(lv_obj_t * table, uint16_t row, uint16_t col)
         return false;
     }
 
+    if(ext->cell_cb) {
+        lv_table_cell_format_t format;
+        get_cb_cell(table, row, col, &format);
+        return format.s.right_merge ? true : false;
+    }
+
     uint32_t cell = row * ext->col_cnt + col;
 
     if(ext->cell_data[cell] == NULL)
@@ -732,6 +844,19 @@ bool lv_table_get_cell_merge_right(lv_obj_t * table, uint16_t row, uint16_t col)
     }
 }
 
+/**
+ * Get the callback which supplies the cells
+ * @param table pointer to a Table object
+ * @return the callback set by `lv_table_set_cell_cb()` or `NULL` if the cells are stored in the table
+ */
+lv_table_cell_cb_t lv_table_get_cell_cb(lv_obj_t * table)
+{
+    LV_ASSERT_OBJ(table, LV_OBJX_NAME);
+
+    lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+    return ext->cell_cb;
+}
+
 /**
  * Get the last pressed or being pressed cell
  * @param table pointer to a table object
@@ -772,11 +897,9 @@ lv_res_t lv_table_get_pressed_cell(lv_obj_t * table, uint16_t * row, uint16_t *
         y -= lv_obj_get_style_pad_top(table, LV_TABLE_PART_BG);
 
         *row = 0;
-        tmp = 0;
-
-        for(*row = 0; *row < ext->row_cnt; (*row)++) {
-            tmp += ext->row_h[*row];
-            if(y < tmp) break;
+        if(ext->row_cnt > 0) {
+            *row = get_row_at(table, y, &tmp);
+            if(y >= tmp + ext->row_h[*row]) *row = ext->row_cnt;
         }
     }
 
@@ -848,12 +971,18 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
 
         uint16_t col;
         uint16_t row;
-        uint16_t cell = 0;
+        lv_coord_t row_y;
+        char * row_buf[LV_TABLE_COL_MAX];
 
         bool rtl = lv_obj_get_base_dir(table) == LV_BIDI_DIR_RTL ? true : false;
 
-        cell_area.y2 = table->coords.y1 + bg_top - 1;
-        for(row = 0; row < ext->row_cnt; row++) {
+        if(ext->row_cnt == 0 || ext->col_cnt == 0) return LV_DESIGN_RES_OK;
+
+        /*Start from the first row in the clip area*/
+        row = get_row_at(table, clip_area->y1 - table->coords.y1 - bg_top, &row_y);
+
+        cell_area.y2 = table->coords.y1 + bg_top + row_y - 1;
+        for(; row < ext->row_cnt; row++) {
             lv_coord_t h_row = ext->row_h[row];
 
             cell_area.y1 = cell_area.y2 + 1;
@@ -861,14 +990,17 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
 
             if(cell_area.y1 > clip_area->y2) return LV_DESIGN_RES_OK;
 
+            char ** cells = get_row_cells(table, row, row_buf);
+            if(cells == NULL) return LV_DESIGN_RES_OK;
+
             if(rtl) cell_area.x1 = table->coords.x2 - bg_right - 1;
             else cell_area.x2 = table->coords.x1 + bg_left - 1;
 
             for(col = 0; col < ext->col_cnt; col++) {
 
                 lv_table_cell_format_t format;
-                if(ext->cell_data[cell]) {
-                    format.format_byte = ext->cell_data[cell][0];
+                if(cells[col]) {
+                    format.format_byte = cells[col][0];
                 }
                 else {
                     format.s.right_merge = 0;
@@ -888,8 +1020,8 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
 
                 uint16_t col_merge = 0;
                 for(col_merge = 0; col_merge + col < ext->col_cnt - 1; col_merge++) {
-                    if(ext->cell_data[cell + col_merge] != NULL) {
-                        format.format_byte = ext->cell_data[cell + col_merge][0];
+                    if(cells[col + col_merge] != NULL) {
+                        format.format_byte = cells[col + col_merge][0];
                         if(format.s.right_merge)
                             if(rtl) cell_area.x1 -= ext->col_w[col + col_merge + 1];
                             else cell_area.x2 += ext->col_w[col + col_merge + 1];
@@ -902,7 +1034,6 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
                 }
 
                 if(cell_area.y2 < clip_area->y1) {
-                    cell += col_merge + 1;
                     col += col_merge;
                     continue;
                 }
@@ -928,7 +1059,7 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
 
                 lv_draw_rect(&cell_area_border, clip_area, &rect_dsc[cell_type]);
 
-                if(ext->cell_data[cell]) {
+                if(cells[col]) {
                     txt_area.x1 = cell_area.x1 + cell_left[cell_type];
                     txt_area.x2 = cell_area.x2 - cell_right[cell_type];
                     txt_area.y1 = cell_area.y1 + cell_top[cell_type];
@@ -942,7 +1073,7 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
                         txt_flags = LV_TXT_FLAG_EXPAND;
                     }
 
-                    _lv_txt_get_size(&txt_size, ext->cell_data[cell] + 1, label_dsc[cell_type].font,
+                    _lv_txt_get_size(&txt_size, cells[col] + 1, label_dsc[cell_type].font,
                                      label_dsc[cell_type].letter_space, label_dsc[cell_type].line_space,
                                      lv_area_get_width(&txt_area), txt_flags);
 
@@ -970,7 +1101,7 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
                     bool label_mask_ok;
                     label_mask_ok = _lv_area_intersect(&label_mask, clip_area, &cell_area);
                     if(label_mask_ok) {
-                        lv_draw_label(&txt_area, &label_mask, &label_dsc[cell_type], ext->cell_data[cell] + 1, NULL);
+                        lv_draw_label(&txt_area, &label_mask, &label_dsc[cell_type], cells[col] + 1, NULL);
                     }
 
                     /*Draw lines after '\n's*/
@@ -978,10 +1109,10 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
                     lv_point_t p2;
                     p1.x = cell_area.x1;
                     p2.x = cell_area.x2;
-                    for(i = 1; ext->cell_data[cell][i] != '\0'; i++) {
-                        if(ext->cell_data[cell][i] == '\n') {
-                            ext->cell_data[cell][i] = '\0';
-                            _lv_txt_get_size(&txt_size, ext->cell_data[cell] + 1, label_dsc[cell_type].font,
+                    for(i = 1; cells[col][i] != '\0'; i++) {
+                        if(cells[col][i] == '\n') {
+                            cells[col][i] = '\0';
+                            _lv_txt_get_size(&txt_size, cells[col] + 1, label_dsc[cell_type].font,
                                              label_dsc[cell_type].letter_space, label_dsc[cell_type].line_space,
                                              lv_area_get_width(&txt_area), txt_flags);
 
@@ -989,12 +1120,11 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
                             p2.y = txt_area.y1 + txt_size.y + label_dsc[cell_type].line_space / 2;
                             lv_draw_line(&p1, &p2, clip_area, &line_dsc[cell_type]);
 
-                            ext->cell_data[cell][i] = '\n';
+                            cells[col][i] = '\n';
                         }
                     }
                 }
 
-                cell += col_merge + 1;
                 col += col_merge;
             }
         }
@@ -1033,14 +1163,9 @@ static lv_res_t lv_table_signal(lv_obj_t * table, lv_signal_t sign, void * param
         /*Free the cell texts*/
         lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
         uint16_t i;
-        for(i = 0; i < ext->col_cnt * ext->row_cnt; i++) {
-            if(ext->cell_data[i]) {
-                lv_mem_free(ext->cell_data[i]);
-                ext->cell_data[i] = NULL;
-            }
-        }
+        free_cell_data(table);
 
-        if(ext->cell_data) lv_mem_free(ext->cell_data);
+        if(ext->cell_buf) lv_mem_free(ext->cell_buf);
         if(ext->row_h) lv_mem_free(ext->row_h);
 
         for(i = 0; i < LV_TABLE_CELL_STYLE_CNT; i++) {
@@ -1048,7 +1173,7 @@ static lv_res_t lv_table_signal(lv_obj_t * table, lv_signal_t sign, void * param
         }
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
-        refr_size(table);
+        refr_size(table, 0);
     }
 
     return res;
@@ -1078,12 +1203,24 @@ static lv_style_list_t * lv_table_get_style(lv_obj_t * table, uint8_t part)
     return NULL;
 }
 
-static void refr_size(lv_obj_t * table)
+/**
+ * Measure the rows and set the size of the table
+ * @param table pointer to a table object
+ * @param start_row measure the rows from this row. The heights of the rows before it are kept.
+ */
+static void refr_size(lv_obj_t * table, uint16_t start_row)
 {
     lv_coord_t h = 0;
     lv_coord_t w = 0;
 
     lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+
+    /*The y offset of the last found row is invalid if a row before it has changed*/
+    if(start_row <= ext->row_ofs_id) {
+        ext->row_ofs_id = 0;
+        ext->row_ofs_y  = 0;
+    }
+
     if(ext->row_cnt == 0 || ext->col_cnt == 0) {
         lv_obj_set_size(table, w, h);
         return;
@@ -1114,8 +1251,10 @@ static void refr_size(lv_obj_t * table)
     }
 
     for(i = 0; i < ext->row_cnt; i++) {
-        ext->row_h[i] = get_row_height(table, i, font, letter_space, line_space,
-                                       cell_left, cell_right, cell_top, cell_bottom);
+        if(i >= start_row) {
+            ext->row_h[i] = get_row_height(table, i, font, letter_space, line_space,
+                                           cell_left, cell_right, cell_top, cell_bottom);
+        }
         h += ext->row_h[i];
     }
 
@@ -1138,20 +1277,22 @@ static lv_coord_t get_row_height(lv_obj_t * table, uint16_t row_id, const lv_fon
     lv_point_t txt_size;
     lv_coord_t txt_w;
 
-    uint16_t row_start = row_id * ext->col_cnt;
-    uint16_t cell;
     uint16_t col;
     lv_coord_t h_max = lv_font_get_line_height(font[0]) + cell_top[0] + cell_bottom[0];
 
-    for(cell = row_start, col = 0; cell < row_start + ext->col_cnt; cell++, col++) {
-        if(ext->cell_data[cell] != NULL) {
+    char * row_buf[LV_TABLE_COL_MAX];
+    char ** cells = get_row_cells(table, row_id, row_buf);
+    if(cells == NULL) return h_max;
+
+    for(col = 0; col < ext->col_cnt; col++) {
+        if(cells[col] != NULL) {
             txt_w              = ext->col_w[col];
             uint16_t col_merge = 0;
             for(col_merge = 0; col_merge + col < ext->col_cnt - 1; col_merge++) {
 
-                if(ext->cell_data[cell + col_merge] != NULL) {
+                if(cells[col + col_merge] != NULL) {
                     lv_table_cell_format_t format;
-                    format.format_byte = ext->cell_data[cell + col_merge][0];
+                    format.format_byte = cells[col + col_merge][0];
                     if(format.s.right_merge)
                         txt_w += ext->col_w[col + col_merge + 1];
                     else
@@ -1163,7 +1304,7 @@ static lv_coord_t get_row_height(lv_obj_t * table, uint16_t row_id, const lv_fon
             }
 
             lv_table_cell_format_t format;
-            format.format_byte = ext->cell_data[cell][0];
+            format.format_byte = cells[col][0];
             uint8_t cell_type  = format.s.type;
 
             /*With text crop assume 1 line*/
@@ -1175,11 +1316,10 @@ static lv_coord_t get_row_height(lv_obj_t * table, uint16_t row_id, const lv_fon
             else {
                 txt_w -= cell_left[cell_type] + cell_right[cell_type];
 
-                _lv_txt_get_size(&txt_size, ext->cell_data[cell] + 1, font[cell_type],
+                _lv_txt_get_size(&txt_size, cells[col] + 1, font[cell_type],
                                  letter_space[cell_type], line_space[cell_type], txt_w, LV_TXT_FLAG_NONE);
 
                 h_max = LV_MATH_MAX(txt_size.y + cell_top[cell_type] + cell_bottom[cell_type], h_max);
-                cell += col_merge;
                 col += col_merge;
             }
         }
@@ -1188,4 +1328,139 @@ static lv_coord_t get_row_height(lv_obj_t * table, uint16_t row_id, const lv_fon
     return h_max;
 }
 
+/**
+ * Find the row at a given y coordinate
+ * @param table pointer to a table object with at least one row
+ * @param y y coordinate relative to the top of the first row
+ * @param row_y store the y coordinate of the found row here (relative to the top of the first row)
+ * @return the row containing `y`, the first row if `y` is above the rows or the last row if `y` is below them
+ */
+static uint16_t get_row_at(lv_obj_t * table, lv_coord_t y, lv_coord_t * row_y)
+{
+    lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+
+    /*Start from the last found row. While scrolling it's only a few rows away.*/
+    uint16_t row = ext->row_ofs_id;
+    lv_coord_t ofs = ext->row_ofs_y;
+    if(row >= ext->row_cnt) {
+        row = 0;
+        ofs = 0;
+    }
+
+    while(row > 0 && ofs > y) {
+        row--;
+        ofs -= ext->row_h[row];
+    }
+
+    while(row < ext->row_cnt - 1 && ofs + ext->row_h[row] <= y) {
+        ofs += ext->row_h[row];
+        row++;
+    }
+
+    ext->row_ofs_id = row;
+    ext->row_ofs_y  = ofs;
+
+    *row_y = ofs;
+    return row;
+}
+
+/**
+ * Get the cells of a row in the format of `cell_data`: a format byte and the text or `NULL` for empty cells.
+ * @param table pointer to a table object
+ * @param row id of the row
+ * @param buf an array with `LV_TABLE_COL_MAX` elements to store the cells if they are given by a callback
+ * @return pointer to `col_cnt` cells or `NULL` on error. Cells read from the callback are valid until the next call.
+ */
+static char ** get_row_cells(lv_obj_t * table, uint16_t row, char ** buf)
+{
+    lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+    if(ext->cell_cb == NULL) return &ext->cell_data[row * ext->col_cnt];
+
+    /*Copy the cells after each other into `cell_buf`.
+     *Save only their offset first because the buffer might be reallocated.*/
+    uint32_t ofs[LV_TABLE_COL_MAX];
+    uint32_t used = 0;
+    uint16_t col;
+    for(col = 0; col < ext->col_cnt; col++) {
+        lv_table_cell_format_t format;
+        const char * txt = get_cb_cell(table, row, col, &format);
+        if(txt == NULL) {
+            ofs[col] = UINT32_MAX;
+            continue;
+        }
+
+#if LV_USE_ARABIC_PERSIAN_CHARS
+        uint32_t size = _lv_txt_ap_calc_bytes_cnt(txt) + 1;
+#else
+        uint32_t size = strlen(txt) + 2; /*+1: trailing '\0; +1: format byte*/
+#endif
+        if(used + size > ext->cell_buf_size) {
+            char * new_buf = lv_mem_realloc(ext->cell_buf, used + size);
+            LV_ASSERT_MEM(new_buf);
+            if(new_buf == NULL) return NULL;
+            ext->cell_buf      = new_buf;
+            ext->cell_buf_size = used + size;
+        }
+
+        ext->cell_buf[used] = format.format_byte;
+#if LV_USE_ARABIC_PERSIAN_CHARS
+        _lv_txt_ap_proc(txt, &ext->cell_buf[used + 1]);
+#else
+        _lv_memcpy(&ext->cell_buf[used + 1], txt, size - 1);
+#endif
+        ofs[col] = used;
+        used += size;
+    }
+
+    for(col = 0; col < ext->col_cnt; col++) {
+        buf[col] = ofs[col] == UINT32_MAX ? NULL : &ext->cell_buf[ofs[col]];
+    }
+
+    return buf;
+}
+
+/**
+ * Read a cell from the cell callback
+ * @param table pointer to a table object with a cell callback
+ * @param row id of the row
+ * @param col id of the column
+ * @param format store the format of the cell here
+ * @return the text of the cell or `NULL` if the cell is empty
+ */
+static const char * get_cb_cell(lv_obj_t * table, uint16_t row, uint16_t col, lv_table_cell_format_t * format)
+{
+    lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+
+    format->s.align       = LV_LABEL_ALIGN_LEFT;
+    format->s.right_merge = 0;
+    format->s.type        = 0;
+    format->s.crop        = 1;
+
+    const char * txt = ext->cell_cb(table, row, col, format);
+    if(format->s.type >= LV_TABLE_CELL_STYLE_CNT) format->s.type = LV_TABLE_CELL_STYLE_CNT - 1;
+
+    return txt;
+}
+
+/**
+ * Free the stored cell texts and the `cell_data` array
+ * @param table pointer to a table object
+ */
+static void free_cell_data(lv_obj_t * table)
+{
+    lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+    if(ext->cell_data == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < (uint32_t)ext->col_cnt * ext->row_cnt; i++) {
+        if(ext->cell_data[i]) {
+            lv_mem_free(ext->cell_data[i]);
+            ext->cell_data[i] = NULL;
+        }
+    }
+
+    lv_mem_free(ext->cell_data);
+    ext->cell_data = NULL;
+}
+
 #endif
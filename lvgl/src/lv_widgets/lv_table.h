@@ -62,6 +62,15 @@ typedef union {
     uint8_t format_byte;
 } lv_table_cell_format_t;
 
+/**
+ * Supply the content of a cell of a virtual table (see `lv_table_set_cell_cb()`).
+ * `format` is initialized to left aligned, type 1 (`s.type = 0`), cropped and not merged and can be modified.
+ * Return the text of the cell or `NULL` if the cell is empty.
+ * The text is copied right away so the same (static) buffer can be returned for every cell.
+ */
+typedef const char * (*lv_table_cell_cb_t)(lv_obj_t * table, uint16_t row, uint16_t col,
+                                           lv_table_cell_format_t * format);
+
 /*Data of table*/
 typedef struct {
     /*New data for this type */
@@ -69,6 +78,11 @@ typedef struct {
     uint16_t row_cnt;
     char ** cell_data;
     lv_coord_t * row_h;
+    lv_table_cell_cb_t cell_cb;     /*Get the cells from this callback instead of `cell_data`*/
+    char * cell_buf;                /*Copy of the cells of the row being measured or drawn with `cell_cb`*/
+    uint32_t cell_buf_size;
+    uint16_t row_ofs_id;            /*A row and its y offset from the top of the first row.*/
+    lv_coord_t row_ofs_y;           /*Searches start here as the drawn rows move slowly while scrolling*/
     lv_style_list_t cell_style[LV_TABLE_CELL_STYLE_CNT];
     lv_coord_t col_w[LV_TABLE_COL_MAX];
 uint16_t cell_types :
@@ -178,6 +192,26 @@ void lv_table_set_cell_crop(lv_obj_t * table, uint16_t row, uint16_t col, bool c
  */
 void lv_table_set_cell_merge_right(lv_obj_t * table, uint16_t row, uint16_t col, bool en);
 
+/**
+ * Get the cells from a callback instead of storing them in the table.
+ * Only the rows in the clip area are read while drawing so tables with many rows (e.g. a log)
+ * can be scrolled without keeping a copy of every cell's text.
+ * The row heights are measured once and cached: rows added by `lv_table_set_row_cnt()` are measured
+ * when they are added, use `lv_table_refresh_rows()` if the content of existing rows changes.
+ * The stored cells are freed and the cell setter functions are ignored while a callback is set.
+ * @param table pointer to a Table object
+ * @param cb callback to get the cells or `NULL` to store the cells in the table again (the cells will be empty)
+ */
+void lv_table_set_cell_cb(lv_obj_t * table, lv_table_cell_cb_t cb);
+
+/**
+ * Measure the rows again from a given row and redraw the table.
+ * Required if the content of the rows given by the cell callback has changed.
+ * @param table pointer to a Table object
+ * @param start_row the first changed row. The rows after it are measured too.
+ */
+void lv_table_refresh_rows(lv_obj_t * table, uint16_t start_row);
+
 /*=====================
  * Getter functions
  *====================*/
@@ -250,6 +284,13 @@ lv_label_align_t lv_table_get_cell_crop(lv_obj_t * table, uint16_t row, uint16_t
  */
 bool lv_table_get_cell_merge_right(lv_obj_t * table, uint16_t row, uint16_t col);
 
+/**
+ * Get the callback which supplies the cells
+ * @param table pointer to a Table object
+ * @return the callback set by `lv_table_set_cell_cb()` or `NULL` if the cells are stored in the table
+ */
+lv_table_cell_cb_t lv_table_get_cell_cb(lv_obj_t * table);
+
 /**
  * Get the last pressed or being pressed cell
  * @param table pointer to a table object
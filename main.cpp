@@ -35,6 +35,8 @@ Timer t_system;
 #define TFT_SCLK p14 // set these to be whatever pins you like!
 #define TFT_MOSI p16 // set these to be whatever pins you like!
 #define TFT_MISO p42 // set these to be whatever pins you like!
+// #define TFT_TE p20   // tearing effect output of the module, if wired
+// #define TFT_PIXEL_FORMAT TFT_PIXEL_RGB444 // 12-bit pixels, 25% less SPI
 
 #if (0) /* Using SPI lib mbed */
 const PinMapSPI PinMap_SPI[1] = {
@@ -46,6 +48,10 @@ SPI tftspi(TFT_MOSI, TFT_MISO, TFT_SCLK); // mosi, miso, sclk
 // Initialize Adafruit ST7789 TFT library
 Adafruit_ST7789 tft = Adafruit_ST7789(&SPIMode, TFT_CS, TFT_DC, TFT_RST);
 
+#ifdef TFT_TE
+InterruptIn tft_te(TFT_TE);
+#endif
+
 #define COLOR_BLACK0 (rgb_hex565(0x0A0A0A))
 
 Adafruit_GFX_Button gfx_button;
@@ -225,11 +231,8 @@ void tft_lvgl_loop(void)
         draw_dsc.color.ch.red = rand();
         draw_dsc.color.ch.green = rand();
         draw_dsc.color.ch.blue = rand();
+        // Only the bounding box of the line is redrawn on the screen
         lv_canvas_draw_line(canvas, points, 2, &draw_dsc);
-        // This forces the canvas to update (otherwise changes aren't
-        // seen unless leaving and returning to the canvas tab):
-        lv_canvas_set_buffer(canvas, canvas_buffer,
-                             CANVAS_WIDTH, CANVAS_HEIGHT, LV_IMG_CF_TRUE_COLOR);
     }
 
     lv_task_handler(); // Call LittleVGL task handler periodically
@@ -451,6 +454,37 @@ void tftPrintTest()
     tft.print(" seconds.");
 }
 
+void testscrolllog()
+{
+    // Log view between a fixed title and status line: each new line costs
+    // one scroll command and the line itself
+    tft.fillScreen(ST77XX_BLACK);
+    tft.setTextSize(1);
+    tft.setTextColor(ST77XX_YELLOW, ST77XX_BLACK);
+    tft.setCursor(0, 4);
+    tft.print("Scroll log");
+    tft.setScrollArea(16, tft.height() - 32); // 26 lines of 8 rows
+    tft.setTextColor(ST77XX_GREEN, ST77XX_BLACK);
+    for (int i = 0; i < 60; i++) {
+        tft.setCursor(0, tft.scroll(8, ST77XX_BLACK));
+        tft.print("line ");
+        tft.print(i);
+        tft.print(" at ");
+        tft.print(millis());
+        tft.print(" ms");
+        ThisThread::sleep_for(50ms);
+    }
+
+    // Static screen: only the log area refreshed, 8 colors
+    tft.setPartialArea(16, tft.height() - 17);
+    tft.enablePartial(true);
+    tft.enableIdle(true);
+    ThisThread::sleep_for(1000ms);
+    tft.enableIdle(false);
+    tft.enablePartial(false);
+    tft.setScrollArea(0, 0);
+}
+
 void mediabuttons()
 {
     // play
@@ -473,6 +507,15 @@ void mediabuttons()
     tft.fillTriangle(42, 20, 42, 60, 90, 40, ST77XX_GREEN);
 }
 
+// The display init runs on its own thread, other bring-up (BLE, sensors)
+// can be queued on it too
+EventQueue tft_queue;
+Thread tft_thread;
+EventFlags tft_flags;
+#define TFT_READY 0x01 // tft_flags: display initialized
+
+void tft_init_step(void);
+
 void tft_setup(void)
 {
     aw9364_init(10);
@@ -480,16 +523,42 @@ void tft_setup(void)
 
     MAIN_TAG_DBG("Hello! ST77xx TFT Test");
 
-    tft.init(240, 240, 0); // Init ST7789 display 240x240 pixel
-    tft.setSPISpeed(32E6);
+    // Init ST7789 display 240x240 pixel. Only starts it: the reset and
+    // sleep out delays (~0.5 s) are stepped by tft_init_step() on the TFT
+    // thread while the rest of the system comes up
+    tft.initStart(240, 240, 0);
+    tft_thread.start(callback(&tft_queue, &EventQueue::dispatch_forever));
+    tft_queue.call(tft_init_step);
+}
 
-    ThisThread::sleep_for(20ms);
+// Step the display init from the TFT thread's event queue until it is done
+void tft_init_step(void)
+{
+    if (!tft.initStep())
+    {
+        tft_queue.call_in(std::chrono::milliseconds(tft.initDelay()),
+                          tft_init_step);
+        return;
+    }
+
+    tft.setSPISpeed(32E6);
     // if the screen is flipped, remove this command
     tft.setRotation(0);
+
+    MAIN_TAG_DBG("TFT init %u ms, ready %u ms after boot",
+                 (unsigned)(tft.initTime() / 1000), (unsigned)millis());
+    tft_flags.set(TFT_READY);
+}
+
+// Wait for the display init started by tft_setup(), before drawing
+void tft_wait(void)
+{
+    tft_flags.wait_all(TFT_READY, osWaitForever, false);
 }
 
 void tft_gfx_graphicstest(void)
 {
+    tft_wait();
     MAIN_TAG_DBG("Initialized");
 
     MAIN_TAG_DBG("fillScreen ST77XX_BLACK");
@@ -518,6 +587,10 @@ void tft_gfx_graphicstest(void)
     tftPrintTest();
     ThisThread::sleep_for(2000ms);
 
+    // hardware scrolled log
+    MAIN_TAG_DBG("testscrolllog");
+    testscrolllog();
+
     // a single pixel
     MAIN_TAG_DBG("drawPixel ST77XX_GREEN");
     tft.drawPixel(tft.width() / 2, tft.height() / 2, ST77XX_GREEN);
@@ -569,6 +642,11 @@ void tft_gfx_graphicstest(void)
 
 void tft_lvgl_widgetsTest()
 {
+    // The display is still initializing (tft_setup()): build the screens
+    // and render the first frame into RAM meanwhile, it goes to the
+    // display in one burst once ready
+    glue.holdDisplay();
+
     // Initialize glue, passing in address of display
     LvGLStatus status = glue.begin(&tft);
     if (status != LVGL_OK)
@@ -578,7 +656,35 @@ void tft_lvgl_widgetsTest()
             ;
     }
 
-    tft_lvgl_setup(); // Call UI-building function above
+    tft_lvgl_setup();  // Call UI-building function above
+    lv_refr_now(NULL); // First frame, into RAM
+
+    tft_wait();
+
+#ifdef TFT_PIXEL_FORMAT
+    // Fewer bits per pixel on the wire, the widgets' flat colors hardly
+    // change
+    tft.setPixelFormat(TFT_PIXEL_FORMAT);
+#endif
+
+#ifdef TFT_TE
+    // Send LvGL frames in step with the panel refresh (no tearing during
+    // the tabview animation)
+    tft.enableTearing(true);
+    tft_te.rise(callback(&tft, &Adafruit_SPITFT::tearingPulse));
+    glue.setFramePacing(true);
+#endif
+
+    glue.releaseDisplay();
+
+    // Startup timeline, ms after glue.holdDisplay()
+    const LvGLTimeline &t = glue.getTimeline();
+    MAIN_TAG_DBG("LvGL running %u, rendered %u, display ready %u, "
+                 "visible %u ms",
+                 (unsigned)(t.running - t.hold) / 1000,
+                 (unsigned)(t.rendered - t.hold) / 1000,
+                 (unsigned)(t.release - t.hold) / 1000,
+                 (unsigned)(t.visible - t.hold) / 1000);
 
     // Enable "A" and "B" buttons as inputs
     pinMode(43, INPUT_PULLUP);
@@ -750,7 +856,7 @@ int main()
     tft_setup();
 
     // tft_gfx_graphicstest();
-    tft_lvgl_widgetsTest();
+    tft_lvgl_widgetsTest(); // Waits for the display itself
 
     while (true)
     {